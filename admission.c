@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "admission.h"
+
+// 출발지 IP 별 연결 속도 제한 표 생성 (공유 메모리, 반환 NULL : 실패)
+AdmissionTable* admission_create(int rate, int burst) {
+    AdmissionTable* t = mmap(NULL, sizeof(AdmissionTable), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (t == MAP_FAILED) {
+        return NULL;
+    }
+    memset(t, 0, sizeof(*t));
+    t->rate = rate;
+    t->burst = burst;
+    return t;
+}
+
+// IP 표 시작 칸 (Fibonacci hashing)
+static uint32_t admission_hash(uint32_t ip) {
+    return (uint32_t)((ip * 2654435769u) >> 20) & (ADMISSION_SLOTS - 1);
+}
+
+// 마지막 충전 뒤 지난 시간만큼 토큰을 채움 (burst 를 넘지 않음)
+static void admission_refill(const AdmissionTable* t, AdmissionEntry* e, uint64_t now_ns) {
+    uint64_t full = (uint64_t)t->burst * ADMISSION_SCALE;
+    if (now_ns <= e->refill_ns) {
+        return;
+    }
+    uint64_t elapsed = now_ns - e->refill_ns;
+    // burst 를 모두 채우는 데 걸리는 시간보다 오래 지났으면 곱셈 없이 가득 채움 (큰 elapsed 의 overflow 방지)
+    if (elapsed >= (uint64_t)t->burst * 1000000000ull / t->rate) {
+        e->tokens = full;
+    } else {
+        uint64_t tokens = e->tokens + elapsed * t->rate / (1000000000ull / ADMISSION_SCALE);
+        e->tokens = tokens < full ? tokens : full;
+    }
+    e->refill_ns = now_ns;
+}
+
+// ip 의 연결 하나를 받아들일지 판단 (반환 1 : 토큰 하나를 쓰고 받아들임, 0 : 토큰 없음)
+int admission_allow(AdmissionTable* t, uint32_t ip, uint64_t now_ns) {
+    uint32_t start = admission_hash(ip);
+    AdmissionEntry* found = NULL;
+    AdmissionEntry* victim = NULL;
+    for (int k = 0; k < ADMISSION_PROBE; k++) {
+        AdmissionEntry* e = &t->entries[(start + k) & (ADMISSION_SLOTS - 1)];
+        if (e->ip == ip) {
+            found = e;
+            break;
+        }
+        if (victim == NULL || (victim->ip != 0 && (e->ip == 0 || e->refill_ns < victim->refill_ns))) {
+            victim = e;
+        }
+    }
+    if (found == NULL) {
+        found = victim;
+        found->ip = ip;
+        found->tokens = t->burst * ADMISSION_SCALE;
+        found->refill_ns = now_ns;
+    } else {
+        admission_refill(t, found, now_ns);
+    }
+    if (found->tokens < ADMISSION_SCALE) {
+        return 0;
+    }
+    found->tokens -= ADMISSION_SCALE;
+    return 1;
+}
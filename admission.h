@@ -0,0 +1,30 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdint.h>
+
+// chat-dev25 : 연결 수락 제어 - 출발지 IP 별 token bucket 연결 속도 제한
+// => IP 마다 초당 rate 개씩 (최대 burst 개) 토큰이 차고, 연결 하나를 받아들일 때 토큰 하나를 씀
+//    토큰이 없는 IP 의 연결은 자식 프로세스 / IPC 링 / 클라이언트 슬롯을 만들기 전에 거절
+//    표는 fork 전에 MAP_SHARED 로 만들어 workers 모드 worker 들이 같은 IP 의 연결을 함께 셈 (workers 모드는 shared_lock 안에서 사용)
+//    칸이 모자라면 같은 probe 구간에서 가장 오래 쓰지 않은 IP 를 내보냄 (내보낸 IP 는 다음 연결에서 토큰이 가득 찬 상태로 다시 시작)
+#define ADMISSION_SLOTS 4096 // IP 표 칸 수 (2 의 거듭제곱)
+#define ADMISSION_PROBE 8    // IP 하나를 찾아보는 연속 칸 수
+#define ADMISSION_SCALE 1000 // 토큰 고정 소수점 단위 (1 토큰 = 1000)
+
+typedef struct {
+    uint32_t ip;        // IPv4 주소 (network byte order, 0 : 빈 칸)
+    uint32_t tokens;    // 남은 토큰 (ADMISSION_SCALE 단위)
+    uint64_t refill_ns; // 마지막으로 토큰을 채운 시각
+} AdmissionEntry;
+
+typedef struct {
+    uint32_t rate;  // 초당 채우는 토큰 수
+    uint32_t burst; // 최대 토큰 수 (한 번에 받아들일 수 있는 연결 수)
+    AdmissionEntry entries[ADMISSION_SLOTS];
+} AdmissionTable;
+
+AdmissionTable* admission_create(int rate, int burst);
+int admission_allow(AdmissionTable* t, uint32_t ip, uint64_t now_ns);
+
+#endif
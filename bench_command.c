@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdint.h>
+
+#include "protocol.h"
+#include "command.h"
+
+// chat-dev23 : 명령어 파싱 + 처리 함수 호출(dispatch) 비용 벤치마크
+// => 기존 방식(텍스트 명령어를 sscanf 로 명령어 이름 / 인자로 나누고 strcmp 분기로 명령어를 찾은 뒤 인자를 스택 버퍼로 복사) 과
+//    새 방식(프레임 명령어 바이트로 command_parse 가 payload 를 view 로 나누고 처리 함수 표에서 바로 호출) 의 명령어 1건당 ns 비교
+//    처리 함수는 인자 길이만 더하는 빈 함수 (응답 생성 / 전송 비용 제외)
+// 사용법 : ./bench_command [명령어별 반복 수]
+#define BENCH_TEXT_LEN 48 // 채팅 메시지 길이
+
+// 측정할 명령어 한 종류
+typedef struct {
+    int cmd;
+    const char* payload;
+} BenchCase;
+
+// 빈 처리 함수가 더한 값 (컴파일러가 측정 대상을 지우지 않도록 마지막에 출력)
+volatile uint64_t sink;
+
+uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// 기존 방식 : "/명령어 인자" 문자열을 나누고 strcmp 로 명령어를 찾은 뒤 인자를 복사
+void legacy_dispatch(const char* line) {
+    char command[20];
+    char str[BUFSIZ + 12 + 50];
+    str[0] = '\0';
+    if (sscanf(line, "%19s %[^\n]", command, str) < 1) {
+        return;
+    }
+    if (strcmp(command, "/NICK") == 0) {
+        char nick[51];
+        snprintf(nick, sizeof(nick), "%.*s", (int)sizeof(nick) - 1, str);
+        sink += strlen(nick);
+    } else if (strcmp(command, "/MSG") == 0) {
+        char sendnickName[51];
+        char msg[BUFSIZ];
+        char* colon = strchr(str, ':');
+        if (colon != NULL) {
+            *colon = '\0';
+            snprintf(sendnickName, sizeof(sendnickName), "%s", str);
+            snprintf(msg, sizeof(msg), "%s", colon + 1);
+            sink += strlen(sendnickName) + strlen(msg);
+        }
+    } else if (strcmp(command, "/ADD") == 0 || strcmp(command, "/LEAVE") == 0 || strcmp(command, "/RM") == 0 ||
+               strcmp(command, "/USERS") == 0 || strcmp(command, "/LIST") == 0 || strcmp(command, "/JOIN") == 0) {
+        sink += strlen(str);
+    } else if (strcmp(command, "/WHISPER") == 0) {
+        char fromnickName[51];
+        char toNickNameAndmsg[BUFSIZ];
+        char toNickName[51];
+        char* colon = strchr(str, ':');
+        if (colon != NULL) {
+            *colon = '\0';
+            snprintf(fromnickName, sizeof(fromnickName), "%s", str);
+            snprintf(toNickNameAndmsg, sizeof(toNickNameAndmsg), "%s", colon + 1);
+            char* space = strchr(toNickNameAndmsg, ' ');
+            if (space != NULL) {
+                *space = '\0';
+                snprintf(toNickName, sizeof(toNickName), "%.*s", (int)sizeof(toNickName) - 1, toNickNameAndmsg);
+                sink += strlen(fromnickName) + strlen(toNickName) + strlen(space + 1);
+            }
+        }
+    } else if (strcmp(command, "/STATS") == 0) {
+        sink += strlen(str);
+    } else if (strcmp(command, "/HISTORY") == 0) {
+        char* end;
+        sink += strtol(str, &end, 10);
+    }
+}
+
+// 새 방식의 빈 처리 함수들
+void stub_word(const Command* c) {
+    sink += c->arg.len;
+}
+
+void stub_chat(const Command* c) {
+    sink += c->nick.len + c->arg.len;
+}
+
+void stub_whisper(const Command* c) {
+    sink += c->nick.len + c->target.len + c->arg.len;
+}
+
+void stub_number(const Command* c) {
+    sink += c->number;
+}
+
+typedef void (*StubHandler)(const Command* c);
+
+const StubHandler stub_handlers[CMD_MAX] = {
+    [CMD_NICK] = stub_word,
+    [CMD_MSG] = stub_chat,
+    [CMD_ADD] = stub_word,
+    [CMD_LEAVE] = stub_word,
+    [CMD_RM] = stub_word,
+    [CMD_USER] = stub_word,
+    [CMD_LIST] = stub_word,
+    [CMD_JOIN] = stub_word,
+    [CMD_WHISPER] = stub_whisper,
+    [CMD_STATS] = stub_word,
+    [CMD_HISTORY] = stub_number,
+    [CMD_CAPS] = stub_word,
+    [CMD_PING] = stub_word,
+};
+
+// 새 방식 : 서버의 process_client_message 와 같은 순서
+void table_dispatch(int cmd, const char* payload, size_t len) {
+    Command c;
+    int ret = command_parse(cmd, payload, len, &c);
+    if (ret != COMMAND_OK || stub_handlers[cmd] == NULL) {
+        return;
+    }
+    stub_handlers[cmd](&c);
+}
+
+// 기존 클라이언트가 보내던 명령어 이름 (/USER 는 /USERS 로 입력)
+const char* legacy_name(int cmd) {
+    return cmd == CMD_USER ? "USERS" : frame_cmd_name(cmd);
+}
+
+// 한 종류의 명령어를 count 번 처리하는 데 걸린 명령어 1건당 ns (기존, 새 방식)
+void bench_case(const BenchCase* bc, long count, double* legacy_ns, double* table_ns) {
+    char line[BUFSIZ];
+    snprintf(line, sizeof(line), "/%s %s", legacy_name(bc->cmd), bc->payload);
+    size_t len = strlen(bc->payload);
+
+    uint64_t t0 = now_ns();
+    for (long k = 0; k < count; k++) {
+        legacy_dispatch(line);
+    }
+    uint64_t t1 = now_ns();
+    for (long k = 0; k < count; k++) {
+        table_dispatch(bc->cmd, bc->payload, len);
+    }
+    uint64_t t2 = now_ns();
+
+    *legacy_ns = (double)(t1 - t0) / count;
+    *table_ns = (double)(t2 - t1) / count;
+}
+
+int main(int argc, char** argv) {
+    long count = argc > 1 ? atol(argv[1]) : 2000000;
+    if (count < 1) {
+        fprintf(stderr, "사용법: %s [명령어별 반복 수(1 이상)]\n", argv[0]);
+        return 1;
+    }
+
+    char chat[100];
+    char whisper[100];
+    char text[BENCH_TEXT_LEN + 1];
+    memset(text, 'x', BENCH_TEXT_LEN);
+    text[BENCH_TEXT_LEN] = '\0';
+    snprintf(chat, sizeof(chat), "alice1:%s", text);
+    snprintf(whisper, sizeof(whisper), "alice1:bobbb1 %s", text);
+
+    BenchCase cases[] = {
+        { CMD_NICK, "alice1" },
+        { CMD_MSG, chat },
+        { CMD_WHISPER, whisper },
+        { CMD_JOIN, "room01" },
+        { CMD_LIST, "all" },
+        { CMD_HISTORY, "20" },
+    };
+    size_t ncases = sizeof(cases) / sizeof(cases[0]);
+
+    printf("명령어 파싱 + dispatch 비용 (명령어별 %ld 회, 메시지 %d 바이트)\n", count, BENCH_TEXT_LEN);
+    printf("%-10s %14s %14s %10s\n", "명령어", "기존(ns)", "표(ns)", "배율");
+    double legacy_sum = 0;
+    double table_sum = 0;
+    for (size_t k = 0; k < ncases; k++) {
+        double legacy_ns, table_ns;
+        bench_case(&cases[k], count, &legacy_ns, &table_ns);
+        legacy_sum += legacy_ns;
+        table_sum += table_ns;
+        printf("%-10s %14.1f %14.1f %9.1fx\n", frame_cmd_name(cases[k].cmd), legacy_ns, table_ns, legacy_ns / table_ns);
+    }
+    printf("%-10s %14.1f %14.1f %9.1fx\n", "평균", legacy_sum / ncases, table_sum / ncases, legacy_sum / table_sum);
+    printf("(sink %llu)\n", (unsigned long long)sink);
+    return 0;
+}
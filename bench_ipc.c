@@ -0,0 +1,471 @@
+#define _GNU_SOURCE // splice, F_SETPIPE_SZ
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <stdint.h>
+#include <sys/wait.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+
+#include "protocol.h"
+#include "ipc_ring.h"
+
+// chat-dev8 : 부모/자식 IPC 벤치마크
+// => 기존 방식(pipe write + kill(SIGUSR1), 부모는 시그널 핸들러에서 read) 과
+//    새 방식(공유 메모리 SPSC 링 + eventfd, 부모는 epoll 메인 루프에서 처리) 의 초당 메시지 수, 지연 시간(p50/p99) 비교
+// chat-dev18 : 클라이언트 소켓으로 전달하는 쪽(fork 모드 자식) 의 전달 1MB 당 CPU 시간 비교
+// => 기존 방식(pipe 에서 사용자 버퍼로 read 후 소켓에 write), pipe → 소켓 splice,
+//    방 로그에서 사용자 버퍼로 복사 후 전송(--zero-copy=off), 방 로그를 복사 없이 가리켜 전송(--zero-copy=on)
+// 사용법 : ./bench_ipc [flood 메시지 수] [지연 측정 메시지 수] [전달 MB]
+//   flood : 자식이 쉬지 않고 메시지를 보낼 때의 처리량
+//   paced : 자식이 PACE_NS 간격으로 메시지를 보낼 때 전송 → 부모 수신까지의 지연 시간
+//   전달 : 생산자 프로세스가 쓴 프레임을 전달 프로세스가 UNIX 소켓으로 보내고 수신 프로세스가 버릴 때 전달 프로세스의 CPU 시간
+#define BENCH_PAYLOAD 48      // 채팅 메시지 한 건 크기 (닉네임:메시지 정도)
+#define PACE_NS       50000   // 지연 측정 시 메시지 간격 (50us)
+#define DELIVERY_PAYLOAD 200       // 전달 측정 프레임 payload 크기
+#define DELIVERY_BATCH   (1 << 16) // 생산자가 한 번에 쓰는 바이트 (프레임 단위로 채움)
+#define DELIVERY_CHUNK   (1 << 18) // 전달 프로세스가 한 번에 보내는 최대 바이트 (서버 자식의 child_out 크기 정도)
+
+// 측정 결과
+typedef struct {
+    double msgs_per_sec;
+    double p50_us;
+    double p99_us;
+} BenchResult;
+
+uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// payload 앞 8바이트에 전송 시각을 기록한 프레임 생성
+size_t make_frame(char* dst, size_t cap) {
+    char payload[BENCH_PAYLOAD];
+    memset(payload, 'x', sizeof(payload));
+    uint64_t t = now_ns();
+    memcpy(payload, &t, sizeof(t));
+    return frame_encode(dst, cap, CMD_MSG, payload, sizeof(payload));
+}
+
+// 다음 전송 시각까지 대기 (busy wait 을 하면 CPU 가 적은 환경에서 수신 측이 실행되지 못해 지연 시간이 왜곡되므로 잠듦)
+void pace_until(uint64_t deadline) {
+    struct timespec ts;
+    ts.tv_sec = deadline / 1000000000ull;
+    ts.tv_nsec = deadline % 1000000000ull;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// ----- 수신 측 공용 : 프레임 디코딩 및 지연 시간 기록 -----
+FrameDecoder decoder;
+uint64_t* latencies;
+long received;
+long expected;
+
+void consume_frames() {
+    Frame frame;
+    uint64_t now = now_ns();
+    while (frame_decoder_next(&decoder, &frame) == 1) {
+        uint64_t sent;
+        memcpy(&sent, frame.payload, sizeof(sent));
+        if (latencies != NULL && received < expected) {
+            latencies[received] = now - sent;
+        }
+        received++;
+    }
+}
+
+void fill_result(BenchResult* res, uint64_t elapsed_ns, long count) {
+    if (latencies == NULL) {
+        res->msgs_per_sec = count / (elapsed_ns / 1e9);
+        return;
+    }
+    qsort(latencies, count, sizeof(uint64_t), cmp_u64);
+    res->p50_us = latencies[count / 2] / 1000.0;
+    res->p99_us = latencies[(count * 99) / 100] / 1000.0;
+}
+
+// ----- 기존 방식 : pipe + SIGUSR1 -----
+int bench_pipe_fd = -1;
+
+// 서버의 기존 sigusr1_handler 와 같이 시그널 핸들러 안에서 파이프를 모두 읽고 처리
+void bench_sigusr1_handler(int signo) {
+    while (1) {
+        ssize_t n = frame_decoder_read(&decoder, bench_pipe_fd);
+        if (n <= 0) {
+            break;
+        }
+        consume_frames();
+    }
+}
+
+void run_pipe(long count, int paced, BenchResult* res) {
+    int fds[2];
+    pipe(fds);
+
+    sigset_t block, old;
+    sigemptyset(&block);
+    sigaddset(&block, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &block, &old);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = bench_sigusr1_handler;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &sa, NULL);
+
+    frame_decoder_init(&decoder);
+    received = 0;
+    expected = count;
+    uint64_t start = now_ns();
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        pid_t parent = getppid();
+        char buf[BENCH_PAYLOAD + FRAME_HEADER_SIZE];
+        uint64_t next = now_ns();
+        for (long i = 0; i < count; i++) {
+            if (paced) {
+                next += PACE_NS;
+                pace_until(next);
+            }
+            size_t len = make_frame(buf, sizeof(buf));
+            write(fds[1], buf, len);
+            kill(parent, SIGUSR1);
+        }
+        _exit(0);
+    }
+
+    close(fds[1]);
+    bench_pipe_fd = fds[0];
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+
+    // 시그널이 합쳐지더라도 핸들러가 파이프를 끝까지 읽으므로 마지막 시그널 이후 모두 수신됨
+    while (received < count) {
+        sigsuspend(&old);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    waitpid(pid, NULL, 0);
+    sigprocmask(SIG_SETMASK, &old, NULL);
+    signal(SIGUSR1, SIG_DFL);
+    close(fds[0]);
+    frame_decoder_free(&decoder);
+    fill_result(res, elapsed, count);
+}
+
+// ----- 새 방식 : 공유 메모리 링 + eventfd -----
+void run_ring(long count, int paced, BenchResult* res) {
+    IpcChannel ch;
+    ipc_channel_open(&ch, IPC_RING_SIZE);
+
+    frame_decoder_init(&decoder);
+    received = 0;
+    expected = count;
+    uint64_t start = now_ns();
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        char buf[BENCH_PAYLOAD + FRAME_HEADER_SIZE];
+        uint64_t next = now_ns();
+        for (long i = 0; i < count; i++) {
+            if (paced) {
+                next += PACE_NS;
+                pace_until(next);
+            }
+            size_t len = make_frame(buf, sizeof(buf));
+            // 서버 자식과 같이 링이 가득 차면 부모를 깨운 뒤 잠시 대기
+            while (ipc_channel_send(&ch, buf, len) < 0) {
+                usleep(50);
+            }
+        }
+        _exit(0);
+    }
+
+    // 서버 부모와 같이 epoll 메인 루프에서 eventfd 이벤트마다 링을 비움
+    int efd = epoll_create1(0);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    epoll_ctl(efd, EPOLL_CTL_ADD, ch.efd, &ev);
+
+    while (received < count) {
+        if (epoll_wait(efd, &ev, 1, -1) < 0) {
+            continue;
+        }
+        ipc_channel_clear_event(&ch);
+        const char* p1;
+        const char* p2;
+        size_t n1, n2;
+        while (shm_ring_peek(ch.ring, &p1, &n1, &p2, &n2) > 0) {
+            if (n1 > FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD) {
+                n1 = FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD;
+            }
+            frame_decoder_feed(&decoder, p1, n1);
+            shm_ring_consume(ch.ring, n1);
+            consume_frames();
+        }
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    waitpid(pid, NULL, 0);
+    close(efd);
+    ipc_channel_close(&ch);
+    frame_decoder_free(&decoder);
+    fill_result(res, elapsed, count);
+}
+
+// ----- chat-dev18 : 클라이언트 소켓 전달 CPU 비용 -----
+#define DELIVERY_PIPE_COPY   0
+#define DELIVERY_PIPE_SPLICE 1
+#define DELIVERY_LOG_COPY    2
+#define DELIVERY_LOG_DIRECT  3
+
+typedef struct {
+    double mb_per_sec;
+    double cpu_us_per_mb;
+} DeliveryResult;
+
+uint64_t cpu_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// 프레임 단위로 채운 생산자 배치 (반환 : 배치 바이트)
+size_t make_batch(char* dst) {
+    char payload[DELIVERY_PAYLOAD];
+    memset(payload, 'x', sizeof(payload));
+    size_t len = 0;
+    while (len + FRAME_HEADER_SIZE + DELIVERY_PAYLOAD <= DELIVERY_BATCH) {
+        len += frame_encode(dst + len, DELIVERY_BATCH - len, CMD_MSG, payload, sizeof(payload));
+    }
+    return len;
+}
+
+int write_all(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        buf += n;
+        len -= n;
+    }
+    return 0;
+}
+
+// 방 로그 전달 - 서버 부모처럼 방 로그에 쓰고 eventfd 로 알림 (전달 프로세스가 읽은 위치를 넘어 덮어쓰지 않도록 기다림)
+void produce_room_log(RoomLog* log, volatile uint64_t* cursor, int efd, const char* batch, size_t batch_len, uint64_t total) {
+    uint64_t one = 1;
+    for (uint64_t sent = 0; sent < total; sent += batch_len) {
+        while (room_log_head(log) + batch_len - __atomic_load_n(cursor, __ATOMIC_ACQUIRE) > log->capacity / 2) {
+            usleep(20);
+        }
+        room_log_append(log, batch, batch_len);
+        write(efd, &one, sizeof(one));
+    }
+}
+
+// 방 로그에서 total 바이트를 소켓으로 전달 (direct : 복사 없이 가리켜 sendmsg, 아니면 사용자 버퍼로 복사 후 send)
+void deliver_room_log(RoomLog* log, volatile uint64_t* cursor, int efd, int sock, int direct, uint64_t total) {
+    static char buf[DELIVERY_CHUNK];
+    uint64_t pos = 0;
+    while (pos < total) {
+        uint64_t head = room_log_head(log);
+        if (head == pos) {
+            uint64_t v;
+            read(efd, &v, sizeof(v));
+            continue;
+        }
+        if (head - pos > DELIVERY_CHUNK) {
+            head = pos + DELIVERY_CHUNK;
+        }
+        struct iovec iov[2];
+        int count = 1;
+        if (direct) {
+            const char* p1;
+            const char* p2;
+            size_t n1, n2;
+            room_log_peek(log, pos, head, &p1, &n1, &p2, &n2);
+            iov[0].iov_base = (void*)p1;
+            iov[0].iov_len = n1;
+            iov[1].iov_base = (void*)p2;
+            iov[1].iov_len = n2;
+            count = n2 > 0 ? 2 : 1;
+        } else {
+            iov[0].iov_base = buf;
+            iov[0].iov_len = room_log_read(log, pos, head, buf, sizeof(buf));
+        }
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = sendmsg(sock, &msg, MSG_NOSIGNAL);
+        if (n <= 0 || (direct && !room_log_valid(log, pos))) {
+            fprintf(stderr, "방 로그 전달 실패\n");
+            exit(1);
+        }
+        pos += n;
+        __atomic_store_n(cursor, pos, __ATOMIC_RELEASE);
+    }
+}
+
+// pipe 전달 - 기존 방식(사용자 버퍼로 read 후 write) 또는 splice (pipe → 소켓, 사용자 공간 복사 없음)
+void deliver_pipe(int pipe_fd, int sock, int use_splice, uint64_t total) {
+    static char buf[DELIVERY_CHUNK];
+    uint64_t pos = 0;
+    while (pos < total) {
+        ssize_t n;
+        if (use_splice) {
+            n = splice(pipe_fd, NULL, sock, NULL, DELIVERY_CHUNK, SPLICE_F_MOVE | SPLICE_F_MORE);
+        } else {
+            n = read(pipe_fd, buf, sizeof(buf));
+            if (n > 0 && write_all(sock, buf, n) < 0) {
+                n = -1;
+            }
+        }
+        if (n <= 0) {
+            fprintf(stderr, "pipe 전달 실패 (%s)\n", n < 0 ? strerror(errno) : "EOF");
+            exit(1);
+        }
+        pos += n;
+    }
+}
+
+void run_delivery(int method, uint64_t total_mb, DeliveryResult* res) {
+    static char batch[DELIVERY_BATCH];
+    size_t batch_len = make_batch(batch);
+    uint64_t total = (total_mb << 20) / batch_len * batch_len;
+
+    int sv[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    int pipe_fds[2] = { -1, -1 };
+    RoomLog* log = NULL;
+    volatile uint64_t* cursor = NULL;
+    int efd = -1;
+    if (method == DELIVERY_PIPE_COPY || method == DELIVERY_PIPE_SPLICE) {
+        pipe(pipe_fds);
+        fcntl(pipe_fds[1], F_SETPIPE_SZ, 1 << 20);
+    } else {
+        log = room_log_create(ROOM_LOG_SIZE);
+        cursor = mmap(NULL, sizeof(uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        *cursor = 0;
+        efd = eventfd(0, 0);
+    }
+
+    // 수신 프로세스 (클라이언트 역할 - 받은 데이터를 버림)
+    pid_t drain = fork();
+    if (drain == 0) {
+        static char sink[1 << 16];
+        close(sv[0]);
+        while (read(sv[1], sink, sizeof(sink)) > 0) {
+        }
+        _exit(0);
+    }
+    close(sv[1]);
+
+    uint64_t start = now_ns();
+    // 생산자 프로세스 (서버 부모 역할)
+    pid_t producer = fork();
+    if (producer == 0) {
+        if (log != NULL) {
+            produce_room_log(log, cursor, efd, batch, batch_len, total);
+        } else {
+            close(pipe_fds[0]);
+            for (uint64_t sent = 0; sent < total; sent += batch_len) {
+                write_all(pipe_fds[1], batch, batch_len);
+            }
+        }
+        _exit(0);
+    }
+
+    // 전달 프로세스 (서버 자식 역할) = 이 프로세스 - 자식 프로세스의 CPU 시간은 포함되지 않음
+    uint64_t cpu_start = cpu_ns();
+    if (log != NULL) {
+        deliver_room_log(log, cursor, efd, sv[0], method == DELIVERY_LOG_DIRECT, total);
+    } else {
+        close(pipe_fds[1]);
+        deliver_pipe(pipe_fds[0], sv[0], method == DELIVERY_PIPE_SPLICE, total);
+    }
+    uint64_t cpu = cpu_ns() - cpu_start;
+    close(sv[0]);
+    waitpid(producer, NULL, 0);
+    waitpid(drain, NULL, 0);
+    uint64_t elapsed = now_ns() - start;
+
+    double mb = total / 1048576.0;
+    res->mb_per_sec = mb / (elapsed / 1e9);
+    res->cpu_us_per_mb = cpu / 1e3 / mb;
+    if (log != NULL) {
+        room_log_destroy(log);
+        munmap((void*)cursor, sizeof(uint64_t));
+        close(efd);
+    } else {
+        close(pipe_fds[0]);
+    }
+}
+
+int main(int argc, char** argv) {
+    long flood_count = argc > 1 ? atol(argv[1]) : 1000000;
+    long paced_count = argc > 2 ? atol(argv[2]) : 20000;
+    long delivery_mb = argc > 3 ? atol(argv[3]) : 512;
+    if (flood_count <= 0 || paced_count <= 0 || delivery_mb <= 0) {
+        fprintf(stderr, "사용법: %s [flood 메시지 수] [지연 측정 메시지 수] [전달 MB]\n", argv[0]);
+        return -1;
+    }
+
+    BenchResult pipe_res, ring_res;
+    memset(&pipe_res, 0, sizeof(pipe_res));
+    memset(&ring_res, 0, sizeof(ring_res));
+
+    // 처리량 측정 (지연 시간 기록 없음)
+    latencies = NULL;
+    run_pipe(flood_count, 0, &pipe_res);
+    run_ring(flood_count, 0, &ring_res);
+
+    // 지연 시간 측정
+    latencies = malloc(sizeof(uint64_t) * paced_count);
+    if (latencies == NULL) {
+        perror("malloc");
+        return -1;
+    }
+    run_pipe(paced_count, 1, &pipe_res);
+    run_ring(paced_count, 1, &ring_res);
+    free(latencies);
+
+    printf("IPC 벤치마크 (payload %d 바이트, flood %ld 건, 지연 측정 %ld 건 / %d us 간격)\n",
+           BENCH_PAYLOAD, flood_count, paced_count, PACE_NS / 1000);
+    printf("%-14s %14s %10s %10s\n", "방식", "msgs/sec", "p50(us)", "p99(us)");
+    printf("%-14s %14.0f %10.2f %10.2f\n", "pipe+signal", pipe_res.msgs_per_sec, pipe_res.p50_us, pipe_res.p99_us);
+    printf("%-14s %14.0f %10.2f %10.2f\n", "shm+eventfd", ring_res.msgs_per_sec, ring_res.p50_us, ring_res.p99_us);
+
+    // chat-dev18 : 클라이언트 소켓 전달 CPU 비용
+    static const char* delivery_names[] = { "pipe read+write", "pipe splice", "roomlog copy", "roomlog direct" };
+    printf("\n클라이언트 소켓 전달 (payload %d 바이트 프레임, %ld MB, AF_UNIX 소켓)\n", DELIVERY_PAYLOAD, delivery_mb);
+    printf("%-16s %10s %14s\n", "방식", "MB/s", "CPU us/MB");
+    for (int method = DELIVERY_PIPE_COPY; method <= DELIVERY_LOG_DIRECT; method++) {
+        DeliveryResult res;
+        run_delivery(method, delivery_mb, &res);
+        printf("%-16s %10.0f %14.1f\n", delivery_names[method], res.mb_per_sec, res.cpu_us_per_mb);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include "protocol.h"
+#include "room_history.h"
+#include "journal.h"
+
+// chat-dev15 : 저널 벤치마크
+// => 1) 서버 시작 시간 : 메시지 N 건이 쌓인 저널을 재생하는 시간(비정상 종료 후) 과 스냅샷에서 복구하는 시간(압축 후)
+//    2) 동기화 정책(off / batch / always) 별 레코드 추가 비용
+// 사용법 : ./bench_journal [저널 디렉토리] [최대 메시지 수]
+#define BENCH_ROOMS     64
+#define BENCH_ALWAYS    2000 // always 정책 측정 메시지 수 (레코드마다 msync 하므로 적게)
+
+char journal_file[256];
+char snapshot_file[300];
+RoomHistoryTable history;
+int room_active[BENCH_ROOMS];
+
+uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// 서버의 채널 메시지 프레임과 비슷한 크기의 프레임
+size_t make_frame(char* dst, size_t cap, int room, long k) {
+    char payload[128];
+    snprintf(payload, sizeof(payload), "bench_room%d 채널(%d) user:%016ld", room, room, k);
+    return frame_encode(dst, cap, CMD_MSG, payload, strlen(payload));
+}
+
+// 복구 콜백 (서버의 채널 레지스트리 대신 활성 여부만 기록)
+int bench_room_add(void* ctx, int room, const char* name) {
+    room_active[room] = 1;
+    return 0;
+}
+
+void bench_room_rm(void* ctx, int room) {
+    room_active[room] = 0;
+    room_history_clear(&history, room);
+}
+
+void bench_room_msg(void* ctx, int room, const char* frame, size_t len) {
+    uint64_t entry;
+    if (room_active[room]) {
+        room_history_append(&history, room, frame, len, &entry);
+    }
+}
+
+void reset_state() {
+    if (history.base != NULL) {
+        munmap(history.base, history.stride * history.rooms);
+    }
+    room_history_create(&history, BENCH_ROOMS, ROOM_HISTORY_MSGS, ROOM_HISTORY_BYTES);
+    memset(room_active, 0, sizeof(room_active));
+}
+
+// 채널 개설 후 메시지 count 건을 채널마다 돌아가며 추가 (반환 : 걸린 시간 ns)
+uint64_t fill_journal(Journal* j, long count) {
+    char frame[256];
+    uint64_t start = now_ns();
+    for (int r = 1; r < BENCH_ROOMS; r++) {
+        char name[32];
+        snprintf(name, sizeof(name), "bench_room%d", r);
+        room_active[r] = 1;
+        journal_append(j, JOURNAL_ROOM_ADD, r, 0, name, strlen(name));
+    }
+    room_active[0] = 1;
+    for (long k = 0; k < count; k++) {
+        int room = k % BENCH_ROOMS;
+        size_t len = make_frame(frame, sizeof(frame), room, k);
+        uint64_t entry;
+        room_history_append(&history, room, frame, len, &entry);
+        journal_append(j, JOURNAL_MSG, room, entry, frame, len);
+    }
+    return now_ns() - start;
+}
+
+// 서버와 같은 방식으로 스냅샷 저장
+void take_snapshot(Journal* j) {
+    static char frames[ROOM_HISTORY_BYTES];
+    JournalSnapshot s;
+    if (journal_snapshot_begin(j, &s) < 0) {
+        return;
+    }
+    for (int r = 0; r < BENCH_ROOMS; r++) {
+        if (room_active[r]) {
+            uint32_t count;
+            uint64_t next_entry;
+            size_t len = room_history_read(&history, r, ROOM_HISTORY_MSGS, frames, sizeof(frames), &count, &next_entry);
+            char name[32];
+            snprintf(name, sizeof(name), "bench_room%d", r);
+            journal_snapshot_room(&s, r, name, next_entry, count, frames, len);
+        }
+    }
+    journal_snapshot_commit(j, &s);
+}
+
+// 서버 시작과 같은 순서로 복구 (반환 : 걸린 시간 ms)
+double recover(JournalRecovery* result) {
+    Journal j;
+    JournalReplay replay = { bench_room_add, bench_room_rm, bench_room_msg };
+    reset_state();
+    uint64_t start = now_ns();
+    if (journal_open(&j, journal_file, JOURNAL_SIZE) < 0) {
+        perror("journal_open");
+        exit(1);
+    }
+    journal_recover(&j, BENCH_ROOMS, &replay, NULL, result);
+    double ms = (now_ns() - start) / 1e6;
+    journal_close(&j);
+    return ms;
+}
+
+void remove_files() {
+    unlink(journal_file);
+    unlink(snapshot_file);
+}
+
+// 메시지 count 건 저널의 복구 시간 측정 - 스냅샷 없이 전부 재생 / 스냅샷 저장 후 복구
+void bench_startup(long count) {
+    Journal j;
+    size_t size = ((count * 128 >> 20) + 1) << 20;
+    remove_files();
+    reset_state();
+    if (journal_open(&j, journal_file, size) < 0) {
+        perror("journal_open");
+        exit(1);
+    }
+    j.sync_mode = JOURNAL_SYNC_OFF;
+    fill_journal(&j, count);
+    uint64_t journal_bytes = j.header->tail;
+    journal_close(&j); // 스냅샷 없이 종료 (비정상 종료 후 재시작과 같음)
+
+    JournalRecovery replayed, snapshotted;
+    double replay_ms = recover(&replayed);
+
+    if (journal_open(&j, journal_file, size) < 0) {
+        perror("journal_open");
+        exit(1);
+    }
+    take_snapshot(&j); // recover 가 채운 최근 메시지 기록으로 스냅샷 저장 (압축)
+    journal_close(&j);
+    double snapshot_ms = recover(&snapshotted);
+
+    printf("%10ld %12.1f %14.2f %14.1f %14.2f\n", count, journal_bytes / 1048576.0, replay_ms,
+           snapshotted.snapshot_bytes / 1024.0, snapshot_ms);
+    remove_files();
+}
+
+// 동기화 정책별 레코드 추가 비용
+void bench_append(const char* name, int sync_mode, long count) {
+    Journal j;
+    remove_files();
+    reset_state();
+    if (journal_open(&j, journal_file, JOURNAL_SIZE) < 0 || journal_start(&j, JOURNAL_SIZE, sync_mode, JOURNAL_SYNC_MS) < 0) {
+        perror("journal_open");
+        exit(1);
+    }
+    uint64_t ns = fill_journal(&j, count);
+    journal_close(&j);
+    printf("%-8s %10ld %14.0f %12.2f\n", name, count, count / (ns / 1e9), ns / 1e3 / count);
+    remove_files();
+}
+
+int main(int argc, char** argv) {
+    const char* dir = argc > 1 ? argv[1] : ".";
+    long max_count = argc > 2 ? atol(argv[2]) : 1000000;
+    if (max_count < 1000) {
+        fprintf(stderr, "사용법: %s [저널 디렉토리] [최대 메시지 수(1000 이상)]\n", argv[0]);
+        return -1;
+    }
+    snprintf(journal_file, sizeof(journal_file), "%s/bench_journal.journal", dir);
+    snprintf(snapshot_file, sizeof(snapshot_file), "%s.snapshot", journal_file);
+
+    printf("서버 시작 시간 (채널 %d 개, 채널당 최근 메시지 %d 건)\n", BENCH_ROOMS, ROOM_HISTORY_MSGS);
+    printf("%10s %12s %14s %14s %14s\n", "메시지", "저널(MB)", "재생(ms)", "스냅샷(KB)", "스냅샷 복구(ms)");
+    for (long count = 1000; count <= max_count; count *= 10) {
+        bench_startup(count);
+    }
+
+    long append_count = max_count < 100000 ? max_count : 100000;
+    printf("\n레코드 추가 비용 (동기화 정책별)\n");
+    printf("%-8s %10s %14s %12s\n", "정책", "메시지", "msgs/sec", "평균(us)");
+    bench_append("off", JOURNAL_SYNC_OFF, append_count);
+    bench_append("batch", JOURNAL_SYNC_BATCH, append_count);
+    bench_append("always", JOURNAL_SYNC_ALWAYS, BENCH_ALWAYS);
+    return 0;
+}
@@ -0,0 +1,449 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <stdint.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/tcp.h>
+#include <dirent.h>
+
+#include "protocol.h"
+
+// chat-dev10 : 채팅 서버 부하 생성기 (서버 모드 / worker 수 별 처리량 비교용)
+// => 여러 클라이언트 연결을 하나의 epoll 루프로 만들고, 각 클라이언트가 자기 채팅 채널에 메시지를 보내며
+//    서버가 모든 멤버에게 전달한 메시지 수로 처리량(전달 msgs/sec) 을 측정
+// chat-dev13 : 메시지/귓속말 전송 속도 지정, 연결 시간, 전달 지연 시간(p50/p99/p999), JSON 출력 추가
+// => 메시지 본문에 보낸 시각(CLOCK_MONOTONIC ns) 을 넣고, 받은 모든 클라이언트가 (받은 시각 - 보낸 시각) 을 지연 시간으로 기록
+//    (보내는 쪽과 받는 쪽이 같은 프로세스이므로 시계가 같음)
+// 사용법 : ./bench_load [-h 서버IP] [-p 포트] [-c 클라이언트 수] [-r 채팅 채널 수] [-n 클라이언트당 메시지 수] [-w 윈도우]
+//                       [-m 클라이언트당 초당 메시지 수] [-W 클라이언트당 귓속말 수] [-s 클라이언트당 초당 귓속말 수] [-j] [-P 서버 pid]
+//   -r : 클라이언트를 r 개 채팅 채널(lobby 포함) 에 고르게 나눔 (채팅 채널이 여러 shard 에 나뉘도록)
+//   -w : 클라이언트당 자신의 메시지가 되돌아오기 전까지 보낼 수 있는 최대 메시지 수 (서버 버퍼가 무한히 쌓이지 않도록)
+//   -m, -s : 0 이면 윈도우가 허용하는 만큼 최대 속도로 전송 (기본)
+//   -W : 클라이언트 i 는 클라이언트 i + 1 에게 귓속말 (서버는 받는 쪽과 보낸 쪽 모두에게 전달)
+//   -j : 결과를 JSON 한 줄로 출력 (빌드 간 성능 비교용)
+// chat-dev19 : -P 서버 pid - 측정 구간 동안 서버(pid 와 그 자식 프로세스 : fork 모드 자식, workers 모드 worker) 가 쓴 CPU 시간 출력
+//   (같은 부하에서 입출력 엔진 등 서버 설정별 전달 1000 건당 CPU 시간 비교용)
+#define LOAD_MAX_CLIENTS 1024
+#define LOAD_PAYLOAD     32   // 채팅 메시지 본문 크기 (보낸 시각을 0 으로 채워 이 길이로 보냄)
+#define LOAD_STALL_NS    5000000000ull // 이 시간 동안 아무것도 받지 못하면 중단
+
+typedef struct {
+    int fd;
+    int room;
+    char nick[32];
+    FrameDecoder in;
+    long sent;         // 보낸 메시지 수
+    long echoed;       // 서버가 되돌려준 자신의 메시지 수
+    long wsp_sent;     // 보낸 귓속말 수
+    long wsp_echoed;   // 서버가 되돌려준 자신의 귓속말 수
+    long received;     // 받은 채팅 메시지 + 귓속말 수 (자신의 것 포함)
+    uint64_t connect_ns; // connect() 에 걸린 시간
+} LoadClient;
+
+LoadClient load_clients[LOAD_MAX_CLIENTS];
+int load_count;
+
+// 전송 설정
+long msg_count = 20000;
+long msg_rate = 0;
+long wsp_count = 0;
+long wsp_rate = 0;
+int window = 32;
+
+// 전달 지연 시간 표본 (ns)
+uint64_t* latencies;
+size_t latency_count;
+size_t latency_cap;
+
+uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void record_latency(uint64_t ns) {
+    if (latency_count == latency_cap) {
+        size_t cap = latency_cap ? latency_cap * 2 : 65536;
+        uint64_t* grown = realloc(latencies, cap * sizeof(uint64_t));
+        if (grown == NULL) {
+            return; // 표본만 버리고 측정은 계속
+        }
+        latencies = grown;
+        latency_cap = cap;
+    }
+    latencies[latency_count++] = ns;
+}
+
+int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// 정렬된 표본의 q 분위수 (us)
+double percentile_us(double q) {
+    if (latency_count == 0) {
+        return 0;
+    }
+    size_t k = (size_t)(q * latency_count);
+    if (k >= latency_count) {
+        k = latency_count - 1;
+    }
+    return latencies[k] / 1e3;
+}
+
+// 응답 프레임 한 개를 기다림 (준비 단계 전용 - blocking)
+int wait_frame(LoadClient* c, int cmd) {
+    while (1) {
+        Frame frame;
+        int ret;
+        while ((ret = frame_decoder_next(&c->in, &frame)) == 1) {
+            if (frame.cmd == cmd) {
+                return 0;
+            }
+        }
+        if (ret < 0 || frame_decoder_read(&c->in, c->fd) <= 0) {
+            return -1;
+        }
+    }
+}
+
+// 연결, 닉네임 설정, 채팅 채널 입장
+int setup_client(LoadClient* c, int i, const char* host, int port, int rooms) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, host, &addr.sin_addr);
+
+    uint64_t start = now_ns();
+    c->fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (c->fd < 0 || connect(c->fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        return -1;
+    }
+    c->connect_ns = now_ns() - start;
+    int on = 1;
+    setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    frame_decoder_init(&c->in);
+
+    snprintf(c->nick, sizeof(c->nick), "load%d", i);
+    frame_write(c->fd, CMD_NICK, c->nick, strlen(c->nick));
+    if (wait_frame(c, CMD_NICK) < 0) {
+        return -1;
+    }
+
+    // 0 번 채널은 로비, 나머지 채널은 각 채널의 첫 클라이언트가 만들고 이후 클라이언트는 참가
+    c->room = i % rooms;
+    if (c->room > 0) {
+        char name[32];
+        snprintf(name, sizeof(name), "load_room%d", c->room);
+        frame_write(c->fd, i < rooms ? CMD_ADD : CMD_JOIN, name, strlen(name));
+        if (wait_frame(c, i < rooms ? CMD_ADD : CMD_JOIN) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 시작 후 elapsed ns 동안 속도 rate 로 보낼 수 있는 누적 개수 (rate 0 : 제한 없음)
+long due_count(long total, long rate, uint64_t elapsed) {
+    if (rate <= 0) {
+        return total;
+    }
+    long due = (long)((double)elapsed * rate / 1e9) + 1;
+    return due < total ? due : total;
+}
+
+// 전송 속도와 윈도우가 허용하는 만큼 메시지/귓속말 전송 (한 번의 write 로 묶어서 보냄)
+void send_window(LoadClient* c, int idx, uint64_t elapsed) {
+    char buf[(FRAME_HEADER_SIZE + 96 + LOAD_PAYLOAD) * 64];
+    size_t len = 0;
+    long msg_due = due_count(msg_count, msg_rate, elapsed);
+    long wsp_due = due_count(wsp_count, wsp_rate, elapsed);
+    const char* target = load_clients[(idx + 1) % load_count].nick;
+    while (len + FRAME_HEADER_SIZE + 96 + LOAD_PAYLOAD <= sizeof(buf)) {
+        char payload[96 + LOAD_PAYLOAD];
+        unsigned long long stamp = now_ns();
+        int n;
+        if (c->sent < msg_due && c->sent - c->echoed < window) {
+            // "닉네임:보낸시각"
+            n = snprintf(payload, sizeof(payload), "%s:%0*llu", c->nick, LOAD_PAYLOAD, stamp);
+            len += frame_encode(buf + len, sizeof(buf) - len, CMD_MSG, payload, n);
+            c->sent++;
+        } else if (c->wsp_sent < wsp_due && c->wsp_sent - c->wsp_echoed < window) {
+            // "보낸닉네임:받는닉네임 보낸시각"
+            n = snprintf(payload, sizeof(payload), "%s:%s %0*llu", c->nick, target, LOAD_PAYLOAD, stamp);
+            len += frame_encode(buf + len, sizeof(buf) - len, CMD_WHISPER, payload, n);
+            c->wsp_sent++;
+        } else {
+            break;
+        }
+    }
+    // non-blocking 소켓이므로 프레임이 중간에 끊기지 않도록 모두 쓸 때까지 반복
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = write(c->fd, buf + off, len - off);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        off += n;
+    }
+}
+
+// chat-dev27 : 서버의 연결 확인 PING 에 PONG 응답 (메시지를 보내지 않는 클라이언트가 오래 실행해도 유휴 연결로 끊기지 않도록)
+void send_pong(LoadClient* c, Frame* frame) {
+    char buf[FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD];
+    size_t len = frame_encode(buf, sizeof(buf), CMD_PONG, frame->payload, frame->len);
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = write(c->fd, buf + off, len - off);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        off += n;
+    }
+}
+
+// 받은 채팅 메시지/귓속말 처리 ("채널명 채널(n) 닉네임:보낸시각", "[귓속말] - 채널명 채널(n) 닉네임:보낸시각")
+// 반환 : 1 부하 생성기가 보낸 메시지, 0 그 외
+int handle_delivery(LoadClient* c, Frame* frame, uint64_t now) {
+    char* colon = strrchr(frame->payload, ':');
+    if (colon == NULL) {
+        return 0;
+    }
+    char* end;
+    unsigned long long stamp = strtoull(colon + 1, &end, 10);
+    if (end == colon + 1 || *end != '\0' || stamp == 0 || stamp > now) {
+        return 0; // 귓속말 실패 안내 등
+    }
+    record_latency(now - stamp);
+    c->received++;
+
+    // 자신이 보낸 것이 되돌아왔는지 확인 (윈도우 갱신)
+    size_t nick_len = strlen(c->nick);
+    if (colon - frame->payload > (long)nick_len &&
+        memcmp(colon - nick_len, c->nick, nick_len) == 0 && colon[-(long)nick_len - 1] == ' ') {
+        if (frame->cmd == CMD_MSG) {
+            c->echoed++;
+        } else {
+            c->wsp_echoed++;
+        }
+    }
+    return 1;
+}
+
+void print_usage(const char* prog) {
+    fprintf(stderr, "사용법: %s [-h 서버IP] [-p 포트] [-c 클라이언트 수] [-r 채팅 채널 수] [-n 클라이언트당 메시지 수] [-w 윈도우]"
+                    " [-m 초당 메시지 수] [-W 클라이언트당 귓속말 수] [-s 초당 귓속말 수] [-j] [-P 서버 pid]\n", prog);
+}
+
+// chat-dev19 : /proc/<pid>/stat 의 사용자 + 커널 CPU 시간 (ns), ppid : 부모 pid (읽지 못하면 -1 반환)
+int64_t proc_cpu_ns(int pid, int* ppid) {
+    char path[64];
+    char buf[1024];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+    buf[n] = '\0';
+    // 프로세스 이름(괄호 안) 에 공백이 있을 수 있으므로 마지막 ')' 뒤부터 읽음 : state ppid ... utime(14 번째) stime(15 번째)
+    char* p = strrchr(buf, ')');
+    unsigned long long utime, stime;
+    if (p == NULL || sscanf(p + 2, "%*c %d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", ppid, &utime, &stime) != 3) {
+        return -1;
+    }
+    return (int64_t)((utime + stime) * (1000000000ull / sysconf(_SC_CLK_TCK)));
+}
+
+// chat-dev19 : 서버 pid 와 그 자식 프로세스들의 CPU 시간 합 (ns)
+int64_t server_cpu_ns(int pid) {
+    int ppid;
+    int64_t total = proc_cpu_ns(pid, &ppid);
+    if (total < 0) {
+        return -1;
+    }
+    DIR* dir = opendir("/proc");
+    struct dirent* ent;
+    while (dir != NULL && (ent = readdir(dir)) != NULL) {
+        int child = atoi(ent->d_name);
+        int64_t cpu;
+        if (child > 0 && child != pid && (cpu = proc_cpu_ns(child, &ppid)) >= 0 && ppid == pid) {
+            total += cpu;
+        }
+    }
+    if (dir != NULL) {
+        closedir(dir);
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    const char* host = "127.0.0.1";
+    int port = 5101;
+    int rooms = 4;
+    int json = 0;
+    int server_pid = 0;
+    load_count = 20;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "h:p:c:r:n:w:m:W:s:jP:")) != -1) {
+        switch (opt) {
+            case 'h': host = optarg; break;
+            case 'p': port = atoi(optarg); break;
+            case 'c': load_count = atoi(optarg); break;
+            case 'r': rooms = atoi(optarg); break;
+            case 'n': msg_count = atol(optarg); break;
+            case 'w': window = atoi(optarg); break;
+            case 'm': msg_rate = atol(optarg); break;
+            case 'W': wsp_count = atol(optarg); break;
+            case 's': wsp_rate = atol(optarg); break;
+            case 'j': json = 1; break;
+            case 'P': server_pid = atoi(optarg); break;
+            default:
+                print_usage(argv[0]);
+                return -1;
+        }
+    }
+    if (load_count < 1 || load_count > LOAD_MAX_CLIENTS || rooms < 1 || rooms > load_count || msg_count < 0 || window < 1 ||
+        msg_rate < 0 || wsp_count < 0 || wsp_rate < 0 || (wsp_count > 0 && load_count < 2) || msg_count + wsp_count == 0) {
+        fprintf(stderr, "잘못된 인자입니다. (귓속말은 클라이언트가 2 명 이상일 때만 가능)\n");
+        return -1;
+    }
+
+    uint64_t setup_start = now_ns();
+    for (int i = 0; i < load_count; i++) {
+        if (setup_client(&load_clients[i], i, host, port, rooms) < 0) {
+            fprintf(stderr, "클라이언트 %d 준비 실패 (서버 수용량 또는 연결 확인)\n", i);
+            return -1;
+        }
+    }
+    double setup_sec = (now_ns() - setup_start) / 1e9;
+
+    // 채널별 멤버 수로 전체 기대 전달 수 계산 (메시지 한 건은 채널 멤버 모두에게, 귓속말 한 건은 받는 쪽과 보낸 쪽에게 전달됨)
+    long members[LOAD_MAX_CLIENTS];
+    memset(members, 0, sizeof(members));
+    for (int i = 0; i < load_count; i++) {
+        members[load_clients[i].room]++;
+    }
+    long expected = 0;
+    for (int i = 0; i < load_count; i++) {
+        expected += msg_count * members[load_clients[i].room] + wsp_count * 2;
+    }
+
+    int efd = epoll_create1(0);
+    for (int i = 0; i < load_count; i++) {
+        fcntl(load_clients[i].fd, F_SETFL, fcntl(load_clients[i].fd, F_GETFL, 0) | O_NONBLOCK);
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        epoll_ctl(efd, EPOLL_CTL_ADD, load_clients[i].fd, &ev);
+    }
+
+    int64_t cpu_start = server_pid > 0 ? server_cpu_ns(server_pid) : -1;
+    uint64_t start = now_ns();
+    for (int i = 0; i < load_count; i++) {
+        send_window(&load_clients[i], i, 0);
+    }
+
+    // 전송 속도를 지정하면 1ms 마다 깨어나 보낼 차례가 된 메시지를 보냄
+    int paced = msg_rate > 0 || wsp_rate > 0;
+    long delivered = 0;
+    uint64_t last_progress = start;
+    struct epoll_event events[64];
+    while (delivered < expected) {
+        int n = epoll_wait(efd, events, 64, paced ? 1 : 1000);
+        uint64_t now = now_ns();
+        if (n > 0) {
+            last_progress = now;
+        } else if (now - last_progress >= LOAD_STALL_NS) {
+            fprintf(stderr, "5초 동안 응답이 없어 중단합니다. (전달 %ld / %ld)\n", delivered, expected);
+            break;
+        }
+        for (int k = 0; k < n; k++) {
+            LoadClient* c = &load_clients[events[k].data.u32];
+            while (frame_decoder_read(&c->in, c->fd) > 0) {
+                Frame frame;
+                uint64_t received_at = now_ns(); // 같은 반복에서 먼저 보낸 메시지가 이미 도착했을 수 있으므로 read 마다 측정
+                while (frame_decoder_next(&c->in, &frame) == 1) {
+                    if (frame.cmd == CMD_MSG || frame.cmd == CMD_WHISPER) {
+                        delivered += handle_delivery(c, &frame, received_at);
+                    } else if (frame.cmd == CMD_PING) {
+                        send_pong(c, &frame); // chat-dev27
+                    }
+                }
+            }
+            if (!paced) {
+                send_window(c, events[k].data.u32, now - start);
+            }
+        }
+        if (paced) {
+            for (int i = 0; i < load_count; i++) {
+                send_window(&load_clients[i], i, now - start);
+            }
+        }
+    }
+    double elapsed = (now_ns() - start) / 1e9;
+    // chat-dev19 : 측정 구간 동안 서버 CPU 시간 (ms) 과 전달 1000 건당 CPU 시간 (us)
+    int64_t cpu_end = cpu_start >= 0 ? server_cpu_ns(server_pid) : -1;
+    double server_cpu_ms = cpu_end >= 0 ? (cpu_end - cpu_start) / 1e6 : -1;
+    double cpu_us_per_kmsg = (server_cpu_ms >= 0 && delivered > 0) ? server_cpu_ms * 1e6 / delivered : -1;
+
+    long sent = 0;
+    long wsp_sent = 0;
+    uint64_t connect_total = 0;
+    uint64_t connect_max = 0;
+    for (int i = 0; i < load_count; i++) {
+        sent += load_clients[i].sent;
+        wsp_sent += load_clients[i].wsp_sent;
+        connect_total += load_clients[i].connect_ns;
+        if (load_clients[i].connect_ns > connect_max) {
+            connect_max = load_clients[i].connect_ns;
+        }
+        close(load_clients[i].fd);
+        frame_decoder_free(&load_clients[i].in);
+    }
+    qsort(latencies, latency_count, sizeof(uint64_t), compare_u64);
+    double connect_avg_ms = connect_total / 1e6 / load_count;
+    double p50 = percentile_us(0.5), p99 = percentile_us(0.99), p999 = percentile_us(0.999);
+    double max_us = latency_count ? latencies[latency_count - 1] / 1e3 : 0;
+
+    if (json) {
+        printf("{\"clients\":%d,\"rooms\":%d,\"msgs_per_client\":%ld,\"msg_rate\":%ld,\"whispers_per_client\":%ld,\"whisper_rate\":%ld,"
+               "\"window\":%d,\"connect_ms\":{\"avg\":%.3f,\"max\":%.3f},\"setup_sec\":%.3f,\"elapsed_sec\":%.3f,"
+               "\"sent\":%ld,\"whispers_sent\":%ld,\"delivered\":%ld,\"expected\":%ld,\"sent_per_sec\":%.0f,\"delivered_per_sec\":%.0f,"
+               "\"latency_us\":{\"p50\":%.1f,\"p99\":%.1f,\"p999\":%.1f,\"max\":%.1f},\"server_cpu_ms\":%.1f,\"server_cpu_us_per_kmsg\":%.1f,\"ok\":%s}\n",
+               load_count, rooms, msg_count, msg_rate, wsp_count, wsp_rate, window, connect_avg_ms, connect_max / 1e6, setup_sec, elapsed,
+               sent, wsp_sent, delivered, expected, (sent + wsp_sent) / elapsed, delivered / elapsed,
+               p50, p99, p999, max_us, server_cpu_ms, cpu_us_per_kmsg, delivered == expected ? "true" : "false");
+    } else {
+        printf("clients %d, rooms %d, 전송 %ld 건 (귓속말 %ld 건), 전달 %ld / %ld 건, %.2f 초\n",
+               load_count, rooms, sent + wsp_sent, wsp_sent, delivered, expected, elapsed);
+        printf("연결 시간 평균 %.3f ms, 최대 %.3f ms (닉네임/채널 준비 포함 %.2f 초)\n", connect_avg_ms, connect_max / 1e6, setup_sec);
+        printf("전달 지연 시간 p50 %.1f us, p99 %.1f us, p999 %.1f us, max %.1f us\n", p50, p99, p999, max_us);
+        printf("전송 msgs/sec : %.0f, 전달 msgs/sec : %.0f\n", (sent + wsp_sent) / elapsed, delivered / elapsed);
+        if (server_cpu_ms >= 0) {
+            printf("서버 CPU 시간 %.1f ms, 전달 1000 건당 %.1f us\n", server_cpu_ms, cpu_us_per_kmsg);
+        }
+    }
+    free(latencies);
+    return delivered == expected ? 0 : 1;
+}
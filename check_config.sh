@@ -0,0 +1,52 @@
+#!/bin/bash
+# chat-dev26 : 설정 파일 검사
+# => 설정 파일로 준 문자열 설정(저널 경로, 관리용 소켓 경로, listen 주소) 과 숫자 설정(포트) 으로 서버를 실행하고
+#    저널 파일, 관리용 소켓이 설정한 경로에 생기는지, 설정한 주소 / 포트에서 연결을 받는지 확인
+#    (설정 파일의 줄을 읽는 버퍼는 config_load 가 끝나면 사라지므로 문자열 값을 복사하지 않으면 이 검사가 실패함)
+# 사용법 : ./check_config.sh [서버 실행 파일] (기본 : ./server, make check_config)
+SERVER=$(realpath "${1:-./server}")
+DIR=$(mktemp -d)
+PORT=$((20000 + $$ % 20000))
+
+cat > "$DIR/chat.conf" <<EOF
+# check_config.sh
+mode = epoll
+listen = 127.0.0.1
+port = $PORT
+journal = $DIR/chat.journal
+journal_size = 1
+admin_socket = $DIR/admin.sock
+max_clients = 7
+EOF
+
+# 서버는 데몬으로 전환되고 작업 디렉토리의 logs/ 에 로그를 쓰므로 임시 디렉토리에서 실행
+(cd "$DIR" && "$SERVER" --config="$DIR/chat.conf" > /dev/null 2>&1)
+
+fail=0
+for i in $(seq 1 20); do
+    [ -e "$DIR/chat.journal" ] && [ -S "$DIR/admin.sock" ] && break
+    sleep 0.1
+done
+if [ -e "$DIR/chat.journal" ]; then
+    echo "통과 : journal = $DIR/chat.journal"
+else
+    echo "실패 : journal - 설정한 경로에 저널 파일이 없습니다."
+    fail=1
+fi
+if [ -S "$DIR/admin.sock" ]; then
+    echo "통과 : admin_socket = $DIR/admin.sock"
+else
+    echo "실패 : admin_socket - 설정한 경로에 관리용 소켓이 없습니다."
+    fail=1
+fi
+if (exec 3<>"/dev/tcp/127.0.0.1/$PORT") 2> /dev/null; then
+    echo "통과 : listen = 127.0.0.1, port = $PORT"
+else
+    echo "실패 : listen / port - 127.0.0.1:$PORT 에 연결할 수 없습니다."
+    fail=1
+fi
+
+pkill -f -- "--config=$DIR/chat.conf"
+sleep 0.3
+rm -rf "$DIR"
+exit $fail
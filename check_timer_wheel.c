@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "timer_wheel.h"
+
+// chat-dev27 : 타이머 휠 검사
+// => 단계 경계(64, 4096, 262144 tick ...) 를 포함한 여러 만료 시각의 타이머가 정확히 그 tick 에 한 번만 실행되는지,
+//    취소한 타이머는 실행되지 않는지, 만료 함수 안에서 다시 추가한 타이머, 최대 범위를 넘는 타이머, ms → tick 올림을 확인
+// 사용법 : ./check_timer_wheel [무작위 타이머 수] [seed] (make check_timer_wheel)
+#define CHECK_TIMERS_MAX 4096
+
+typedef struct {
+    TimerEntry timer;
+    uint64_t due;   // 실행되어야 하는 시각 (ms)
+    uint64_t fired; // 실행된 시각 (0 : 실행되지 않음)
+    int count;      // 실행된 횟수
+    int rearm;      // 실행될 때 다시 추가할 횟수
+    uint64_t rearm_ms;
+} CheckTimer;
+
+CheckTimer check_timers[CHECK_TIMERS_MAX];
+TimerWheel wheel;
+uint64_t now_ms;
+int failures;
+
+void check_fired(void* arg) {
+    CheckTimer* c = arg;
+    c->fired = now_ms;
+    c->count++;
+    if (c->rearm > 0) {
+        c->rearm--;
+        c->due = now_ms + c->rearm_ms;
+        timer_wheel_add(&wheel, &c->timer, c->due);
+    }
+}
+
+void check_fail(const char* what, int k, const CheckTimer* c) {
+    fprintf(stderr, "검사 실패 : %s (타이머 %d, 만료 %llu, 실행 %llu, 실행 횟수 %d)\n", what, k,
+            (unsigned long long)c->due, (unsigned long long)c->fired, c->count);
+    failures++;
+}
+
+// tick_ms 씩 시각을 진행하며 end 까지 만료된 타이머 실행
+void check_run(uint64_t end, uint32_t tick_ms) {
+    while (now_ms < end) {
+        now_ms += tick_ms;
+        timer_wheel_advance(&wheel, now_ms);
+    }
+}
+
+// tick 단위 만료 : 정해진 tick 에 정확히 한 번 실행되는지 (start_tick : 휠을 미리 진행해 둔 tick 수 - 경계 위치를 바꿔 봄)
+void check_exact(uint64_t start_tick, const uint64_t* delays, int n) {
+    timer_wheel_init(&wheel, 0, 1);
+    now_ms = 0;
+    check_run(start_tick, 1);
+    uint64_t last = 0;
+    for (int k = 0; k < n; k++) {
+        CheckTimer* c = &check_timers[k];
+        timer_entry_init(&c->timer, check_fired, c);
+        c->due = now_ms + delays[k];
+        c->fired = 0;
+        c->count = 0;
+        c->rearm = 0;
+        timer_wheel_add(&wheel, &c->timer, c->due);
+        if (c->due > last) {
+            last = c->due;
+        }
+    }
+    // 4 개마다 하나씩 취소 (실행되지 않아야 함)
+    for (int k = 0; k < n; k += 4) {
+        timer_wheel_cancel(&wheel, &check_timers[k].timer);
+        check_timers[k].due = 0;
+    }
+    check_run(last + 1, 1);
+    for (int k = 0; k < n; k++) {
+        CheckTimer* c = &check_timers[k];
+        if (c->due == 0) {
+            if (c->count != 0) {
+                check_fail("취소한 타이머가 실행됨", k, c);
+            }
+        } else if (c->count != 1 || c->fired != c->due) {
+            check_fail(c->fired > c->due ? "늦게 실행됨" : "만료 시각에 실행되지 않음", k, c);
+        }
+    }
+    if (wheel.count != 0) {
+        fprintf(stderr, "검사 실패 : 실행 후 대기 중인 타이머 수 %zu\n", wheel.count);
+        failures++;
+    }
+}
+
+int main(int argc, char** argv) {
+    int random_count = argc > 1 ? atoi(argv[1]) : 2000;
+    unsigned seed = argc > 2 ? (unsigned)atoi(argv[2]) : 1;
+    if (random_count < 1 || random_count > CHECK_TIMERS_MAX) {
+        fprintf(stderr, "사용법: %s [무작위 타이머 수(1 ~ %d)] [seed]\n", argv[0], CHECK_TIMERS_MAX);
+        return 1;
+    }
+    srand(seed);
+
+    // 1. 단계 경계와 그 앞뒤 tick
+    uint64_t delays[CHECK_TIMERS_MAX];
+    int n = 0;
+    for (uint64_t d = 1; d <= 130; d++) {
+        delays[n++] = d;
+    }
+    uint64_t edges[] = { 192, 256, 4095, 4096, 4097, 8192, 262143, 262144, 262145, 524288 };
+    for (size_t e = 0; e < sizeof(edges) / sizeof(edges[0]); e++) {
+        delays[n++] = edges[e];
+    }
+    uint64_t starts[] = { 0, 1, 63, 64, 100, 4095, 200000 };
+    for (size_t s = 0; s < sizeof(starts) / sizeof(starts[0]); s++) {
+        check_exact(starts[s], delays, n);
+    }
+
+    // 2. 무작위 만료 시각 (여러 단계에 섞여 있는 타이머)
+    for (int k = 0; k < random_count; k++) {
+        delays[k] = 1 + (uint64_t)rand() % (rand() % 2 ? 5000 : 300000);
+    }
+    check_exact((uint64_t)rand() % 10000, delays, random_count);
+
+    // 3. 만료 함수 안에서 다시 추가 (같은 tick 에 다시 실행되지 않고 정해진 간격마다 실행)
+    timer_wheel_init(&wheel, 0, 1);
+    now_ms = 0;
+    CheckTimer* c = &check_timers[0];
+    timer_entry_init(&c->timer, check_fired, c);
+    c->count = 0;
+    c->rearm = 9;
+    c->rearm_ms = 64;
+    c->due = 64;
+    timer_wheel_add(&wheel, &c->timer, c->due);
+    check_run(64 * 10, 1);
+    if (c->count != 10 || c->fired != 64 * 10) {
+        check_fail("만료 함수에서 다시 추가한 타이머", 0, c);
+    }
+
+    // 4. 최대 범위를 넘는 타이머 (최대 범위에서 다시 예약되어 정확한 시각에 실행)
+    timer_wheel_init(&wheel, 0, 1);
+    now_ms = 0;
+    timer_entry_init(&c->timer, check_fired, c);
+    c->count = 0;
+    c->rearm = 0;
+    c->due = TIMER_WHEEL_SPAN + 100;
+    timer_wheel_add(&wheel, &c->timer, c->due);
+    check_run(c->due + 1, 1);
+    if (c->count != 1 || c->fired != c->due) {
+        check_fail("최대 범위를 넘는 타이머", 0, c);
+    }
+
+    // 5. ms → tick 올림 (tick 250 ms : 만료 시각 이후 첫 tick 에 실행)
+    uint64_t base = 1000000;
+    timer_wheel_init(&wheel, base, 250);
+    for (int k = 0; k < 1000; k++) {
+        CheckTimer* t = &check_timers[k];
+        timer_entry_init(&t->timer, check_fired, t);
+        t->due = base + 1 + (uint64_t)rand() % 100000;
+        t->fired = 0;
+        t->count = 0;
+        t->rearm = 0;
+        timer_wheel_add(&wheel, &t->timer, t->due);
+    }
+    now_ms = base;
+    check_run(base + 100000 + 250, 250);
+    for (int k = 0; k < 1000; k++) {
+        CheckTimer* t = &check_timers[k];
+        if (t->count != 1 || t->fired < t->due || t->fired >= t->due + 250) {
+            check_fail("ms 만료 시각 올림", k, t);
+        }
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "타이머 휠 검사 실패 %d 건\n", failures);
+        return 1;
+    }
+    printf("타이머 휠 검사 통과 (단계 경계 %d 개 x 시작 위치 %zu 개, 무작위 %d 개, seed %u)\n", n, sizeof(starts) / sizeof(starts[0]), random_count, seed);
+    return 0;
+}
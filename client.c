@@ -5,8 +5,12 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <signal.h>
-#include <sys/wait.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <poll.h>
+
+#include "protocol.h" // chat-dev7 : 길이 기반 메시지 프레이밍
+#include "session.h"  // chat-dev21 : 세션 기록 / 재생
 
 // chat-dev5 : ANSI 이스케이프 코드를 사용하여 글자에 색상을 넣기 위한 색 DEFINE
 #define COLOR_RED     "\x1b[31m"
@@ -17,25 +21,55 @@
 #define COLOR_CYAN    "\x1b[36m"
 #define COLOR_RESET   "\x1b[0m"
 
-#define PORT    5101
+#define PORT    5101 // 기본 서버 포트 (chat-dev26 : --port=N 으로 변경)
 
 int sockfd; // 소켓 파일 디스크립터
 char nickname[51]; // 닉네임
 
-// 0625 구조 수정 : 전역 변수로 자식 -> 부모 데이터 파이프 선언
-int pipe_child_to_parent[2];
+// chat-dev7 : 서버 소켓 수신 프레임 디코더 (닉네임 설정 단계와 채팅 단계에서 이어서 사용)
+FrameDecoder server_in;
+
+// chat-dev20 : 단일 프로세스 poll 이벤트 루프 구조
+// => 기존 : 입력 전용 자식 프로세스가 한 줄마다 파이프에 프레임을 쓰고 SIGUSR1 로 부모에게 알리면, 부모가 파이프를 읽어 서버로 전송
+//    변경 : 한 프로세스가 poll 로 표준 입력과 서버 소켓을 함께 기다리며, 표준 입력은 read 로 읽어 줄 단위로 조립하고
+//           만든 프레임은 송신 버퍼에 모아 소켓이 쓰기 가능할 때 한 번에 전송 (메시지당 프로세스 전환, 파이프 경유, 시그널이 없음)
+//    표준 입력이 파이프/파일이어도(모니터링 봇 등) 같은 루프로 동작하며, 입력이 끝나면(EOF) q 와 같이 종료 요청 후 종료
+#define INPUT_BUF_SIZE  (BUFSIZ * 4)  // 표준 입력 줄 조립 버퍼 크기
+#define LINE_MAX_SIZE   BUFSIZ        // 입력 한 줄 최대 길이 (넘으면 나누어 처리 - 기존 fgets 와 같음)
+#define OUT_BUF_SIZE    (BUFSIZ * 16) // 서버 송신 버퍼 크기
+#define LINE_FRAME_MAX  (FRAME_HEADER_SIZE + LINE_MAX_SIZE + 12 + 50) // 입력 한 줄로 만드는 프레임 최대 크기 (닉네임 포함)
+
+char input_buf[INPUT_BUF_SIZE]; // 표준 입력에서 읽었지만 아직 처리하지 않은 바이트
+size_t input_pos;               // 처리한 위치
+size_t input_len;               // 채워진 바이트 수
+int input_eof;                  // 표준 입력 EOF 여부
+
+char out_buf[OUT_BUF_SIZE];     // 서버로 보낼 프레임 (아직 전송하지 않은 바이트)
+size_t out_len;
+
+// chat-dev21 : 세션 기록 / 재생 (--record=파일 : 보내고 받은 프레임을 시각과 함께 기록, --replay=파일 : 기록한 세션을 서버에 다시 보내고 기록과 비교)
+#define REPLAY_QUIET_MS 200  // 종료 요청(QUIT) 과 연결 종료 전에 기다리는 무응답 시간 (앞서 보낸 요청의 응답을 모두 받도록)
+
+SessionRecorder recorder;       // 기록 파일 (fp == NULL : 기록 안 함)
+const char* replay_path;        // 재생할 기록 파일 (NULL : 재생 안 함)
+double replay_speed = 1.0;      // 재생 속도 배수 (0 : 최대 속도 - 기다리지 않고 보냄)
+SessionLog replay_observed;     // 재생 중 보내고 받은 프레임 (기록과 비교)
+uint64_t replay_start;          // 재생 시작 시각 (ns)
+uint64_t replay_last_io;        // 재생 중 마지막으로 프레임을 보내거나 받은 시각 (ns)
+
+// chat-dev22 : 프레임 압축 협상 (--compress=on|off)
+// => 닉네임이 정해지면 CMD_CAPS "lz4" 로 압축 지원을 알리고, 서버가 "lz4 min=N" 으로 응답하면 이후 N 바이트 이상인 프레임을 압축해서 보냄
+//    받은 압축 프레임은 협상과 관계없이 디코더가 풀어서 돌려줌 (기록 파일에도 푼 프레임을 기록)
+int compress_enabled = 1;       // 0 : 서버에 압축 지원을 알리지 않음
+size_t compress_min = 0;        // 서버가 알려준 압축 최소 프레임 크기 (0 : 협상 전 또는 서버가 압축을 끔)
 
 // chat-dev5 : ANSI 이스케이프 코드를 사용하여 필요 시 화면 clear 기능을 사용하도록 함
 // 위의 선언없이 extern inline void clrscr(void)로 선언
 inline void clrscr(void);		// C99, C11에 대응하기 위해서 사용
 void clrscr(void)				
 {
-    write(1, "\033[1;1H\033[2J", 10);		// ANSI escape 코드로 화면 지우기
-}
-
-// 6 단계 : 클라이언트에서 fork된 자식(수신용) 프로세스가 종료되었을 때 부모가 기다리지 않아서 발생하는 좀비 프로세스 방지 
-void handle_sigchld(int signo) {
-    while (waitpid(-1, NULL, WNOHANG) > 0);
+    // chat-dev20 : stdout 버퍼에 쌓인 이전 출력보다 먼저 화면이 지워지지 않도록 같은 stdout 버퍼로 출력
+    fputs("\033[1;1H\033[2J", stdout);		// ANSI escape 코드로 화면 지우기
 }
 
 // sigaction 커스텀 함수
@@ -61,97 +95,18 @@ void register_sigaction(int signo, void (*handler)(int)) {
     }
 }
 
-// 프로젝트 제한사항에 따른 client 구조 수정
-// => sigusr1_handler 를 client 부모 프로세스에 등록하고 client 자식 프로세스에서 SIGNAL 알림을 보내면
-// client 부모 프로세스에서 server 의 자식 프로세스(해당 클라이언트 담당 프로세스) 에 write 
-// => client 부모 프로세스에서 server 의 자식 프로세스(해당 클라이언트 담당 프로세스) 에서 read 
-void sigusr1_handler(int signo){
-    // client 자식 프로세스에서 메시지 입력 감지 시그널 알림으로 client 부모 프로세스에서 이벤트 동작 시작
-    char buf[BUFSIZ + 10 + 50];
-    int n;
-
-    memset(buf, 0, BUFSIZ);
-
-    // command 동작
-    char ch[10];
-    char str[BUFSIZ];
-
-    // non-blocking read
-    n = read(pipe_child_to_parent[0], buf, BUFSIZ);
-    if(n <= 0){
-        return; // 읽은 데이터 없음
-    }
-    buf[n] = '\0';
-
-    // chat-dev2 : 명령어 동작일 경우 있는 buf 파이프에 있는 그대로 문자열을 보냄
-    if(buf[0] == '/'){
-        // 파이프에 있는 문자열을 서버로 보냄
-        write(sockfd, buf, strlen(buf));
-    } else {
-        // client 자식으로부터 받은 버퍼 메시지 문자열 분리
-        // chat-dev2 : 버그 수정 - 메시지에 공백이 있을 때 공백을 메시지에 포함하지 못하는 경우 수정
-        // => sscanf 는 공백 포함 문자열을 담기 어렵기 때문에 strchr 과 strcpy 구조로 변경
-        // chat-dev5 : /WHISPER 사용자이름 - 서버에 접속한 사용자에게만 귓속말 전달
-        char* space = strchr(buf, ' ');
-        if (space != NULL) {
-            sscanf(buf, "/%s", ch);
-            strcpy(str, space + 1);  // 공백 이후 문자열 복사
-        }
-        
-        if(ch == NULL){
-            return;
-        }
-        // chat-dev5 : /WHISPER 사용자이름 - 서버에 접속한 사용자에게만 귓속말 전달
-        if(strcmp(ch, "MSG") == 0 || strcmp(ch, "WHISPER") == 0){
-            char nickName[51];
-            char msg[BUFSIZ];
-
-            // 채팅 메시지를 닉네임과 채팅 msg 로 분리
-            char* colon = strchr(str, ':');
-            if (colon != NULL) {
-                *colon = '\0'; // ':'를 문자열 종료로 바꿈
-                strcpy(nickName, str);
-                strcpy(msg, colon + 1);
-
-                // 0625 구조 수정 : 시그널을 받고 파이프에 있는 데이터를 서버에 전달
-                // 서버로 보낼 메시지 프로토콜 생성
-                char sendMsg[BUFSIZ + 12 + 50];
-                // 서버에 보낼 문자열 결합
-                if(strcmp(ch, "MSG") == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "/MSG %s:%s", nickname, msg);
-                } else if(strcmp(ch, "WHISPER") == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "/WHISPER %s:%s", nickname, msg);
-                }
-                
-                // 파이프에 있는 문자열을 서버로 보냄
-                write(sockfd, sendMsg, strlen(sendMsg));
-            }
-        } 
-    }
-}
-
 // 서버로부터 메시지를 받아 파싱하고 출력하는 함수
 // 부모 read : 메시지 파싱 후 동작
-void process_server_message(char *buf) {
+// chat-dev7 : 서버로부터 받은 프레임 한 개(cmd : 명령어 바이트, payload : 문자열)를 처리
+// chat-dev20 : 프레임마다 fflush 하지 않고, 한 번에 읽은 프레임들을 모두 출력한 뒤 이벤트 루프에서 한 번 fflush
+void process_server_message(int cmd, char *payload) {
     // command 동작
-    char ch[10];
     char str[BUFSIZ];
 
-    // 서버로부터 받은 버퍼 문자열 분리
-    // chat-dev2 : 버그 수정 - 메시지에 공백이 있을 때 공백을 메시지에 포함하지 못하는 경우 수정
-    // => sscanf 는 공백 포함 문자열을 담기 어렵기 때문에 strchr 과 strcpy 구조로 변경
-    // chat-dev5 : /WHISPER 사용자이름 - 서버에 접속한 사용자에게만 귓속말 전달
-    char* space = strchr(buf, ' ');
-    if (space != NULL) {
-        sscanf(buf, "/%s", ch);
-        strcpy(str, space + 1);  // 공백 이후 문자열 복사
-    }
+    // 프레임 payload 를 그대로 사용 (sscanf 로 명령어를 다시 파싱하지 않음)
+    snprintf(str, sizeof(str), "%s", payload);
 
-    if (ch == NULL) {
-        return;
-    }
-
-    if (strcmp(ch, "MSG") == 0 || strcmp(ch, "WHISPER") == 0) {
+    if (cmd == CMD_MSG || cmd == CMD_WHISPER) {
         char nickName[51];
         char msg[BUFSIZ];
 
@@ -164,13 +119,12 @@ void process_server_message(char *buf) {
             strcpy(msg, colon + 1);
 
             // chat-dev5 : 귓속말일 경우 YELLOW 색 출력하고 색 RESET
-            if(strcmp(ch, "WHISPER") == 0){
+            if(cmd == CMD_WHISPER){
                 printf(COLOR_YELLOW "\n[%s] >>> %s\n" COLOR_RESET, nickName, msg);
             } else {
                 // 메시지 출력
                 printf("\n[%s] >>> %s\n", nickName, msg);
             }
-            fflush(stdout);  // 입력줄 깨지지 않도록
         } 
     } // chat-dev2 : 서버로 부터 채팅방 개설 요청에 대한 결과를 받고, 이를 클라이언트에 처리 결과를 알림
     // chat-dev3 : /LEAVE 명령어. 서버로부터 처리와 처리 결과를 반환 받고 메시지를 출력
@@ -181,24 +135,348 @@ void process_server_message(char *buf) {
     // - ADD, RM : COLOR_CYAN 후 RESET
     // - LEAVE, JOIN : COLOR_GREEN 후 RESET
     // - USER, LIST : COLOR_MAGENTA 후 RESET 
-    else if(strcmp(ch, "ADD") == 0 || strcmp(ch, "RM") == 0){
+    else if(cmd == CMD_ADD || cmd == CMD_RM){
         clrscr(); // chat-dev5 : ADD 나 RM 시 ANSI 이스케이프 clear 코드 적용
         // 메시지 출력
         printf(COLOR_CYAN "\n%s\n" COLOR_RESET, str);
-        fflush(stdout);  // 입력줄 깨지지 않도록
-    } else if(strcmp(ch, "LEAVE") == 0 || strcmp(ch, "JOIN") == 0){
+    } else if(cmd == CMD_LEAVE || cmd == CMD_JOIN){
         clrscr(); // ADD 나 RM 시 ANSI 이스케이프 clear 코드 적용
         printf(COLOR_GREEN "\n%s\n" COLOR_RESET, str);
-        fflush(stdout);  // 입력줄 깨지지 않도록
-    } else if(strcmp(ch, "USER") == 0 || strcmp(ch, "LIST") == 0){
+    } else if(cmd == CMD_USER || cmd == CMD_LIST || cmd == CMD_STATS || cmd == CMD_HISTORY){ // chat-dev13 : /STATS 서버 지표, chat-dev14 : /HISTORY 안내 문구 (이어서 오는 메시지는 CMD_MSG 로 출력)
         printf(COLOR_MAGENTA "\n%s\n" COLOR_RESET, str);
-        fflush(stdout);  // 입력줄 깨지지 않도록
+    } else if(cmd == CMD_ERROR){
+        // chat-dev7 : 서버 오류 통지 (서버 수용량 초과, 잘못된 프레임 등)
+        printf(COLOR_RED "\n%s\n" COLOR_RESET, str);
+    } else if(cmd == CMD_CAPS){
+        // chat-dev22 : 압축 협상 결과 (화면에 출력하지 않음) - 서버가 압축을 켰으면 최소 크기 이상인 프레임부터 압축
+        char* min = strstr(str, "min=");
+        if (strncmp(str, "lz4", 3) == 0 && min != NULL && atoi(min + 4) > 0) {
+            compress_min = atoi(min + 4);
+        }
+    }
+}
+
+// chat-dev20 : 송신 버퍼에 프레임 한 개 추가 (호출 전에 LINE_FRAME_MAX 만큼 여유가 있는지 확인)
+// chat-dev22 : 압축을 협상했으면 최소 크기 이상인 프레임을 압축해서 추가 (기록 파일에는 압축 전 프레임을 기록)
+void queue_frame(int cmd, const char* payload, size_t len) {
+    size_t n = frame_encode(out_buf + out_len, sizeof(out_buf) - out_len, cmd, payload, len);
+    session_record(&recorder, SESSION_SENT, out_buf + out_len, n); // chat-dev21 : 보낸 프레임 기록
+    if (compress_min > 0 && n >= compress_min) {
+        char lz_frame[LINE_FRAME_MAX];
+        size_t lz_len = frame_compress(lz_frame, sizeof(lz_frame), out_buf + out_len, n);
+        if (lz_len > 0) {
+            memcpy(out_buf + out_len, lz_frame, lz_len);
+            n = lz_len;
+        }
+    }
+    out_len += n;
+}
+
+// chat-dev20 : 송신 버퍼를 소켓이 받는 만큼 전송 (non-blocking, 남은 바이트는 다음 POLLOUT 에 전송)
+// 반환 : 0 성공(모두 또는 일부 전송), -1 연결 오류
+int flush_out() {
+    size_t off = 0;
+    while (off < out_len) {
+        ssize_t n = send(sockfd, out_buf + off, out_len - off, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        off += n;
+    }
+    memmove(out_buf, out_buf + off, out_len - off);
+    out_len -= off;
+    return 0;
+}
+
+// chat-dev20 : 표준 입력에서 읽을 수 있는 만큼 줄 조립 버퍼에 읽음 (처리한 앞부분은 버리고 당김)
+// 반환 : read 결과 (0 : EOF)
+ssize_t input_fill() {
+    if (input_pos > 0) {
+        memmove(input_buf, input_buf + input_pos, input_len - input_pos);
+        input_len -= input_pos;
+        input_pos = 0;
+    }
+    ssize_t n = read(STDIN_FILENO, input_buf + input_len, sizeof(input_buf) - input_len);
+    if (n > 0) {
+        input_len += n;
+    } else if (n == 0) {
+        input_eof = 1;
+    }
+    return n;
+}
+
+// chat-dev20 : 조립된 줄 한 개를 꺼냄 (개행 제거, LINE_MAX_SIZE 를 넘는 줄과 EOF 직전의 개행 없는 줄도 한 줄로 처리)
+// 반환 : 1 꺼냄, 0 완성된 줄 없음
+int input_next_line(char* line) {
+    size_t avail = input_len - input_pos;
+    char* start = input_buf + input_pos;
+    char* nl = memchr(start, '\n', avail < LINE_MAX_SIZE ? avail : LINE_MAX_SIZE - 1);
+    size_t len;
+    size_t used;
+    if (nl != NULL) {
+        len = nl - start;
+        used = len + 1;
+    } else if (avail >= LINE_MAX_SIZE - 1 || (input_eof && avail > 0)) {
+        len = avail < LINE_MAX_SIZE - 1 ? avail : LINE_MAX_SIZE - 1;
+        used = len;
+    } else {
+        return 0;
+    }
+    memcpy(line, start, len);
+    line[len] = '\0';
+    input_pos += used;
+    return 1;
+}
+
+// chat-dev20 : 닉네임 설정 단계용 - 한 줄이 완성될 때까지 표준 입력을 읽음 (fgets 대신 같은 줄 조립 버퍼 사용)
+// 반환 : 0 성공, -1 EOF 또는 오류
+int input_read_line(char* line) {
+    fflush(stdout); // 입력 안내 문구 출력
+    while (!input_next_line(line)) {
+        if (input_eof) {
+            return -1;
+        }
+        if (input_fill() < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// chat-dev20 : 입력 한 줄 처리 - 기존 입력 전용 자식 프로세스의 동작 (서버로 보낼 프레임은 송신 버퍼에 추가)
+// 반환 : 1 종료 요청(q), 0 계속
+int handle_input_line(char* buf) {
+    // 종료 조건: buf가 "q" 와 정확히 일치할 때 종료
+    if (strcmp(buf, "q") == 0) {
+        // chat-dev7 : 서버에 CMD_QUIT 프레임으로 종료 요청
+        queue_frame(CMD_QUIT, "", 0);
+        printf(COLOR_RED "[클라이언트] 종료 요청 전송 완료. 종료합니다.\n" COLOR_RESET);
+        return 1;
+    }
+
+    // chat-dev2 : 위치 이동 - 서버로 보낼 메시지 프로토콜 생성
+    char sendMsg[LINE_MAX_SIZE + 12 + 50];
+
+    // chat-dev2 : 입력한 문자열이 / 로 시작하는 명령어일 경우
+    if(buf[0] == '/'){
+        char ch[10], str[LINE_MAX_SIZE + 12 + 50];
+        // stdin 으로 받은 문자열 분리
+        // stdin 으로 받는 문자열 예시 1 : /NICK NICKNAME
+        // 예시 2 : /MSG NICKNAME:MSG
+        // chat-dev2 : 버그 수정 - 메시지에 공백이 있을 때 공백을 메시지에 포함하지 못하는 경우 수정
+        // => sscanf 는 공백 포함 문자열을 담기 어렵기 때문에 strchr 과 strcpy 구조로 변경
+        
+        char* space = strchr(buf, ' ');
+        if (space != NULL) { // 공백이 포함되어 있을 때만 동작
+            sscanf(buf, "/%s", ch);
+            strcpy(str, space + 1);  // 공백 이후 문자열 복사
+
+            // chat-dev2 : /add 채팅방 추가
+            // 클라이언트에서 먼저 체크 사항: 채팅방 이름 입력 여부, 채팅방 이름 글자 수 제한 충족 여부
+            if(strcmp(ch, "ADD") == 0){
+                if(strlen(str) < 6){
+                    printf(COLOR_RED "채팅방 이름은 6바이트 미만(한글 2글자미만) 으로 생성할 수 없습니다.\n" COLOR_RESET);
+                    return 0;
+                }
+                if(strlen(str) >= 100){
+                    printf(COLOR_RED "채팅방 이름은 100바이트 이상 으로 생성할 수 없습니다.\n" COLOR_RESET);
+                    return 0;
+                }
+                // 보낼 문자열 str 그대로 (명령어 동작이므로 결합 필요없이 그대로 보냄)
+                snprintf(sendMsg, sizeof(sendMsg), "%s", str);
+                // chat-dev7 : 명령어 바이트 + 인자 문자열을 프레임으로 작성
+                // chat-dev20 : 파이프 대신 송신 버퍼에 프레임 추가 (이벤트 루프에서 모아서 전송)
+                queue_frame(CMD_ADD, sendMsg, strlen(sendMsg));
+                
+            } // chat-dev3 : /LEAVE 명령어 - 로비가 아닌 접속한 채팅방을 나오는 명령어
+            // chat-dev4 : /RM 명령어 - 로비가 아닌 채팅방을 지우고, 채팅방에 있던 유저들을 모두 로비로 옮김
+            // chat-dev4 : /USERS all - 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보(해당 유저가 접속한 채팅방, 유저 이름) 를 출력
+            //             /USERS 채팅방이름 - 해당 채팅 채널방에 속해 있는 모든 클라이언트 유저 정보를 출력
+            // chat-dev4 : /LIST all - 모든 채널방 리스트를 출력함
+            // chat-dev4 : /JOIN 채널방이름 - 서버에 활성화된 채팅 채널방으로 이동함
+            
+            else if (strcmp(ch, "LEAVE") == 0 || strcmp(ch, "RM") == 0 || strcmp(ch, "USER") == 0 || strcmp(ch, "LIST") == 0 || strcmp(ch, "JOIN") == 0 || strcmp(ch, "STATS") == 0 || strcmp(ch, "HISTORY") == 0){
+                // 보낼 문자열 작성
+                snprintf(sendMsg, sizeof(sendMsg), "%s", str);
+                queue_frame(frame_cmd_from_name(ch, strlen(ch)), sendMsg, strlen(sendMsg));
+            } else if(strcmp(ch, "WHISPER") == 0){
+                // chat-dev5 : /WHISPER 사용자이름 메시지 - 서버에 접속한 사용자에게만 귓속말 전달
+                snprintf(sendMsg, sizeof(sendMsg), "%s:%s", nickname, str);
+                queue_frame(CMD_WHISPER, sendMsg, strlen(sendMsg));
+            } else if(strcmp(ch, "HELP") == 0 && strcmp(str, "CMD") == 0){
+                // chat-dev5 : /HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.
+                char howToCmdUse[BUFSIZ * 5] = "(명령어 모음\n\t/ADD 이름 : 채널방을 '이름' 으로 개설 요청\n\t/LEAVE lobby : 현재 있는 채널방을 나오고 로비 채널로 이동하도록 요청\n\t/RM 채널방이름 : 로비가 아닌 채널방을 없애기\n\t/USER all : 접속한 전체 유저 정보 출력\n\t/USER 채널방이름 : 해당 채널방에 있는 유저 정보 출력\n\t/LIST all : 모든 채팅 채널 리스트를 출력함\n\t/JOIN 채팅채널이름 : 입력한 채팅방에 들어가기\n\t/WHISPER 상대방이름 메시지 : 접속한 상대방에게만 메시지를 보내기\n\t/STATS all : 서버 지표(연결, 명령어별 메시지 수, 처리 시간 등) 출력\n\t/HISTORY 개수 : 현재 채팅 채널의 최근 메시지를 개수만큼 다시 출력\n\t/HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.)\n";
+                printf(COLOR_YELLOW "\n%s\n" COLOR_RESET, howToCmdUse);
+            }
+        } else { // / 명령어 동작을 잘못했을 경우 예외 처리(클라이언트)
+                printf(COLOR_RED "명령어 동작 방법을 확인하고 다시 입력해주세요.\n" COLOR_RESET);
+                return 0;
+        }
+    } else { // chat-dev2 : 입력한 문자열이 명령어가 아닐 경우 
+        // 현재 채팅방에 전송할 메시지로 동작함 (/MSG 로 동작)
+        // 보낼 문자열 결합
+        snprintf(sendMsg, sizeof(sendMsg), "%s:%s", nickname, buf);
+        queue_frame(CMD_MSG, sendMsg, strlen(sendMsg));
     } 
+    return 0;
+}
+
+// chat-dev20 : 디코더에 쌓인 완성된 서버 프레임을 모두 처리
+// 반환 : 0 성공, -1 잘못된 프레임
+int process_server_frames() {
+    Frame frame;
+    int ret;
+    while ((ret = frame_decoder_next(&server_in, &frame)) == 1) {
+        // chat-dev27 : 서버의 연결 확인 PING 에는 같은 payload 로 바로 PONG 응답
+        // => 접속 시간에 따라 생기는 프레임이므로 세션 기록, 재생 비교에서 제외 (송신 버퍼가 가득 차 있으면 보내는 중인 프레임이 응답을 대신함)
+        if (frame.cmd == CMD_PING) {
+            if (out_len + FRAME_HEADER_SIZE + frame.len <= sizeof(out_buf)) {
+                out_len += frame_encode(out_buf + out_len, sizeof(out_buf) - out_len, CMD_PONG, frame.payload, frame.len);
+            }
+            continue;
+        }
+        session_record(&recorder, SESSION_RECV, frame.raw, frame.raw_len); // chat-dev21 : 받은 프레임 기록
+        if (replay_path != NULL) {
+            // chat-dev21 : 재생 중에는 화면에 출력하지 않고 기록과 비교할 목록에 추가
+            replay_last_io = session_now_ns();
+            session_log_append(&replay_observed, replay_last_io - replay_start, SESSION_RECV, frame.raw, frame.raw_len);
+        } else {
+            process_server_message(frame.cmd, frame.payload);
+        }
+    }
+    return ret < 0 ? -1 : 0;
+}
+
+// chat-dev21 : 서버 소켓에서 읽을 수 있는 만큼 읽어 프레임 처리 (EAGAIN 까지)
+// 반환 : 1 계속, 0 서버 연결 종료(또는 소켓 오류), -1 잘못된 프레임
+int read_server() {
+    ssize_t n;
+    while ((n = frame_decoder_read(&server_in, sockfd)) > 0) {
+        if (process_server_frames() < 0) {
+            return -1;
+        }
+    }
+    // 0 : 서버에서 연결이 종료될 때 반환되는 EOF(EndOfFile), -1 : 오류 발생 (EAGAIN : 읽을 데이터를 모두 읽음)
+    if (n == 0) {
+        return 0;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 1 : 0;
+}
+
+// chat-dev21 : 기록 파일의 보낸 프레임을 기록된 간격 / replay_speed 로 서버에 보내고, 받은 프레임과 응답 지연을 기록과 비교하여 출력
+// => 표준 입력은 사용하지 않음. 종료 요청(QUIT) 은 보낼 시각이 지나고 REPLAY_QUIET_MS 동안 주고받은 프레임이 없을 때 보냄
+//    (빠른 재생에서 종료 요청이 앞선 요청들과 함께 도착하면 서버가 응답을 보내기 전에 연결을 닫을 수 있으므로)
+//    기록에 종료 요청이 없으면 마지막 이벤트 시각이 지나고 같은 무응답 시간 뒤 쓰기 방향을 닫고 서버가 닫을 때까지 수신
+int run_replay() {
+    SessionLog recorded;
+    if (session_load(&recorded, replay_path) < 0) {
+        fprintf(stderr, "기록 파일을 읽을 수 없습니다. (%s)\n", replay_path);
+        return -1;
+    }
+    uint64_t last_ts = recorded.count ? recorded.events[recorded.count - 1].ts : 0;
+    double scale = replay_speed > 0 ? 1.0 / replay_speed : 0;
+    size_t next = 0;     // 다음에 보낼 이벤트 위치
+    int shut = 0;        // 쓰기 방향을 닫음 (응답 수신만 남음)
+    int result = 0;
+    replay_start = session_now_ns();
+    replay_last_io = replay_start;
+
+    while (1) {
+        uint64_t now = session_now_ns();
+        uint64_t quiet_at = replay_last_io + REPLAY_QUIET_MS * 1000000ull;
+        uint64_t due = 0; // 다음 이벤트를 보낼 시각 (0 : 보낼 이벤트 없음 또는 송신 버퍼 가득 참)
+        // 보낼 시각이 된 프레임을 송신 버퍼에 추가
+        while (next < recorded.count) {
+            SessionEvent* e = &recorded.events[next];
+            if (e->dir != SESSION_SENT || e->len > sizeof(out_buf)) {
+                next++;
+                continue;
+            }
+            if (out_len + e->len > sizeof(out_buf)) {
+                break;
+            }
+            due = replay_start + (uint64_t)(e->ts * scale);
+            if (e->cmd == CMD_QUIT) {
+                if (out_len > 0) {
+                    due = 0; // 앞선 프레임을 모두 보낸 뒤 (POLLOUT)
+                    break;
+                }
+                quiet_at = replay_last_io + REPLAY_QUIET_MS * 1000000ull;
+                if (due < quiet_at) {
+                    due = quiet_at;
+                }
+            }
+            if (due > now) {
+                break;
+            }
+            due = 0;
+            replay_last_io = now;
+            memcpy(out_buf + out_len, recorded.data + e->off, e->len);
+            session_record(&recorder, SESSION_SENT, out_buf + out_len, e->len);
+            session_log_append(&replay_observed, now - replay_start, SESSION_SENT, out_buf + out_len, e->len);
+            out_len += e->len;
+            next++;
+        }
+        if (flush_out() < 0) {
+            break;
+        }
+        session_record_flush(&recorder);
+        if (!shut && next >= recorded.count && out_len == 0) {
+            uint64_t end_at = replay_start + (uint64_t)(last_ts * scale);
+            due = end_at > quiet_at ? end_at : quiet_at;
+            if (now >= due) {
+                shutdown(sockfd, SHUT_WR); // 서버가 연결을 닫을 때까지 남은 응답 수신
+                shut = 1;
+                due = 0;
+            }
+        }
+
+        int timeout = -1;
+        if (due > 0) {
+            timeout = due > now ? (int)((due - now + 999999) / 1000000) : 0;
+        }
+        struct pollfd pfd;
+        pfd.fd = sockfd;
+        pfd.events = POLLIN | (out_len > 0 ? POLLOUT : 0);
+        if (poll(&pfd, 1, timeout) < 0 && errno != EINTR) {
+            perror("poll()");
+            result = -1;
+            break;
+        }
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            int ret = read_server();
+            if (ret <= 0) {
+                if (ret < 0 || next < recorded.count) {
+                    fprintf(stderr, "재생 중 서버 연결이 종료되었습니다. (재생한 이벤트 %zu / %zu)\n", next, recorded.count);
+                    result = -1;
+                }
+                break;
+            }
+        }
+    }
+    session_record_flush(&recorder);
+
+    printf("기록 : %s, 재생 속도 : ", replay_path);
+    if (replay_speed > 0) {
+        printf("%gx\n", replay_speed);
+    } else {
+        printf("최대\n");
+    }
+    session_report(stdout, &recorded, &replay_observed);
+    session_free(&recorded);
+    session_free(&replay_observed);
+    return result;
 }
 
 int main(int argc, char** argv){
     struct sockaddr_in serv_addr; // 서버 주소 구조체
-    char buf[BUFSIZ]; // 메시지 버퍼
+    char buf[LINE_MAX_SIZE]; // 메시지 버퍼
 
     // IP 주소 입력 체크
     if(argc < 2){
@@ -206,6 +484,48 @@ int main(int argc, char** argv){
         return -1;
     }
 
+    // chat-dev21 : 세션 기록 / 재생 옵션
+    const char* record_path = NULL;
+    int port = PORT;
+    for (int i = 2; i < argc; i++) {
+        if (strncmp(argv[i], "--record=", 9) == 0 && argv[i][9] != '\0') {
+            record_path = argv[i] + 9;
+        } else if (strncmp(argv[i], "--replay=", 9) == 0 && argv[i][9] != '\0') {
+            replay_path = argv[i] + 9;
+        } else if (strncmp(argv[i], "--speed=", 8) == 0) {
+            char* end;
+            replay_speed = strcmp(argv[i] + 8, "max") == 0 ? 0 : strtod(argv[i] + 8, &end);
+            if (strcmp(argv[i] + 8, "max") != 0 && (*end != '\0' || replay_speed <= 0)) {
+                fprintf(stderr, "재생 속도는 0 보다 큰 배수 또는 max 여야 합니다.\n");
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--compress=", 11) == 0) {
+            // chat-dev22 : 프레임 압축 협상 여부
+            if (strcmp(argv[i] + 11, "on") == 0) {
+                compress_enabled = 1;
+            } else if (strcmp(argv[i] + 11, "off") == 0) {
+                compress_enabled = 0;
+            } else {
+                fprintf(stderr, "압축 설정은 on, off 중 하나여야 합니다.\n");
+                return -1;
+            }
+        } else if (strncmp(argv[i], "--port=", 7) == 0) {
+            // chat-dev26 : 서버 포트 (서버의 --port / 설정 파일 port 와 같게)
+            port = atoi(argv[i] + 7);
+            if (port < 1 || port > 65535) {
+                fprintf(stderr, "포트는 1 ~ 65535 사이여야 합니다.\n");
+                return -1;
+            }
+        } else {
+            fprintf(stderr, "사용법: %s 서버IP [--port=N] [--record=기록파일] [--replay=기록파일] [--speed=N|max] [--compress=on|off]\n", argv[0]);
+            return -1;
+        }
+    }
+    if (record_path != NULL && session_record_open(&recorder, record_path) < 0) {
+        perror("--record");
+        return -1;
+    }
+
     // 1. socket() : 클라이언트 소켓 생성 (IPv4, TCP STREAM, 0 : ipv4 TCP 기준으로 자동으로 지정되는 통신 protocol)
     if((sockfd = socket(AF_INET, SOCK_STREAM, 0)) == -1){
         perror("socket()");
@@ -218,7 +538,7 @@ int main(int argc, char** argv){
 	// 문자열 IP를 네트워크 바이트 순서로 변환
     // inet_pton() : 입력받은 IP 주소를 네트워크 바이트 순서(빅 엔디안)로 변환하고 serv_addr(서버 주소 구조체) 에 저장
     inet_pton(AF_INET, argv[1], &(serv_addr.sin_addr.s_addr));
-    serv_addr.sin_port = htons(PORT);
+    serv_addr.sin_port = htons(port);
 
     // 2. connect() : 서버에 연결 요청
     // sockfd 클라이언트 소켓이 지정된 서버 주소 구조체 정보로 연결을 시도한다.
@@ -228,11 +548,32 @@ int main(int argc, char** argv){
         return -1;
     }
 
+    frame_decoder_init(&server_in);
+
+    // chat-dev21 : 재생 모드 - 닉네임 요청부터 기록된 프레임을 그대로 보내므로 입력 단계 없이 바로 재생
+    if (replay_path != NULL) {
+        register_sigaction(SIGPIPE, SIG_IGN);
+        fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK);
+        int ret = run_replay();
+        session_record_close(&recorder);
+        close(sockfd);
+        return ret;
+    }
+
     // 1. 닉네임 설정
     while (1) {
         printf("사용할 닉네임을 입력하세요: ");
-        fgets(nickname, sizeof(nickname), stdin);
-        nickname[strcspn(nickname, "\n")] = 0; // 개행 문자 제거
+        // chat-dev20 : 채팅 단계와 같은 줄 조립 버퍼에서 읽음 (stdio 버퍼가 다음 줄까지 가져가지 않도록 fgets 사용 안 함)
+        if (input_read_line(buf) < 0) {
+            close(sockfd);
+            return -1;
+        }
+        size_t nick_len = strlen(buf);
+        if (nick_len >= sizeof(nickname)) {
+            nick_len = sizeof(nickname) - 1; // 기존 fgets 와 같이 닉네임 버퍼 크기만큼만 사용
+        }
+        memcpy(nickname, buf, nick_len);
+        nickname[nick_len] = '\0';
 
         if (strlen(nickname) == 0) {
             printf(COLOR_RED "닉네임은 비워둘 수 없습니다.\n");
@@ -247,21 +588,35 @@ int main(int argc, char** argv){
             continue;
         }
 
-        char request[100];
-        snprintf(request, sizeof(request), "/NICK %s", nickname);
-        // 서버에 닉네임 중복 검사 요청
-        write(sockfd, request, strlen(request));
-
-        char response[100];
-        // 서버에서 닉네임 중복 검사 결과 반환
-        int n = read(sockfd, response, sizeof(response) - 1);
-        if (n <= 0) {
+        // 서버에 닉네임 중복 검사 요청 (chat-dev7 : CMD_NICK 프레임)
+        char nick_frame[FRAME_HEADER_SIZE + sizeof(nickname)];
+        session_record(&recorder, SESSION_SENT, nick_frame, frame_encode(nick_frame, sizeof(nick_frame), CMD_NICK, nickname, strlen(nickname)));
+        frame_write(sockfd, CMD_NICK, nickname, strlen(nickname));
+
+        // 서버에서 닉네임 중복 검사 결과 반환 - 응답 프레임이 완성될 때까지 읽음
+        Frame response;
+        int ret;
+        while ((ret = frame_decoder_next(&server_in, &response)) == 0 || (ret == 1 && response.cmd == CMD_PING)) {
+            if (ret == 1) {
+                continue; // chat-dev27 : 닉네임을 입력하는 동안 서버가 보낸 PING (닉네임 요청이 응답을 대신함)
+            }
+            if (frame_decoder_read(&server_in, sockfd) <= 0) {
+                printf("서버와 연결이 끊겼습니다.\n");
+                return -1;
+            }
+        }
+        if (ret < 0) {
             printf("서버와 연결이 끊겼습니다.\n");
             return -1;
         }
-        response[n] = '\0';
+        session_record(&recorder, SESSION_RECV, response.raw, response.raw_len);
+        // 서버 수용량 초과 등 오류 통지
+        if (response.cmd == CMD_ERROR) {
+            printf(COLOR_RED "%s" COLOR_RESET, response.payload);
+            return -1;
+        }
 
-        if (strcmp(response, "OK") == 0) {
+        if (response.cmd == CMD_NICK && strcmp(response.payload, "OK") == 0) {
             printf("'%s' 닉네임으로 채팅 서버 로비에 입장했습니다.\n", nickname);
             break;
         }
@@ -271,143 +626,92 @@ int main(int argc, char** argv){
         }
     }
 
-    // 0625 구조 수정 : 자식 프로세스에서 부모 프로세스에 보낼 데이터를 파이프로 전송하기 위한 파이프 정의
-    if(pipe(pipe_child_to_parent) == -1 || pipe(pipe_child_to_parent) == -1){
-        perror("pipe_child_to_parent create : ");
-        close(sockfd);
-        return -1;
-    }
+    // chat-dev20 : 닫힌 소켓에 쓸 때 SIGPIPE 로 종료되지 않도록 무시 (전송 오류는 send 반환값으로 처리)
+    register_sigaction(SIGPIPE, SIG_IGN);
+
+    // chat-dev20 : 이벤트 루프에서 소켓이 막히지 않도록 non-blocking 으로 한 번만 설정 (기존 : 수신할 때마다 fcntl 반복)
+    int flags = fcntl(sockfd, F_GETFL, 0);
+    fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
 
-    // 0625 구조 수정 : 자식 프로세스에서 보낼 메시지가 있다는걸 알리기 위한 시그널 등록
-    register_sigaction(SIGUSR1, sigusr1_handler);
-            
-    // 6 단계 : 좀비 프로세스 핸들러 등록
-    register_sigaction(SIGCHLD, handle_sigchld);
-    
     // 로비 입장
     // chat-dev5 : 처음 채팅 서버 로비 접근 시 ANSI 컬러 적용(red)
     printf(COLOR_CYAN "--- Chatting Lobby Room ---\n" COLOR_RESET);
     printf("채팅을 입력하세요.\n \
-        (명령어 모음\n\t/ADD 이름 : 채널방을 '이름' 으로 개설 요청\n\t/LEAVE lobby : 현재 있는 채널방을 나오고 로비 채널로 이동하도록 요청\n\t/RM 채널방이름 : 로비가 아닌 채널방을 없애기\n\t/USER all : 접속한 전체 유저 정보 출력\n\t/USER 채널방이름 : 해당 채널방에 있는 유저 정보 출력\n\t/LIST all : 모든 채팅 채널 리스트를 출력함\n\t/JOIN 채팅채널이름 : 입력한 채팅방에 들어가기\n\t/WHISPER 상대방이름 메시지 : 접속한 상대방에게만 메시지를 보내기\n\t/HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.)\n");
-
-    // 4 단계 : 자식 프로세스에서 수신 담당 프로세스 생성 / 부모 프로세스 : 입력 및 전송 담당
-    pid_t pid = fork();
-
-    if (pid == 0) {
-        // 0625 구조 수정 : 자식: 사용자 입력 → 부모로 시그널 알림
-        while (1) {
-            fgets(buf, BUFSIZ, stdin);
-            // 마지막 문자를 '\0'으로 변경
-            int len = strlen(buf);
-            if (len == 0) {
+        (명령어 모음\n\t/ADD 이름 : 채널방을 '이름' 으로 개설 요청\n\t/LEAVE lobby : 현재 있는 채널방을 나오고 로비 채널로 이동하도록 요청\n\t/RM 채널방이름 : 로비가 아닌 채널방을 없애기\n\t/USER all : 접속한 전체 유저 정보 출력\n\t/USER 채널방이름 : 해당 채널방에 있는 유저 정보 출력\n\t/LIST all : 모든 채팅 채널 리스트를 출력함\n\t/JOIN 채팅채널이름 : 입력한 채팅방에 들어가기\n\t/WHISPER 상대방이름 메시지 : 접속한 상대방에게만 메시지를 보내기\n\t/STATS all : 서버 지표(연결, 명령어별 메시지 수, 처리 시간 등) 출력\n\t/HISTORY 개수 : 현재 채팅 채널의 최근 메시지를 개수만큼 다시 출력\n\t/HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.)\n");
+
+    // chat-dev22 : 서버에 압축 지원을 알림 (응답은 이벤트 루프에서 처리)
+    if (compress_enabled) {
+        queue_frame(CMD_CAPS, "lz4", strlen("lz4"));
+    }
+
+    // chat-dev20 : 이벤트 루프 - 표준 입력(줄 조립 → 송신 버퍼) 과 서버 소켓(수신 프레임 출력, 송신 버퍼 전송) 을 poll 로 함께 처리
+    // 닉네임 응답과 함께 도착한 프레임이 디코더에 남아 있을 수 있으므로 먼저 처리
+    if (process_server_frames() < 0) {
+        printf("\n[서버로부터 잘못된 프레임 수신 - 연결 종료]\n");
+        close(sockfd);
+        return 0;
+    }
+    int quitting = 0; // 1 : 종료 요청 전송 중, 2 : 전송 완료 후 서버 연결 종료 대기
+    while (1) {
+        // 송신 버퍼 여유가 있는 동안 조립된 줄을 처리 (여유가 없으면 전송될 때까지 표준 입력을 읽지 않음)
+        while (!quitting && out_len + LINE_FRAME_MAX <= sizeof(out_buf) && input_next_line(buf)) {
+            quitting = handle_input_line(buf);
+        }
+        // 입력이 끝나면(EOF) q 와 같이 종료 요청
+        if (!quitting && input_eof && input_pos == input_len && out_len + LINE_FRAME_MAX <= sizeof(out_buf)) {
+            quitting = handle_input_line("q");
+        }
+        fflush(stdout);
+        session_record_flush(&recorder);
+        if (flush_out() < 0) {
+            printf("\n[서버 연결 종료]\n");
+            break;
+        }
+        if (quitting == 1 && out_len == 0) {
+            // 종료 요청까지 모두 전송 후 쓰기 방향만 닫고 서버가 연결을 닫을 때까지 수신
+            // => 읽지 않은 수신 데이터가 남은 채로 close 하면 RST 가 전송되어 서버가 아직 읽지 않은 메시지를 버릴 수 있음
+            shutdown(sockfd, SHUT_WR);
+            quitting = 2;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = (quitting || input_eof || out_len + LINE_FRAME_MAX > sizeof(out_buf)) ? -1 : STDIN_FILENO;
+        fds[0].events = POLLIN;
+        fds[1].fd = sockfd;
+        fds[1].events = POLLIN | (out_len > 0 ? POLLOUT : 0);
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
                 continue;
             }
-            if (len > 0) {
-                buf[len - 1] = '\0';
+            perror("poll()");
+            break;
+        }
+
+        if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (input_fill() < 0 && errno != EINTR && errno != EAGAIN) {
+                input_eof = 1;
             }
+        }
 
-            // 종료 조건: buf가 "q" 와 정확히 일치할 때 종료
-            if (strcmp(buf, "q") == 0) {
-                printf(COLOR_RED "[클라이언트] 종료 요청 전송 완료. 종료합니다.\n" COLOR_RESET);
-                break; // break 시 pid SIGTERM 시그널 발생으로 정리
+        if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+            // chat-dev7 : 읽은 바이트를 프레임 디코더에 쌓고 완성된 프레임만 한 개씩 처리
+            // chat-dev20 : 소켓에 쌓인 만큼 읽고(EAGAIN 까지) 출력은 루프에서 한 번에 fflush
+            int ret = read_server();
+            if (ret < 0) {
+                printf("\n[서버로부터 잘못된 프레임 수신 - 연결 종료]\n");
+                break;
             }
-            
-            // chat-dev2 : 위치 이동 - pipe 로 보낼 메시지 프로토콜 생성
-            char sendMsg[BUFSIZ + 12 + 50];
-
-            // chat-dev2 : 자식 클라이언트에서 입력한 문자열이 / 로 시작하는 명령어일 경우
-            if(buf[0] == '/'){
-                char ch[10], str[BUFSIZ + 12 + 50];
-                // stdin 으로 받은 문자열 분리
-                // stdin 으로 받는 문자열 예시 1 : /NICK NICKNAME
-                // 예시 2 : /MSG NICKNAME:MSG
-                // chat-dev2 : 버그 수정 - 메시지에 공백이 있을 때 공백을 메시지에 포함하지 못하는 경우 수정
-                // => sscanf 는 공백 포함 문자열을 담기 어렵기 때문에 strchr 과 strcpy 구조로 변경
-                
-                char* space = strchr(buf, ' ');
-                if (space != NULL) { // 공백이 포함되어 있을 때만 동작
-                    sscanf(buf, "/%s", ch);
-                    strcpy(str, space + 1);  // 공백 이후 문자열 복사
-
-                    // chat-dev2 : /add 채팅방 추가
-                    // 클라이언트에서 먼저 체크 사항: 채팅방 이름 입력 여부, 채팅방 이름 글자 수 제한 충족 여부
-                    if(strcmp(ch, "ADD") == 0){
-                        if(strlen(str) < 6){
-                            printf(COLOR_RED "채팅방 이름은 6바이트 미만(한글 2글자미만) 으로 생성할 수 없습니다.\n" COLOR_RESET);
-                            continue;
-                        }
-                        if(strlen(str) >= 100){
-                            printf(COLOR_RED "채팅방 이름은 100바이트 이상 으로 생성할 수 없습니다.\n" COLOR_RESET);
-                            continue;
-                        }
-                        // pipe 에 보낼 문자열 str 그대로 (명령어 동작이므로 결합 필요없이 그대로 보냄)
-                        snprintf(sendMsg, sizeof(sendMsg), "%s", buf);
-                        // 0625 구조 수정 : pipe 에 서버에 보낼 문자열을 쓰고
-                        write(pipe_child_to_parent[1], sendMsg, strlen(sendMsg));
-                        // 0625 구조 수정 : 부모 프로세스에 보낼 문자열이 있다는 걸 시그널로 알림
-                        kill(getppid(), SIGUSR1);
-                        
-                    } // chat-dev3 : /LEAVE 명령어 - 로비가 아닌 접속한 채팅방을 나오는 명령어
-                    // chat-dev4 : /RM 명령어 - 로비가 아닌 채팅방을 지우고, 채팅방에 있던 유저들을 모두 로비로 옮김
-                    // chat-dev4 : /USERS all - 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보(해당 유저가 접속한 채팅방, 유저 이름) 를 출력
-                    //             /USERS 채팅방이름 - 해당 채팅 채널방에 속해 있는 모든 클라이언트 유저 정보를 출력
-                    // chat-dev4 : /LIST all - 모든 채널방 리스트를 출력함
-                    // chat-dev4 : /JOIN 채널방이름 - 서버에 활성화된 채팅 채널방으로 이동함
-                    
-                    else if (strcmp(ch, "LEAVE") == 0 || strcmp(ch, "RM") == 0 || strcmp(ch, "USER") == 0 || strcmp(ch, "LIST") == 0 || strcmp(ch, "JOIN") == 0){
-                        // pipe 에 작성할 문자열 작성
-                        snprintf(sendMsg, sizeof(sendMsg), "%s", buf);
-                        write(pipe_child_to_parent[1], sendMsg, strlen(sendMsg));
-                        kill(getppid(), SIGUSR1);
-                    } else if(strcmp(ch, "WHISPER") == 0){
-                        // chat-dev5 : /WHISPER 사용자이름 메시지 - 서버에 접속한 사용자에게만 귓속말 전달
-                        snprintf(sendMsg, sizeof(sendMsg), "/WHISPER %s:%s", nickname, str);
-                        write(pipe_child_to_parent[1], sendMsg, strlen(sendMsg));
-                        kill(getppid(), SIGUSR1);
-                    } else if(strcmp(ch, "HELP") == 0 && strcmp(str, "CMD") == 0){
-                        // chat-dev5 : /HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.
-                        char howToCmdUse[BUFSIZ * 5] = "(명령어 모음\n\t/ADD 이름 : 채널방을 '이름' 으로 개설 요청\n\t/LEAVE lobby : 현재 있는 채널방을 나오고 로비 채널로 이동하도록 요청\n\t/RM 채널방이름 : 로비가 아닌 채널방을 없애기\n\t/USER all : 접속한 전체 유저 정보 출력\n\t/USER 채널방이름 : 해당 채널방에 있는 유저 정보 출력\n\t/LIST all : 모든 채팅 채널 리스트를 출력함\n\t/JOIN 채팅채널이름 : 입력한 채팅방에 들어가기\n\t/WHISPER 상대방이름 메시지 : 접속한 상대방에게만 메시지를 보내기\n\t/HELP CMD - 모든 명령어(CMD) 사용 방법을 다시 출력한다.)\n";
-                        printf(COLOR_YELLOW "\n%s\n" COLOR_RESET, howToCmdUse);
-                        fflush(stdout);  // 입력줄 깨지지 않도록
-                    }
-                } else { // / 명령어 동작을 잘못했을 경우 예외 처리(클라이언트)
-                        printf(COLOR_RED "명령어 동작 방법을 확인하고 다시 입력해주세요.\n" COLOR_RESET);
-                        continue;
+            if (ret == 0) {
+                if (!quitting) {
+                    printf("\n[서버 연결 종료]\n");
                 }
-            } else { // chat-dev2 : 자식 클라이언트에서 입력한 문자열이 명령어가 아닐 경우 
-                // 현재 채팅방에 전송할 메시지로 동작함 (/MSG 로 동작)
-                // pipe 에 보낼 문자열 결합
-                snprintf(sendMsg, sizeof(sendMsg), "/MSG %s:%s", nickname, buf);
-                write(pipe_child_to_parent[1], sendMsg, strlen(sendMsg));
-                kill(getppid(), SIGUSR1);
-            } 
-        }
-        kill(pid, SIGTERM); // 자식 프로세스 종료
-    } else {
-        // 0625 구조 수정 : 부모 : 자식으로부터 시그널을 받고 메시지를 프로토콜 전송 or 서버로부터 메시지를 받음 
-        while (1) {
-            // read 파트를 위한 부분 시작 : 서버로부터 메시지를 받고 process_server_message 처리에 따른 동작
-            int n = read(sockfd, buf, BUFSIZ + 10 + 50);
-            // 서버가 연결을 종료했거나 오류 발생 시
-            // 0 : 서버에서 연결이 종료될 때 반환되는 EOF(EndOfFile)
-            // -1 : 오류 발생
-            if (n <= 0) {
-                printf("\n[서버 연결 종료]\n");
-                kill(getppid(), SIGTERM); // 부모에게 종료 알림
-                exit(0);
-            } else {
-                buf[n] = '\0';
-                process_server_message(buf);
+                break;
             }
-
-            // write part 를 위한 부분 시작 : 자식으로부터 시그널을 받고 서버에 메시지 전달
-            // 부모가 읽는 파이프를 non-blocking 모드로 설정해 핸들러가 멈추지 않도록 함
-            int flags = fcntl(pipe_child_to_parent[0], F_GETFL, 0);
-            fcntl(pipe_child_to_parent[0], F_SETFL, flags | O_NONBLOCK);
         }
     }
 
     // 종료 처리
+    session_record_close(&recorder);
     close(sockfd);
     printf("클라이언트를 종료합니다.\n");
     return 0;
@@ -0,0 +1,125 @@
+#include <string.h>
+
+#include "command.h"
+
+// chat-dev23 : 명령어 번호 → 인자 형식 표 (없는 칸은 COMMAND_ARG_INVALID)
+static const unsigned char command_formats[CMD_MAX] = {
+    [CMD_NICK] = COMMAND_ARG_WORD,
+    [CMD_MSG] = COMMAND_ARG_CHAT,
+    [CMD_ADD] = COMMAND_ARG_WORD,
+    [CMD_LEAVE] = COMMAND_ARG_WORD,
+    [CMD_RM] = COMMAND_ARG_WORD,
+    [CMD_USER] = COMMAND_ARG_WORD,
+    [CMD_LIST] = COMMAND_ARG_WORD,
+    [CMD_JOIN] = COMMAND_ARG_WORD,
+    [CMD_WHISPER] = COMMAND_ARG_WHISPER,
+    [CMD_QUIT] = COMMAND_ARG_EMPTY,
+    [CMD_STATS] = COMMAND_ARG_WORD,
+    [CMD_HISTORY] = COMMAND_ARG_NUMBER,
+    [CMD_CAPS] = COMMAND_ARG_WORD,
+    [CMD_PING] = COMMAND_ARG_WORD,
+    [CMD_PONG] = COMMAND_ARG_WORD,
+};
+
+static const char* command_errors[] = {
+    [COMMAND_OK] = "ok",
+    [COMMAND_ERR_UNKNOWN] = "unknown",
+    [COMMAND_ERR_FORMAT] = "format",
+    [COMMAND_ERR_LENGTH] = "length",
+};
+
+int command_arg_format(int cmd) {
+    if (cmd <= CMD_NONE || cmd >= CMD_MAX) {
+        return COMMAND_ARG_INVALID;
+    }
+    return command_formats[cmd];
+}
+
+const char* command_error_name(int err) {
+    if (err < COMMAND_OK || err > COMMAND_ERR_LENGTH) {
+        return "?";
+    }
+    return command_errors[err];
+}
+
+// 보낸닉네임:나머지 에서 닉네임 구간을 나누고 나머지 구간을 rest 에 돌려줌
+static int command_split_nick(const char* p, size_t len, StrView* nick, StrView* rest) {
+    const char* colon = memchr(p, ':', len);
+    if (colon == NULL) {
+        return COMMAND_ERR_FORMAT;
+    }
+    nick->ptr = p;
+    nick->len = colon - p;
+    if (nick->len > COMMAND_NICK_MAX) {
+        return COMMAND_ERR_LENGTH;
+    }
+    rest->ptr = colon + 1;
+    rest->len = len - nick->len - 1;
+    return COMMAND_OK;
+}
+
+// cmd 명령어의 payload(len 바이트) 를 인자 형식대로 나눔 (payload 는 복사하지 않고 out 의 view 가 가리킴)
+// 반환 : COMMAND_OK, COMMAND_ERR_* (out 의 view 는 COMMAND_OK 일 때만 의미 있음)
+int command_parse(int cmd, const char* payload, size_t len, Command* out) {
+    int format = command_arg_format(cmd);
+    out->cmd = cmd;
+    out->nick.ptr = NULL;
+    out->nick.len = 0;
+    out->target.ptr = NULL;
+    out->target.len = 0;
+    out->number = -1;
+    if (format == COMMAND_ARG_INVALID) {
+        return COMMAND_ERR_UNKNOWN;
+    }
+    len = strnlen(payload, len);
+    out->arg.ptr = payload;
+    out->arg.len = len;
+
+    switch (format) {
+    case COMMAND_ARG_EMPTY:
+        return COMMAND_OK;
+    case COMMAND_ARG_WORD:
+        return len > COMMAND_WORD_MAX ? COMMAND_ERR_LENGTH : COMMAND_OK;
+    case COMMAND_ARG_NUMBER:
+        if (len > COMMAND_WORD_MAX) {
+            return COMMAND_ERR_LENGTH;
+        }
+        // 숫자만 있고 자릿수 이내일 때만 값으로 인정 (범위 확인은 명령어 처리에서 - 안내 문구를 응답)
+        if (len > 0 && len <= COMMAND_NUMBER_MAX) {
+            long n = 0;
+            size_t k = 0;
+            while (k < len && payload[k] >= '0' && payload[k] <= '9') {
+                n = n * 10 + (payload[k++] - '0');
+            }
+            if (k == len) {
+                out->number = n;
+            }
+        }
+        return COMMAND_OK;
+    case COMMAND_ARG_CHAT: {
+        int ret = command_split_nick(payload, len, &out->nick, &out->arg);
+        if (ret == COMMAND_OK && out->arg.len > COMMAND_TEXT_MAX) {
+            return COMMAND_ERR_LENGTH;
+        }
+        return ret;
+    }
+    case COMMAND_ARG_WHISPER: {
+        StrView rest;
+        int ret = command_split_nick(payload, len, &out->nick, &rest);
+        if (ret != COMMAND_OK) {
+            return ret;
+        }
+        // 받는닉네임 과 메시지는 첫 공백으로 나눔 (공백이 없으면 메시지 없음 - 사용 방법 안내)
+        const char* space = memchr(rest.ptr, ' ', rest.len);
+        out->target.ptr = rest.ptr;
+        out->target.len = space != NULL ? (size_t)(space - rest.ptr) : rest.len;
+        out->arg.ptr = space != NULL ? space + 1 : NULL;
+        out->arg.len = space != NULL ? rest.len - out->target.len - 1 : 0;
+        if (out->target.len > COMMAND_NICK_MAX || out->arg.len > COMMAND_TEXT_MAX) {
+            return COMMAND_ERR_LENGTH;
+        }
+        return COMMAND_OK;
+    }
+    }
+    return COMMAND_ERR_UNKNOWN;
+}
@@ -0,0 +1,56 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "protocol.h"
+
+// chat-dev23 : 명령어 payload 파서
+// => 프레임 명령어 바이트(CMD_*) 가 곧 미리 계산된 명령어 번호이므로 문자열 비교 없이 명령어별 인자 형식 표로 payload 를 나누고,
+//    인자는 수신 버퍼를 가리키는 (포인터, 길이) view 로만 돌려줌 (기존 snprintf / strcpy 중간 복사 없음)
+//    payload 는 첫 NUL 까지만 사용하고 (기존 문자열 처리와 같음), 구분자가 없거나 길이 제한을 넘으면 COMMAND_ERR_* 로 거절
+//    (기존에는 ':' 가 없는 /MSG 가 초기화되지 않은 버퍼를 보내고, 긴 닉네임 / 메시지는 스택 버퍼를 넘어 덮어씀)
+#define COMMAND_NICK_MAX  50            // /MSG, /WHISPER 의 보낸 / 받는 닉네임 최대 길이
+#define COMMAND_TEXT_MAX  (BUFSIZ - 1)  // /MSG, /WHISPER 메시지 최대 길이
+#define COMMAND_WORD_MAX  BUFSIZ        // 인자 하나인 명령어의 인자 최대 길이
+#define COMMAND_NUMBER_MAX 9            // /HISTORY 숫자 최대 자릿수
+
+// payload 안의 구간 (NUL 종료 아님 - Command.arg 의 COMMAND_ARG_WORD 만 예외)
+typedef struct {
+    const char* ptr;
+    size_t len;
+} StrView;
+
+// 명령어별 인자 형식
+enum {
+    COMMAND_ARG_INVALID = 0, // 클라이언트가 보낼 수 없는 명령어 (NONE, ERROR)
+    COMMAND_ARG_EMPTY,       // 인자 없음 (QUIT)
+    COMMAND_ARG_WORD,        // payload 전체가 인자 하나 (NICK, ADD, LEAVE, RM, USER, LIST, JOIN, STATS, CAPS)
+    COMMAND_ARG_NUMBER,      // 10진수 (HISTORY)
+    COMMAND_ARG_CHAT,        // 보낸닉네임:메시지 (MSG)
+    COMMAND_ARG_WHISPER      // 보낸닉네임:받는닉네임 메시지 (WHISPER)
+};
+
+// 나눈 명령어 인자
+typedef struct {
+    int cmd;
+    StrView arg;    // WORD / NUMBER : payload 전체 (ptr[len] 이 NUL 임이 보장됨), CHAT / WHISPER : 메시지 (WHISPER 에 공백이 없으면 ptr NULL)
+    StrView nick;   // CHAT / WHISPER : 보낸 닉네임
+    StrView target; // WHISPER : 받는 닉네임
+    long number;    // NUMBER : 숫자 (-1 : 숫자가 아님)
+} Command;
+
+// command_parse 결과
+enum {
+    COMMAND_OK = 0,
+    COMMAND_ERR_UNKNOWN, // 클라이언트가 보낼 수 없는 명령어
+    COMMAND_ERR_FORMAT,  // 구분자(':') 없음
+    COMMAND_ERR_LENGTH   // 닉네임, 메시지, 인자 길이 제한 초과
+};
+
+int command_arg_format(int cmd);
+int command_parse(int cmd, const char* payload, size_t len, Command* out);
+const char* command_error_name(int err);
+
+#endif
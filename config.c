@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "config.h"
+
+// 앞뒤 공백 제거 (s 를 직접 수정하고 시작 위치 반환)
+static char* config_trim(char* s) {
+    while (isspace((unsigned char)*s)) {
+        s++;
+    }
+    size_t len = strlen(s);
+    while (len > 0 && isspace((unsigned char)s[len - 1])) {
+        s[--len] = '\0';
+    }
+    return s;
+}
+
+// path 설정 파일의 모든 줄을 순서대로 apply 에 넘김
+// 반환 0 : 모두 적용, -1 : 파일을 열 수 없음 또는 형식이 잘못되었거나 apply 가 거절한 줄이 있음 (줄 번호를 stderr 에 출력)
+int config_load(const char* path, ConfigApplyFn apply) {
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL) {
+        fprintf(stderr, "설정 파일 %s 을 열 수 없습니다. (%s)\n", path, strerror(errno));
+        return -1;
+    }
+    char line[CONFIG_LINE_MAX];
+    char option[CONFIG_LINE_MAX + 3];
+    int lineno = 0;
+    int ret = 0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        lineno++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        char* key = config_trim(line);
+        if (*key == '\0') {
+            continue;
+        }
+        char* eq = strchr(key, '=');
+        if (eq == NULL) {
+            fprintf(stderr, "설정 파일 %s:%d : \"키 = 값\" 형식이 아닙니다.\n", path, lineno);
+            ret = -1;
+            break;
+        }
+        *eq = '\0';
+        key = config_trim(key);
+        char* value = config_trim(eq + 1);
+        for (char* p = key; *p; p++) {
+            if (*p == '_') {
+                *p = '-';
+            }
+        }
+        snprintf(option, sizeof(option), "--%s=%s", key, value);
+        if (apply(option) < 0) {
+            fprintf(stderr, "설정 파일 %s:%d : %s 를 적용하지 못했습니다.\n", path, lineno, option);
+            ret = -1;
+            break;
+        }
+    }
+    fclose(fp);
+    return ret;
+}
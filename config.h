@@ -0,0 +1,15 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// chat-dev26 : 서버 설정 파일 (--config=PATH)
+// => 한 줄에 "키 = 값" 하나, # 뒤는 주석, 빈 줄은 무시
+//    키는 실행 인자 이름과 같고 ('--' 없이, '_' 는 '-' 로 읽음 - 예 : max_clients = 500 → --max-clients=500)
+//    각 줄을 실행 인자 형식으로 바꿔 apply 에 넘기므로 서버는 실행 인자와 같은 검사로 설정을 적용함
+#define CONFIG_LINE_MAX 1024
+
+// option : "--키=값" (반환 0 : 적용, -1 : 잘못된 값 - apply 가 이유를 stderr 에 출력)
+typedef int (*ConfigApplyFn)(const char* option);
+
+int config_load(const char* path, ConfigApplyFn apply);
+
+#endif
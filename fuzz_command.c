@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <dirent.h>
+
+#include "protocol.h"
+#include "command.h"
+
+// chat-dev23 : 명령어 파서 fuzz 검사
+// => 코퍼스 입력(첫 바이트 : 명령어 바이트, 나머지 : payload) 과 이를 무작위로 변형한 입력을 command_parse 에 넣고
+//    잘못된 입력을 안전하게 거절하는지(결과 값, view 가 payload 안을 가리키는지, 길이 제한, NUL 종료) 를 확인
+//    make fuzz_command 는 AddressSanitizer / UndefinedBehaviorSanitizer 를 켜서 빌드하므로 범위 밖 읽기도 바로 중단됨
+// 사용법 : ./fuzz_command [코퍼스 디렉토리] [변형 반복 수] [seed]
+//   libFuzzer 로 빌드할 때는 -DFUZZ_LIBFUZZER -fsanitize=fuzzer 로 LLVMFuzzerTestOneInput 만 사용 (main 제외)
+#define FUZZ_MAX_INPUT (BUFSIZ * 2 + 1) // 변형 입력 최대 크기 (길이 제한을 넘는 입력 포함)
+#define FUZZ_MAX_FILES 256
+
+// 결과별 입력 수
+long fuzz_results[COMMAND_ERR_LENGTH + 1];
+
+// 검사 실패 : 입력을 출력하고 중단
+void fuzz_fail(const char* what, const uint8_t* data, size_t size) {
+    fprintf(stderr, "검사 실패 : %s (입력 %zu 바이트 :", what, size);
+    for (size_t k = 0; k < size && k < 64; k++) {
+        fprintf(stderr, " %02x", data[k]);
+    }
+    fprintf(stderr, "%s)\n", size > 64 ? " ..." : "");
+    abort();
+}
+
+// view 가 payload[0, len] 안에 있고 NUL 을 포함하지 않는지 확인
+int fuzz_view_ok(StrView v, const char* payload, size_t len) {
+    if (v.ptr == NULL) {
+        return v.len == 0;
+    }
+    if (v.ptr < payload || v.ptr > payload + len || v.len > (size_t)(payload + len - v.ptr)) {
+        return 0;
+    }
+    return memchr(v.ptr, '\0', v.len) == NULL;
+}
+
+// 입력 한 개 검사 (서버의 FrameDecoder 처럼 payload 뒤에 NUL 을 붙여서 전달)
+int fuzz_one(const uint8_t* data, size_t size) {
+    if (size < 1) {
+        return 0;
+    }
+    int cmd = data[0];
+    size_t len = size - 1;
+    char* payload = malloc(len + 1);
+    if (payload == NULL) {
+        return 0;
+    }
+    memcpy(payload, data + 1, len);
+    payload[len] = '\0';
+
+    Command c;
+    int ret = command_parse(cmd, payload, len, &c);
+    int format = command_arg_format(cmd);
+    if (ret < COMMAND_OK || ret > COMMAND_ERR_LENGTH) {
+        fuzz_fail("알 수 없는 결과 값", data, size);
+    }
+    fuzz_results[ret]++;
+    if ((format == COMMAND_ARG_INVALID) != (ret == COMMAND_ERR_UNKNOWN)) {
+        fuzz_fail("명령어 번호와 결과가 맞지 않음", data, size);
+    }
+
+    if (ret == COMMAND_OK) {
+        if (c.cmd != cmd) {
+            fuzz_fail("명령어 번호가 바뀜", data, size);
+        }
+        if (!fuzz_view_ok(c.arg, payload, len) || !fuzz_view_ok(c.nick, payload, len) || !fuzz_view_ok(c.target, payload, len)) {
+            fuzz_fail("view 가 payload 밖을 가리키거나 NUL 을 포함함", data, size);
+        }
+        switch (format) {
+        case COMMAND_ARG_WORD:
+        case COMMAND_ARG_NUMBER:
+            if (c.arg.ptr != payload || c.arg.len > COMMAND_WORD_MAX || c.arg.ptr[c.arg.len] != '\0') {
+                fuzz_fail("인자가 payload 전체가 아니거나 NUL 종료가 아님", data, size);
+            }
+            if (format == COMMAND_ARG_NUMBER && (c.number < -1 || c.number > 999999999L)) {
+                fuzz_fail("숫자 범위", data, size);
+            }
+            break;
+        case COMMAND_ARG_CHAT:
+        case COMMAND_ARG_WHISPER:
+            if (c.nick.ptr != payload || c.nick.len > COMMAND_NICK_MAX || c.nick.ptr[c.nick.len] != ':' ||
+                memchr(c.nick.ptr, ':', c.nick.len) != NULL) {
+                fuzz_fail("보낸 닉네임 구간", data, size);
+            }
+            if (c.arg.len > COMMAND_TEXT_MAX) {
+                fuzz_fail("메시지 길이 제한", data, size);
+            }
+            if (format == COMMAND_ARG_WHISPER &&
+                (c.target.ptr == NULL || c.target.len > COMMAND_NICK_MAX || memchr(c.target.ptr, ' ', c.target.len) != NULL)) {
+                fuzz_fail("받는 닉네임 구간", data, size);
+            }
+            break;
+        }
+    } else if (ret == COMMAND_ERR_FORMAT && (format == COMMAND_ARG_CHAT || format == COMMAND_ARG_WHISPER) &&
+               memchr(payload, ':', strlen(payload)) != NULL) {
+        fuzz_fail("구분자가 있는데 형식 오류", data, size);
+    }
+    free(payload);
+    return 0;
+}
+
+#ifdef FUZZ_LIBFUZZER
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    return fuzz_one(data, size);
+}
+#else
+// 변형 : 바이트 바꾸기, 구분자 / NUL 넣기, 자르기, 같은 바이트로 늘리기 (길이 제한 경계 통과), 명령어 바이트 바꾸기
+size_t fuzz_mutate(uint8_t* buf, size_t size) {
+    static const uint8_t special[] = { ':', ' ', '\0', '0', '9', 0xff, 0x80 };
+    int rounds = 1 + rand() % 4;
+    for (int r = 0; r < rounds; r++) {
+        switch (rand() % 6) {
+        case 0:
+            if (size > 0) {
+                buf[rand() % size] ^= (uint8_t)(1 << (rand() % 8));
+            }
+            break;
+        case 1:
+            if (size > 0) {
+                buf[rand() % size] = special[rand() % sizeof(special)];
+            }
+            break;
+        case 2:
+            size = size > 0 ? (size_t)rand() % (size + 1) : 0;
+            break;
+        case 3: {
+            size_t grow = (rand() % 2) ? (size_t)(rand() % 64) : (size_t)(rand() % (BUFSIZ + 64));
+            if (size + grow > FUZZ_MAX_INPUT) {
+                grow = FUZZ_MAX_INPUT - size;
+            }
+            memset(buf + size, size > 0 ? buf[size - 1] : 'a', grow);
+            size += grow;
+            break;
+        }
+        case 4:
+            if (size > 0) {
+                buf[0] = (uint8_t)(rand() % 2 ? rand() % (CMD_MAX + 2) : rand() % 256);
+            }
+            break;
+        case 5:
+            if (size < FUZZ_MAX_INPUT) {
+                buf[size++] = special[rand() % sizeof(special)];
+            }
+            break;
+        }
+    }
+    return size;
+}
+
+// 코퍼스 파일 읽기 (FUZZ_MAX_INPUT 바이트까지)
+size_t fuzz_read_file(const char* path, uint8_t* buf) {
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+    size_t n = fread(buf, 1, FUZZ_MAX_INPUT, fp);
+    fclose(fp);
+    return n;
+}
+
+int main(int argc, char** argv) {
+    const char* dir = argc > 1 ? argv[1] : "fuzz/command";
+    long iterations = argc > 2 ? atol(argv[2]) : 1000000;
+    unsigned seed = argc > 3 ? (unsigned)atol(argv[3]) : 1;
+    if (iterations < 0) {
+        fprintf(stderr, "사용법: %s [코퍼스 디렉토리] [변형 반복 수(0 이상)] [seed]\n", argv[0]);
+        return 1;
+    }
+    srand(seed);
+
+    static uint8_t corpus[FUZZ_MAX_FILES][FUZZ_MAX_INPUT];
+    static size_t corpus_size[FUZZ_MAX_FILES];
+    int files = 0;
+    DIR* d = opendir(dir);
+    if (d == NULL) {
+        perror("opendir");
+        return 1;
+    }
+    struct dirent* ent;
+    while ((ent = readdir(d)) != NULL && files < FUZZ_MAX_FILES) {
+        if (ent->d_name[0] == '.') {
+            continue;
+        }
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir, ent->d_name);
+        corpus_size[files] = fuzz_read_file(path, corpus[files]);
+        fuzz_one(corpus[files], corpus_size[files]);
+        files++;
+    }
+    closedir(d);
+    if (files == 0) {
+        fprintf(stderr, "%s 에 코퍼스 파일이 없습니다.\n", dir);
+        return 1;
+    }
+
+    static uint8_t buf[FUZZ_MAX_INPUT];
+    for (long k = 0; k < iterations; k++) {
+        int pick = rand() % files;
+        memcpy(buf, corpus[pick], corpus_size[pick]);
+        size_t size = fuzz_mutate(buf, corpus_size[pick]);
+        fuzz_one(buf, size);
+    }
+
+    printf("코퍼스 %d 개, 변형 %ld 개 검사 통과\n", files, iterations);
+    for (int r = COMMAND_OK; r <= COMMAND_ERR_LENGTH; r++) {
+        printf("  %-8s %ld\n", command_error_name(r), fuzz_results[r]);
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#include "ipc_ring.h"
+
+// chat-dev8 : 공유 메모리 링 생성 (MAP_SHARED | MAP_ANONYMOUS - fork 된 자식과 공유됨)
+ShmRing* shm_ring_create(size_t capacity) {
+    // 링 인덱스 계산을 & 연산으로 하기 위해 2 의 거듭제곱만 허용
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    void* mem = mmap(NULL, sizeof(ShmRing) + capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+    ShmRing* r = mem;
+    r->head = 0;
+    r->tail = 0;
+    r->capacity = capacity;
+    return r;
+}
+
+void shm_ring_destroy(ShmRing* r) {
+    if (r != NULL) {
+        munmap(r, sizeof(ShmRing) + r->capacity);
+    }
+}
+
+size_t shm_ring_used(const ShmRing* r) {
+    return __atomic_load_n(&r->head, __ATOMIC_SEQ_CST) - __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST);
+}
+
+// 생산자 : len 바이트를 모두 쓰거나(0) 공간이 부족하면 아무것도 쓰지 않음(-1)
+// => 프레임이 중간에 잘린 채 링에 들어가지 않도록 all-or-nothing 으로 씀
+// was_empty : 쓰기 직후 소비자가 이전 데이터를 모두 읽은 상태였다면 1 (소비자가 잠들었을 수 있으므로 알림 필요)
+int shm_ring_write(ShmRing* r, const void* data, size_t len, int* was_empty) {
+    uint64_t head = r->head; // 생산자만 head 를 바꾸므로 일반 load 로 충분
+    uint64_t tail = __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST);
+
+    if (r->capacity - (head - tail) < len) {
+        return -1;
+    }
+    size_t off = head & (r->capacity - 1);
+    size_t first = r->capacity - off;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(r->data + off, data, first);
+    memcpy(r->data, (const char*)data + first, len - first);
+
+    // 데이터 복사 후 head 공개, 이어서 tail 을 다시 읽음 (seq_cst : 소비자의 "tail 저장 → head 확인" 과 짝을 이룸)
+    // 소비자가 head 를 확인하기 전에 공개되었다면 소비자가 이어서 읽고,
+    // 그렇지 않다면 여기서 읽는 tail 이 이전 head 와 같으므로 알림을 보냄 → 알림 유실 없음
+    __atomic_store_n(&r->head, head + len, __ATOMIC_SEQ_CST);
+    if (was_empty != NULL) {
+        *was_empty = (__atomic_load_n(&r->tail, __ATOMIC_SEQ_CST) == head);
+    }
+    return 0;
+}
+
+// chat-dev10 : 생산자 - 여러 구간(헤더 + 프레임 등) 을 하나의 레코드로 모두 쓰거나 아무것도 쓰지 않음
+int shm_ring_writev(ShmRing* r, const struct iovec* iov, int iovcnt, int* was_empty) {
+    uint64_t head = r->head;
+    uint64_t tail = __atomic_load_n(&r->tail, __ATOMIC_SEQ_CST);
+    size_t len = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        len += iov[i].iov_len;
+    }
+    if (r->capacity - (head - tail) < len) {
+        return -1;
+    }
+    uint64_t pos = head;
+    for (int i = 0; i < iovcnt; i++) {
+        size_t off = pos & (r->capacity - 1);
+        size_t first = r->capacity - off;
+        if (first > iov[i].iov_len) {
+            first = iov[i].iov_len;
+        }
+        memcpy(r->data + off, iov[i].iov_base, first);
+        memcpy(r->data, (const char*)iov[i].iov_base + first, iov[i].iov_len - first);
+        pos += iov[i].iov_len;
+    }
+
+    // shm_ring_write 와 같은 순서로 공개 후 알림 필요 여부 확인
+    __atomic_store_n(&r->head, head + len, __ATOMIC_SEQ_CST);
+    if (was_empty != NULL) {
+        *was_empty = (__atomic_load_n(&r->tail, __ATOMIC_SEQ_CST) == head);
+    }
+    return 0;
+}
+
+// chat-dev10 : 소비자 - 정확히 len 바이트를 buf 로 복사하고 소비 (데이터가 부족하면 아무것도 하지 않고 -1)
+int shm_ring_read(ShmRing* r, void* buf, size_t len) {
+    const char* p1;
+    const char* p2;
+    size_t n1, n2;
+    if (shm_ring_peek(r, &p1, &n1, &p2, &n2) < len) {
+        return -1;
+    }
+    if (n1 > len) {
+        n1 = len;
+    }
+    memcpy(buf, p1, n1);
+    memcpy((char*)buf + n1, p2, len - n1);
+    shm_ring_consume(r, len);
+    return 0;
+}
+
+// 소비자 : 읽을 수 있는 데이터를 복사 없이 최대 두 구간(링 끝에서 나뉜 경우)으로 반환
+size_t shm_ring_peek(ShmRing* r, const char** p1, size_t* n1, const char** p2, size_t* n2) {
+    uint64_t tail = r->tail; // 소비자만 tail 을 바꿈
+    uint64_t head = __atomic_load_n(&r->head, __ATOMIC_SEQ_CST);
+    size_t used = head - tail;
+    size_t off = tail & (r->capacity - 1);
+    size_t first = r->capacity - off;
+    if (first > used) {
+        first = used;
+    }
+    *p1 = r->data + off;
+    *n1 = first;
+    *p2 = r->data;
+    *n2 = used - first;
+    return used;
+}
+
+// 소비자 : peek 로 확인한 데이터 중 n 바이트를 다 썼음을 생산자에게 알림
+void shm_ring_consume(ShmRing* r, size_t n) {
+    __atomic_store_n(&r->tail, r->tail + n, __ATOMIC_SEQ_CST);
+}
+
+// chat-dev9 : 방 로그 생성 (fork() 전에 만들어 모든 자식이 같은 로그를 보도록 함)
+RoomLog* room_log_create(size_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        errno = EINVAL;
+        return NULL;
+    }
+    void* mem = mmap(NULL, sizeof(RoomLog) + capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+    RoomLog* log = mem;
+    log->head = 0;
+    log->write_end = 0;
+    log->capacity = capacity;
+    return log;
+}
+
+void room_log_destroy(RoomLog* log) {
+    if (log != NULL) {
+        munmap(log, sizeof(RoomLog) + log->capacity);
+    }
+}
+
+uint64_t room_log_head(const RoomLog* log) {
+    return __atomic_load_n(&log->head, __ATOMIC_ACQUIRE);
+}
+
+// 생산자 : len 바이트를 로그 끝에 추가 (소비자를 기다리지 않고 가장 오래된 데이터를 덮어씀)
+int room_log_append(RoomLog* log, const void* data, size_t len) {
+    if (len > log->capacity) {
+        return -1;
+    }
+    uint64_t head = log->head; // 생산자만 head 를 바꿈
+    // 덮어쓸 영역을 먼저 공개한 뒤 데이터 복사 (seqlock 의 쓰기 순서와 동일)
+    __atomic_store_n(&log->write_end, head + len, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    size_t off = head & (log->capacity - 1);
+    size_t first = log->capacity - off;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(log->data + off, data, first);
+    memcpy(log->data, (const char*)data + first, len - first);
+
+    __atomic_store_n(&log->head, head + len, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// 소비자 : cursor 부터 limit(공개된 head 이하) 까지 최대 cap 바이트를 buf 로 복사 (cursor 는 바꾸지 않음)
+// 반환 : 복사한 바이트 수, -1 복사 중 또는 이전에 생산자가 해당 영역을 덮어씀(유실)
+ssize_t room_log_read(const RoomLog* log, uint64_t cursor, uint64_t limit, char* buf, size_t cap) {
+    if (limit - cursor > log->capacity) {
+        return -1;
+    }
+    size_t len = limit - cursor;
+    if (len > cap) {
+        len = cap;
+    }
+    size_t off = cursor & (log->capacity - 1);
+    size_t first = log->capacity - off;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(buf, log->data + off, first);
+    memcpy(buf + first, log->data, len - first);
+
+    // 복사 후 생산자가 덮어쓰기 시작한 위치를 다시 확인하여 찢어진 데이터를 버림 (seqlock 의 읽기 검증과 동일)
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t write_end = __atomic_load_n(&log->write_end, __ATOMIC_RELAXED);
+    if (write_end - cursor > log->capacity) {
+        return -1;
+    }
+    return len;
+}
+
+// chat-dev18 : 소비자 : cursor 부터 limit 까지를 복사 없이 가리킴 (링 끝에서 나뉘면 두 구간)
+// 가리킨 데이터는 생산자가 언제든 덮어쓸 수 있으므로 사용한 뒤 room_log_valid 로 확인해야 함
+// 반환 : 구간 바이트 수, -1 이미 생산자가 해당 영역을 덮어씀(유실)
+ssize_t room_log_peek(const RoomLog* log, uint64_t cursor, uint64_t limit, const char** p1, size_t* n1, const char** p2, size_t* n2) {
+    if (!room_log_valid(log, cursor) || limit - cursor > log->capacity) {
+        return -1;
+    }
+    size_t len = limit - cursor;
+    size_t off = cursor & (log->capacity - 1);
+    *n1 = log->capacity - off;
+    if (*n1 > len) {
+        *n1 = len;
+    }
+    *p1 = log->data + off;
+    *p2 = log->data;
+    *n2 = len - *n1;
+    return len;
+}
+
+// chat-dev18 : 소비자 : cursor 이후 데이터를 생산자가 아직 덮어쓰지 않았는지 확인 (room_log_read 의 복사 후 검증과 동일)
+int room_log_valid(const RoomLog* log, uint64_t cursor) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t write_end = __atomic_load_n(&log->write_end, __ATOMIC_RELAXED);
+    return write_end - cursor <= log->capacity;
+}
+
+// 링과 eventfd 를 함께 생성
+int ipc_channel_open(IpcChannel* ch, size_t capacity) {
+    memset(ch, 0, sizeof(IpcChannel));
+    ch->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ch->efd < 0) {
+        return -1;
+    }
+    ch->ring = shm_ring_create(capacity);
+    if (ch->ring == NULL) {
+        close(ch->efd);
+        ch->efd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+// ring 이 NULL 이면 열리지 않은 채널이므로 무시
+void ipc_channel_close(IpcChannel* ch) {
+    if (ch->ring != NULL) {
+        close(ch->efd);
+        shm_ring_destroy(ch->ring);
+    }
+    memset(ch, 0, sizeof(IpcChannel));
+}
+
+// 생산자 : 링에 쓰기만 하고 알림은 ipc_channel_flush 에서 모아서 한 번 보냄 (여러 프레임을 연속으로 쓸 때)
+int ipc_channel_write(IpcChannel* ch, const void* data, size_t len) {
+    int was_empty = 0;
+    if (shm_ring_write(ch->ring, data, len, &was_empty) < 0) {
+        return -1;
+    }
+    if (was_empty) {
+        ch->pending_wakeup = 1;
+    }
+    return 0;
+}
+
+// 생산자 : 소비자가 잠들었을 수 있을 때만 eventfd 로 깨움 (소비자가 이미 읽는 중이면 syscall 생략)
+void ipc_channel_flush(IpcChannel* ch) {
+    if (ch->pending_wakeup) {
+        ch->pending_wakeup = 0;
+        eventfd_write(ch->efd, 1);
+    }
+}
+
+// chat-dev10 : 여러 구간을 하나의 레코드로 쓰기 (알림은 ipc_channel_flush)
+int ipc_channel_writev(IpcChannel* ch, const struct iovec* iov, int iovcnt) {
+    int was_empty = 0;
+    if (shm_ring_writev(ch->ring, iov, iovcnt, &was_empty) < 0) {
+        return -1;
+    }
+    if (was_empty) {
+        ch->pending_wakeup = 1;
+    }
+    return 0;
+}
+
+int ipc_channel_send(IpcChannel* ch, const void* data, size_t len) {
+    int ret = ipc_channel_write(ch, data, len);
+    ipc_channel_flush(ch);
+    return ret;
+}
+
+// 소비자 : 깨어난 뒤 eventfd 카운터를 비움 (non-blocking - 이미 비어 있어도 무시)
+void ipc_channel_clear_event(IpcChannel* ch) {
+    eventfd_t value;
+    eventfd_read(ch->efd, &value);
+}
@@ -0,0 +1,73 @@
+#ifndef IPC_RING_H
+#define IPC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// chat-dev8 : 부모/자식 프로세스 간 IPC 를 위한 공유 메모리 SPSC(단일 생산자/단일 소비자) 링 버퍼
+// => pipe write + kill(SIGUSR1/SIGUSR2) 대신 공유 메모리에 복사 1회 + (소비자가 잠들어 있을 때만) eventfd 알림 1회
+//    명령어 처리는 시그널 핸들러가 아닌 각 프로세스의 epoll 메인 루프에서 수행됨
+#define IPC_RING_SIZE (1 << 18) // 링 데이터 영역 크기 (2 의 거듭제곱, 최대 프레임보다 커야 함)
+
+// fork() 전에 MAP_SHARED 로 만들어 부모와 자식이 같은 물리 메모리를 보도록 함
+// head / tail 은 누적 바이트 수이며 서로 다른 캐시 라인에 두어 생산자/소비자 간 false sharing 방지
+typedef struct {
+    uint64_t head;        // 생산자가 쓴 누적 바이트 수
+    char pad0[56];
+    uint64_t tail;        // 소비자가 읽은 누적 바이트 수
+    char pad1[56];
+    uint64_t capacity;
+    char pad2[56];
+    char data[];
+} ShmRing;
+
+// 링 + 소비자 깨우기용 eventfd (프로세스마다 복사본을 가지는 핸들)
+typedef struct {
+    ShmRing* ring;
+    int efd;
+    int pending_wakeup; // 생산자 측 : 소비자가 비어 있는 링을 보고 잠들었을 수 있어 알림이 필요함
+} IpcChannel;
+
+ShmRing* shm_ring_create(size_t capacity);
+void shm_ring_destroy(ShmRing* r);
+size_t shm_ring_used(const ShmRing* r);
+int shm_ring_write(ShmRing* r, const void* data, size_t len, int* was_empty);
+int shm_ring_writev(ShmRing* r, const struct iovec* iov, int iovcnt, int* was_empty);
+int shm_ring_read(ShmRing* r, void* buf, size_t len);
+size_t shm_ring_peek(ShmRing* r, const char** p1, size_t* n1, const char** p2, size_t* n2);
+void shm_ring_consume(ShmRing* r, size_t n);
+
+// chat-dev9 : 채팅 채널(방) 단위 공유 메모리 append-only 메시지 로그 (단일 생산자 : 부모 / 다수 소비자 : 방 멤버 자식들)
+// => 부모는 브로드캐스트 메시지를 방 로그에 한 번만 쓰고, 각 자식은 자신의 읽기 위치(cursor) 부터 소켓으로 전달
+//    생산자는 소비자를 기다리지 않고 오래된 데이터를 덮어쓰며, 너무 뒤처진 소비자는 유실을 감지하고 최신 위치로 이동
+#define ROOM_LOG_SIZE (1 << 20) // 방 로그 데이터 영역 크기 (2 의 거듭제곱)
+
+typedef struct {
+    uint64_t head;        // 공개된(소비자가 읽어도 되는) 누적 바이트 수
+    char pad0[56];
+    uint64_t write_end;   // 쓰는 중인 영역의 끝 (덮어쓰기 전에 먼저 공개하여 소비자가 찢어진 데이터를 감지하도록 함)
+    char pad1[56];
+    uint64_t capacity;
+    char pad2[56];
+    char data[];
+} RoomLog;
+
+RoomLog* room_log_create(size_t capacity);
+void room_log_destroy(RoomLog* log);
+uint64_t room_log_head(const RoomLog* log);
+int room_log_append(RoomLog* log, const void* data, size_t len);
+ssize_t room_log_read(const RoomLog* log, uint64_t cursor, uint64_t limit, char* buf, size_t cap);
+ssize_t room_log_peek(const RoomLog* log, uint64_t cursor, uint64_t limit, const char** p1, size_t* n1, const char** p2, size_t* n2);
+int room_log_valid(const RoomLog* log, uint64_t cursor);
+
+int ipc_channel_open(IpcChannel* ch, size_t capacity);
+void ipc_channel_close(IpcChannel* ch);
+int ipc_channel_write(IpcChannel* ch, const void* data, size_t len);
+void ipc_channel_flush(IpcChannel* ch);
+int ipc_channel_writev(IpcChannel* ch, const struct iovec* iov, int iovcnt);
+int ipc_channel_send(IpcChannel* ch, const void* data, size_t len);
+void ipc_channel_clear_event(IpcChannel* ch);
+
+#endif
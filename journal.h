@@ -0,0 +1,82 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// chat-dev15 : 채팅 채널 개설/삭제와 채널 메시지를 기록하는 append-only 저널 (서버 재시작 후 채널 목록과 최근 메시지 복구)
+// => 저널 파일을 MAP_SHARED 로 매핑하고, 모든 서버 프로세스가 tail 을 CAS 로 예약한 자리에 레코드를 복사만 함 (write syscall 없음)
+//    저널은 절대 위치(lsn) 로 관리하는 원형 영역이며, 사용량이 절반을 넘으면 서버가 현재 상태를 스냅샷 파일로 쓰고
+//    스냅샷 이전 영역을 재사용함 (압축) - 시작할 때는 스냅샷을 읽고 그 이후 레코드만 재생
+//    레코드마다 lsn 과 체크섬을 두어, 비정상 종료로 끝까지 쓰이지 않은 레코드나 이전 바퀴의 레코드에서 재생을 멈춤
+#define JOURNAL_SIZE    (64 << 20) // 기본 저널 데이터 영역 크기
+#define JOURNAL_SYNC_MS 100        // batch 모드 기본 디스크 동기화 주기
+
+// 디스크 동기화 정책 (--journal-sync)
+#define JOURNAL_SYNC_OFF    0 // 커널 writeback 에 맡김
+#define JOURNAL_SYNC_BATCH  1 // 동기화 프로세스가 주기마다 fdatasync (주기 안의 레코드는 유실될 수 있음)
+#define JOURNAL_SYNC_ALWAYS 2 // 레코드마다 msync(MS_SYNC)
+
+// 레코드 종류
+#define JOURNAL_ROOM_ADD 1 // payload : 채널 이름
+#define JOURNAL_ROOM_RM  2 // payload 없음
+#define JOURNAL_MSG      3 // payload : 채널 메시지 프레임, entry : 채널 최근 메시지 번호
+
+// 저널 파일 앞부분 (한 페이지)
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;         // 데이터 영역 크기
+    uint64_t tail;         // 다음 레코드를 예약할 lsn
+    uint64_t snapshot_lsn; // 이 위치 이전 레코드는 스냅샷에 반영됨
+    uint32_t snapshotting; // 스냅샷 작성 중 (한 프로세스만 작성하도록 CAS)
+    uint32_t stop;         // 동기화 프로세스 종료 요청
+    uint64_t dropped;      // 저널이 가득 차서 버린 레코드 수
+} JournalHeader;
+
+typedef struct {
+    int fd;
+    JournalHeader* header;
+    char* data;
+    char path[256];
+    int sync_mode;
+    pid_t owner;  // journal_open 을 호출한 프로세스 (동기화 프로세스 관리, 종료 처리)
+    pid_t syncer; // batch 모드 동기화 프로세스
+} Journal;
+
+// 복구 시 재생 콜백 (스냅샷 내용도 같은 콜백으로 전달)
+typedef struct {
+    int (*room_add)(void* ctx, int room, const char* name);
+    void (*room_rm)(void* ctx, int room);
+    void (*msg)(void* ctx, int room, const char* frame, size_t len);
+} JournalReplay;
+
+typedef struct {
+    uint64_t snapshot_bytes;
+    uint64_t journal_bytes; // 스냅샷 이후 재생한 저널 바이트
+    uint64_t records;       // 재생한 저널 레코드 수
+    uint64_t messages;      // 복구한 채널 메시지 수 (스냅샷 포함)
+} JournalRecovery;
+
+// 스냅샷 작성 버퍼 (메모리에 모두 만든 뒤 임시 파일에 쓰고 rename)
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+    uint64_t lsn;
+    uint32_t rooms;
+} JournalSnapshot;
+
+int journal_open(Journal* j, const char* path, size_t size);
+int journal_recover(Journal* j, int max_rooms, const JournalReplay* replay, void* ctx, JournalRecovery* result);
+int journal_start(Journal* j, size_t size, int sync_mode, int sync_ms);
+int journal_append(Journal* j, int type, int room, uint64_t entry, const void* payload, size_t len);
+int journal_should_snapshot(const Journal* j);
+int journal_snapshot_begin(Journal* j, JournalSnapshot* s);
+void journal_snapshot_room(JournalSnapshot* s, int room, const char* name, uint64_t next_entry, uint32_t count, const char* frames, size_t len);
+int journal_snapshot_commit(Journal* j, JournalSnapshot* s);
+void journal_close(Journal* j);
+int journal_parse_sync(const char* name);
+
+#endif
@@ -0,0 +1,286 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <sys/eventfd.h>
+
+#include "log.h"
+
+#define LOG_BATCH 256 // flusher 가 writev 한 번에 모아 쓰는 최대 줄 수
+
+// 링 레코드 (seq : 레코드 상태 - 생산자가 쓸 차례면 pos, flusher 가 읽을 차례면 pos + 1)
+typedef struct {
+    uint64_t seq;
+    uint32_t len;
+    char text[LOG_RECORD_SIZE - 12];
+} LogRecord;
+
+// 여러 생산자(서버 프로세스들) / 단일 소비자(flusher) 링 - fork 전에 MAP_SHARED 로 만들어 모든 프로세스가 공유
+typedef struct {
+    uint64_t head;     // 생산자들이 CAS 로 차지하는 다음 레코드 위치
+    char pad0[56];
+    uint64_t tail;     // flusher 가 다음에 읽을 레코드 위치
+    char pad1[56];
+    uint64_t dropped;  // 링이 가득 차서 버린 줄 수 (생산자는 flusher 를 기다리지 않음)
+    int level;         // 기록할 최대 로그 레벨 (모든 프로세스 공용 - 실행 중 변경 가능)
+    int stop;          // 1 : 남은 줄을 모두 쓰고 flusher 종료
+    LogRecord records[LOG_RING_SLOTS];
+} LogRing;
+
+static LogRing* log_ring;
+static int log_efd = -1;       // 급한 줄(ERROR) 이나 링이 반 이상 찼을 때 flusher 를 깨우는 eventfd
+static pid_t log_flusher = -1;
+static pid_t log_owner = -1;   // log_init 을 호출한 프로세스 (log_shutdown 은 이 프로세스만 수행)
+static int log_level = LOG_INFO; // log_init 전 / 실패 시 사용
+
+// 프로세스별 초 단위 시간 문자열 캐시
+static time_t cached_sec = -1;
+static char cached_prefix[32];
+
+static const char* level_names[] = { "ERROR", "WARNING", "INFO" };
+
+// "[YYYY-MM-DD HH:MM:SS] " 형식 (같은 초 안에서는 캐시 사용)
+static const char* log_timestamp() {
+    time_t now = time(NULL);
+    if (now != cached_sec) {
+        struct tm t;
+        localtime_r(&now, &t);
+        strftime(cached_prefix, sizeof(cached_prefix), "[%Y-%m-%d %H:%M:%S] ", &t);
+        cached_sec = now;
+    }
+    return cached_prefix;
+}
+
+// "[시간] [레벨] : 메시지\n" 형식으로 dst 에 작성 (메시지 끝의 줄바꿈은 하나로 정리)
+static size_t log_format(char* dst, size_t cap, int level, const char* fmt, va_list ap) {
+    int n = snprintf(dst, cap, "%s[%s] : ", log_timestamp(), level_names[level]);
+    if (n < 0 || (size_t)n >= cap) {
+        return 0;
+    }
+    int m = vsnprintf(dst + n, cap - n, fmt, ap);
+    size_t len = n + (m < 0 ? 0 : ((size_t)m >= cap - n ? cap - n - 1 : (size_t)m));
+    while (len > 0 && dst[len - 1] == '\n') {
+        len--;
+    }
+    if (len == cap - 1) {
+        len--; // 잘린 줄도 줄바꿈으로 끝나도록 자리 확보
+    }
+    dst[len++] = '\n';
+    return len;
+}
+
+// iov 를 모두 쓸 때까지 writev 반복
+static void log_writev_all(struct iovec* iov, int cnt) {
+    while (cnt > 0) {
+        ssize_t n = writev(STDOUT_FILENO, iov, cnt);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        while (cnt > 0 && (size_t)n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            cnt--;
+        }
+        if (cnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+}
+
+// flusher : 완성된 레코드를 LOG_BATCH 개씩 writev 로 쓰고 생산자에게 반환
+static void log_drain() {
+    struct iovec iov[LOG_BATCH + 1];
+    while (1) {
+        uint64_t pos = log_ring->tail;
+        int cnt = 0;
+        while (cnt < LOG_BATCH) {
+            LogRecord* rec = &log_ring->records[(pos + cnt) & (LOG_RING_SLOTS - 1)];
+            if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != pos + cnt + 1) {
+                break; // 아직 쓰는 중이거나 비어 있음
+            }
+            iov[cnt].iov_base = rec->text;
+            iov[cnt].iov_len = rec->len;
+            cnt++;
+        }
+
+        // 링이 가득 차서 버린 줄이 있으면 함께 알림
+        char lost[128];
+        uint64_t dropped = __atomic_exchange_n(&log_ring->dropped, 0, __ATOMIC_RELAXED);
+        int total = cnt;
+        if (dropped > 0) {
+            int n = snprintf(lost, sizeof(lost), "%s[WARNING] : 로그 링이 가득 차서 로그 %llu 줄을 버렸습니다.\n",
+                             log_timestamp(), (unsigned long long)dropped);
+            iov[total].iov_base = lost;
+            iov[total].iov_len = n;
+            total++;
+        }
+        if (total == 0) {
+            return;
+        }
+        log_writev_all(iov, total);
+
+        // 다 쓴 레코드를 다음 바퀴의 생산자에게 반환
+        for (int k = 0; k < cnt; k++) {
+            LogRecord* rec = &log_ring->records[(pos + k) & (LOG_RING_SLOTS - 1)];
+            __atomic_store_n(&rec->seq, pos + k + LOG_RING_SLOTS, __ATOMIC_RELEASE);
+        }
+        __atomic_store_n(&log_ring->tail, pos + cnt, __ATOMIC_RELEASE);
+        if (cnt < LOG_BATCH) {
+            return;
+        }
+    }
+}
+
+// flusher 프로세스 본체 : flush 주기마다(또는 깨워질 때) 링을 비움
+// 종료 : log_shutdown 의 stop 요청, 또는 로그를 쓰던 서버 프로세스가 사라졌을 때 (남은 줄을 모두 쓰고 종료)
+static void log_flusher_main(int flush_ms) {
+    // 서버 종료 시그널(pkill 등) 은 무시하고 log_owner 의 log_shutdown 으로만 종료하여 마지막 로그까지 씀
+    signal(SIGINT, SIG_IGN);
+    signal(SIGTERM, SIG_IGN);
+    signal(SIGHUP, SIG_IGN);
+
+    struct pollfd pfd;
+    pfd.fd = log_efd;
+    pfd.events = POLLIN;
+    while (1) {
+        if (poll(&pfd, 1, flush_ms) > 0) {
+            eventfd_t value;
+            eventfd_read(log_efd, &value);
+        }
+        log_drain();
+        if (__atomic_load_n(&log_ring->stop, __ATOMIC_ACQUIRE) || getppid() != log_owner) {
+            log_drain();
+            break;
+        }
+    }
+    _exit(0);
+}
+
+// 로그 링 생성 및 flusher 프로세스 시작 (stdout 을 로그 파일로 리디렉션한 뒤, 다른 프로세스를 fork 하기 전에 호출)
+// 실패 시 -1 (log_write 는 기존처럼 줄마다 바로 씀)
+int log_init(int level, int flush_ms) {
+    log_level = level;
+    LogRing* ring = mmap(NULL, sizeof(LogRing), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        return -1;
+    }
+    for (int i = 0; i < LOG_RING_SLOTS; i++) {
+        ring->records[i].seq = i;
+    }
+    ring->level = level;
+    log_efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (log_efd < 0) {
+        munmap(ring, sizeof(LogRing));
+        return -1;
+    }
+    log_ring = ring;
+    log_owner = getpid();
+
+    log_flusher = fork();
+    if (log_flusher < 0) {
+        log_ring = NULL;
+        munmap(ring, sizeof(LogRing));
+        close(log_efd);
+        log_efd = -1;
+        return -1;
+    }
+    if (log_flusher == 0) {
+        log_flusher_main(flush_ms > 0 ? flush_ms : LOG_FLUSH_MS);
+    }
+    return 0;
+}
+
+// 로그 한 줄 기록 - 링의 레코드 하나를 CAS 로 차지해 복사만 하고 syscall 없이 반환
+// (ERROR 이거나 링이 반 이상 찼을 때만 eventfd 로 flusher 를 깨움)
+void log_write(int level, const char* fmt, ...) {
+    va_list ap;
+    if (log_ring == NULL) {
+        if (level > log_level) {
+            return;
+        }
+        char line[LOG_RECORD_SIZE];
+        va_start(ap, fmt);
+        size_t len = log_format(line, sizeof(line), level, fmt, ap);
+        va_end(ap);
+        write(STDOUT_FILENO, line, len);
+        return;
+    }
+    if (level > __atomic_load_n(&log_ring->level, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    uint64_t pos = __atomic_load_n(&log_ring->head, __ATOMIC_RELAXED);
+    LogRecord* rec;
+    while (1) {
+        rec = &log_ring->records[pos & (LOG_RING_SLOTS - 1)];
+        uint64_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&log_ring->head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break; // 레코드 차지 (실패 시 pos 는 최신 head 로 갱신됨)
+            }
+        } else if (diff < 0) {
+            // 링이 가득 참 - 메시지 처리가 멈추지 않도록 버리고 flusher 를 깨움
+            __atomic_add_fetch(&log_ring->dropped, 1, __ATOMIC_RELAXED);
+            eventfd_write(log_efd, 1);
+            return;
+        } else {
+            pos = __atomic_load_n(&log_ring->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    va_start(ap, fmt);
+    rec->len = log_format(rec->text, sizeof(rec->text), level, fmt, ap);
+    va_end(ap);
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+
+    if (level == LOG_ERROR || pos - __atomic_load_n(&log_ring->tail, __ATOMIC_RELAXED) >= LOG_RING_SLOTS / 2) {
+        eventfd_write(log_efd, 1);
+    }
+}
+
+// 기록할 최대 로그 레벨 변경 (모든 프로세스에 바로 반영)
+void log_set_level(int level) {
+    log_level = level;
+    if (log_ring != NULL) {
+        __atomic_store_n(&log_ring->level, level, __ATOMIC_RELAXED);
+    }
+}
+
+// "error" / "warning" / "info" → 로그 레벨 (-1 : 잘못된 이름)
+int log_parse_level(const char* name) {
+    if (strcmp(name, "error") == 0) {
+        return LOG_ERROR;
+    }
+    if (strcmp(name, "warning") == 0) {
+        return LOG_WARNING;
+    }
+    if (strcmp(name, "info") == 0) {
+        return LOG_INFO;
+    }
+    return -1;
+}
+
+// 남은 로그를 모두 쓰고 flusher 종료 (log_init 을 호출한 프로세스에서만 동작)
+void log_shutdown() {
+    if (log_ring == NULL || getpid() != log_owner || log_flusher <= 0) {
+        return;
+    }
+    __atomic_store_n(&log_ring->stop, 1, __ATOMIC_RELEASE);
+    eventfd_write(log_efd, 1);
+    waitpid(log_flusher, NULL, 0);
+    log_flusher = -1;
+}
@@ -0,0 +1,24 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <sys/types.h>
+
+// chat-dev12 : 비동기 일괄 로그 (메시지 처리 경로에서 로그 파일 write syscall 제거)
+// => 모든 서버 프로세스(fork 모드 부모/자식, workers 모드 worker) 가 공유 메모리 MPSC 링에 로그 한 줄을 복사만 하고,
+//    로그 전용 프로세스(flusher) 가 flush 주기마다 쌓인 줄을 writev 한 번으로 로그 파일(stdout) 에 씀
+//    시간 문자열은 프로세스마다 초 단위로 캐시하여 localtime + strftime 을 초당 한 번만 수행
+#define LOG_ERROR   0
+#define LOG_WARNING 1
+#define LOG_INFO    2
+
+#define LOG_RING_SLOTS  4096 // 링 레코드 수 (2 의 거듭제곱)
+#define LOG_RECORD_SIZE 1024 // 레코드 한 개 크기 (로그 한 줄이 더 길면 잘림)
+#define LOG_FLUSH_MS    100  // 기본 flush 주기
+
+int log_init(int level, int flush_ms);
+void log_write(int level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+void log_set_level(int level);
+int log_parse_level(const char* name);
+void log_shutdown();
+
+#endif
@@ -0,0 +1,171 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "lz.h"
+
+static uint32_t lz_read32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static uint32_t lz_hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// 길이 n 이 토큰 4 비트(15) 를 넘으면 나머지를 255 단위 바이트로 이어서 씀
+static unsigned char* lz_put_length(unsigned char* op, size_t n) {
+    while (n >= 255) {
+        *op++ = 255;
+        n -= 255;
+    }
+    *op++ = (unsigned char)n;
+    return op;
+}
+
+// 압축 결과 최대 크기 (압축되지 않는 입력)
+size_t lz_bound(size_t n) {
+    return n + n / 255 + 16;
+}
+
+// 시퀀스 한 개(리터럴 lit 바이트 + 일치 길이 match, 거리 offset) 를 씀 - match 0 : 마지막 시퀀스 (리터럴만)
+// 반환 : 다음 쓸 위치 (NULL : 공간 부족)
+static unsigned char* lz_put_sequence(unsigned char* op, unsigned char* oend, const unsigned char* lit, size_t lit_len,
+                                      size_t match, size_t offset) {
+    if ((size_t)(oend - op) < 1 + lit_len / 255 + 1 + lit_len + 2 + (match / 255 + 1)) {
+        return NULL;
+    }
+    unsigned char* token = op++;
+    *token = (unsigned char)((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15) {
+        op = lz_put_length(op, lit_len - 15);
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+    if (match == 0) {
+        return op;
+    }
+    *op++ = (unsigned char)(offset & 0xff);
+    *op++ = (unsigned char)(offset >> 8);
+    size_t ml = match - LZ_MIN_MATCH;
+    *token |= (unsigned char)(ml >= 15 ? 15 : ml);
+    if (ml >= 15) {
+        op = lz_put_length(op, ml - 15);
+    }
+    return op;
+}
+
+// src n 바이트를 dst 에 압축
+// 반환 : 압축한 크기 (0 : cap 안에 들어가지 않음 - 호출하는 쪽에서 원본을 그대로 사용)
+size_t lz_compress(const char* src_, size_t n, char* dst_, size_t cap) {
+    const unsigned char* src = (const unsigned char*)src_;
+    unsigned char* op = (unsigned char*)dst_;
+    unsigned char* oend = op + cap;
+    size_t anchor = 0;
+    int32_t table[1 << LZ_HASH_BITS];
+
+    if (n >= LZ_MFLIMIT + 1) {
+        memset(table, 0xff, sizeof(table)); // -1 : 빈 칸
+        size_t limit = n - LZ_MFLIMIT;
+        size_t match_limit = n - LZ_LAST_LITERALS;
+        size_t ip = 0;
+        while (ip < limit) {
+            uint32_t seq = lz_read32(src + ip);
+            uint32_t h = lz_hash(seq);
+            int32_t ref = table[h];
+            table[h] = (int32_t)ip;
+            if (ref < 0 || ip - ref > LZ_MAX_OFFSET || lz_read32(src + ref) != seq) {
+                ip++;
+                continue;
+            }
+            // 일치를 앞쪽(리터럴 쪽) 과 뒤쪽으로 늘림
+            size_t r = ref;
+            while (ip > anchor && r > 0 && src[ip - 1] == src[r - 1]) {
+                ip--;
+                r--;
+            }
+            size_t match = LZ_MIN_MATCH;
+            while (ip + match < match_limit && src[ip + match] == src[r + match]) {
+                match++;
+            }
+            op = lz_put_sequence(op, oend, src + anchor, ip - anchor, match, ip - r);
+            if (op == NULL) {
+                return 0;
+            }
+            ip += match;
+            anchor = ip;
+            if (ip - 2 < limit) {
+                table[lz_hash(lz_read32(src + ip - 2))] = (int32_t)(ip - 2);
+            }
+        }
+    }
+    op = lz_put_sequence(op, oend, src + anchor, n - anchor, 0, 0);
+    return op == NULL ? 0 : (size_t)(op - (unsigned char*)dst_);
+}
+
+// 압축 블록 src n 바이트를 dst 에 해제 (잘못된 입력이어도 dst cap 밖을 읽거나 쓰지 않음)
+// 반환 : 해제한 크기, -1 잘못된 블록 또는 cap 부족
+long lz_decompress(const char* src_, size_t n, char* dst_, size_t cap) {
+    const unsigned char* ip = (const unsigned char*)src_;
+    const unsigned char* iend = ip + n;
+    unsigned char* dst = (unsigned char*)dst_;
+    unsigned char* op = dst;
+    unsigned char* oend = dst + cap;
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+        size_t lit = token >> 4;
+        if (lit == 15) {
+            unsigned b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                lit += b;
+            } while (b == 255);
+        }
+        if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) {
+            return -1;
+        }
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == iend) {
+            break; // 마지막 시퀀스 (리터럴만)
+        }
+        if (iend - ip < 2) {
+            return -1;
+        }
+        size_t offset = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) {
+            return -1;
+        }
+        size_t match = token & 15;
+        if (match == 15) {
+            unsigned b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                match += b;
+            } while (b == 255);
+        }
+        match += LZ_MIN_MATCH;
+        if ((size_t)(oend - op) < match) {
+            return -1;
+        }
+        const unsigned char* from = op - offset;
+        if (offset >= match) {
+            memcpy(op, from, match);
+        } else {
+            for (size_t i = 0; i < match; i++) { // 겹치는 일치 (반복 패턴)
+                op[i] = from[i];
+            }
+        }
+        op += match;
+    }
+    return (long)(op - dst);
+}
@@ -0,0 +1,20 @@
+#ifndef LZ_H
+#define LZ_H
+
+#include <stddef.h>
+
+// chat-dev22 : LZ4 블록 형식 호환 압축기 (외부 라이브러리 없이 트리에 포함)
+// => 채팅 메시지, /USER all, /LIST all 응답처럼 반복이 많은 텍스트를 빠르게 압축 / 해제 (엔트로피 코딩 없이 LZ77 일치만 사용)
+//    블록 한 개 = (토큰 [리터럴 길이 | 일치 길이], 리터럴, 일치 거리 2바이트) 시퀀스 반복, 마지막 시퀀스는 리터럴만
+//    압축기는 4바이트 해시 테이블 한 개로 직전 위치만 기억하는 greedy 방식 (LZ4 기본 압축 수준과 같은 방식)
+#define LZ_HASH_BITS    12
+#define LZ_MIN_MATCH    4
+#define LZ_LAST_LITERALS 5   // 블록 끝 5 바이트는 항상 리터럴
+#define LZ_MFLIMIT      12   // 블록 끝 12 바이트 안에서는 일치를 시작하지 않음
+#define LZ_MAX_OFFSET   65535
+
+size_t lz_bound(size_t n);
+size_t lz_compress(const char* src, size_t n, char* dst, size_t cap);
+long lz_decompress(const char* src, size_t n, char* dst, size_t cap);
+
+#endif
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "protocol.h"
+#include "msgbuf.h"
+
+// chat-dev24 : 크기 등급 (data 크기) - 채팅 메시지, 명령어 응답, 긴 메시지, 목록 응답, 최대 프레임 (최근 메시지 재전송 포함)
+static const size_t msgbuf_class_size[MSGBUF_CLASSES] = {
+    256, 1024, 4096, 16384, FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD
+};
+
+static MsgBuf* msgbuf_free_list[MSGBUF_CLASSES];
+static MsgBufStats* msgbuf_stats;
+static MsgBufStats msgbuf_local_stats; // msgbuf_pool_init 전 (벤치마크 등) 에는 프로세스 안에서만 셈
+
+static void msgbuf_count(uint64_t* counter, uint64_t n) {
+    __atomic_add_fetch(counter, n, __ATOMIC_RELAXED);
+}
+
+// 지표를 stats(공유 메모리) 에 기록하도록 설정 (NULL : 프로세스 안에서만 셈)
+void msgbuf_pool_init(MsgBufStats* stats) {
+    msgbuf_stats = stats != NULL ? stats : &msgbuf_local_stats;
+}
+
+static size_t msgbuf_stride(int cls) {
+    return (sizeof(MsgBuf) + msgbuf_class_size[cls] + 15) & ~(size_t)15;
+}
+
+// cls 등급 slab 하나를 새로 만들어 버퍼들을 빈 목록에 넣음 (반환 -1 : 메모리 부족)
+static int msgbuf_grow(int cls) {
+    size_t stride = msgbuf_stride(cls);
+    size_t count = MSGBUF_SLAB_BYTES / stride;
+    if (count == 0) {
+        count = 1;
+    }
+    char* slab = malloc(stride * count);
+    if (slab == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < count; k++) {
+        MsgBuf* b = (MsgBuf*)(slab + k * stride);
+        b->cls = cls;
+        b->next = msgbuf_free_list[cls];
+        msgbuf_free_list[cls] = b;
+    }
+    msgbuf_count(&msgbuf_stats->slab_bytes, stride * count);
+    return 0;
+}
+
+// size 바이트를 쓸 수 있는 버퍼 할당 (참조 1, len 0) - 반환 NULL : 메모리 부족
+MsgBuf* msgbuf_alloc(size_t size) {
+    if (msgbuf_stats == NULL) {
+        msgbuf_pool_init(NULL);
+    }
+    int cls = 0;
+    while (cls < MSGBUF_CLASSES && msgbuf_class_size[cls] < size) {
+        cls++;
+    }
+    MsgBuf* b;
+    if (cls == MSGBUF_CLASSES) {
+        b = malloc(sizeof(MsgBuf) + size);
+        if (b == NULL) {
+            return NULL;
+        }
+        b->cls = MSGBUF_CLASSES;
+        msgbuf_count(&msgbuf_stats->oversize, 1);
+    } else {
+        if (msgbuf_free_list[cls] != NULL) {
+            msgbuf_count(&msgbuf_stats->hits, 1);
+        } else if (msgbuf_grow(cls) < 0) {
+            return NULL;
+        }
+        b = msgbuf_free_list[cls];
+        msgbuf_free_list[cls] = b->next;
+    }
+    b->next = NULL;
+    b->refs = 1;
+    b->size = size;
+    b->len = 0;
+    msgbuf_count(&msgbuf_stats->allocs, 1);
+    msgbuf_count(&msgbuf_stats->inflight_bytes, size);
+    return b;
+}
+
+// data 를 복사한 버퍼 할당
+MsgBuf* msgbuf_copy(const char* data, size_t len) {
+    MsgBuf* b = msgbuf_alloc(len);
+    if (b != NULL) {
+        memcpy(b->data, data, len);
+        b->len = len;
+    }
+    return b;
+}
+
+// 참조 하나 추가 (같은 바이트를 다른 송신 큐에서도 보냄)
+MsgBuf* msgbuf_ref(MsgBuf* b) {
+    b->refs++;
+    msgbuf_count(&msgbuf_stats->refs, 1);
+    return b;
+}
+
+// 참조 하나 놓기 (마지막 참조면 빈 목록에 돌려줌)
+void msgbuf_release(MsgBuf* b) {
+    if (b == NULL || --b->refs > 0) {
+        return;
+    }
+    msgbuf_count(&msgbuf_stats->inflight_bytes, -(uint64_t)b->size);
+    if (b->cls == MSGBUF_CLASSES) {
+        free(b);
+        return;
+    }
+    b->next = msgbuf_free_list[b->cls];
+    msgbuf_free_list[b->cls] = b;
+}
@@ -0,0 +1,41 @@
+#ifndef MSGBUF_H
+#define MSGBUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// chat-dev24 : 참조 카운트 메시지 버퍼 풀 (epoll / workers 모드 송신 큐, 명령어 응답 인코딩)
+// => 인코딩한 프레임을 한 번만 버퍼에 쓰고, 받는 클라이언트의 송신 큐마다 바이트를 복사하는 대신 참조만 하나씩 늘림
+//    마지막 참조(마지막으로 전송을 끝낸 송신 큐) 가 놓을 때 버퍼를 크기 등급별 빈 목록에 돌려주어 다음 할당에서 재사용
+//    버퍼는 등급별 slab(MSGBUF_SLAB_BYTES) 을 잘라서 만들고 slab 은 운영체제에 돌려주지 않음 (최대 사용량만큼 유지)
+//    가장 큰 등급보다 큰 버퍼는 풀 밖에서 malloc / free
+//    풀과 참조 카운트는 프로세스 안에서만 쓰므로 atomic 이 아님 (지표만 공유 메모리에 atomic 으로 더함)
+#define MSGBUF_CLASSES    5
+#define MSGBUF_SLAB_BYTES (1 << 16) // 등급별 slab 크기 (버퍼 하나가 이보다 크면 slab 하나에 버퍼 하나)
+
+// 풀 지표 (stats.h 의 ServerStats 에 포함 - 모든 프로세스가 atomic 으로 더함)
+typedef struct {
+    uint64_t allocs;         // 할당한 버퍼 수
+    uint64_t hits;           // 빈 목록의 버퍼를 재사용한 할당 수 (나머지 : slab 을 새로 자르거나 풀 밖 malloc)
+    uint64_t oversize;       // 가장 큰 등급보다 커서 풀 밖에서 할당한 수
+    uint64_t refs;           // 송신 큐 등이 추가로 잡은 참조 수 (할당 수보다 많은 만큼 복사 없이 공유)
+    uint64_t slab_bytes;     // 만든 slab 바이트 (게이지)
+    uint64_t inflight_bytes; // 참조가 남아 있는 (전달이 끝나지 않은) 버퍼의 요청 크기 합 (게이지)
+} MsgBufStats;
+
+typedef struct MsgBuf {
+    struct MsgBuf* next; // 빈 목록
+    uint32_t refs;
+    uint32_t cls;        // 크기 등급 (MSGBUF_CLASSES : 풀 밖 할당)
+    size_t size;         // 할당 요청 크기 (data 에 쓸 수 있는 바이트)
+    size_t len;          // 쓴 바이트
+    char data[];
+} MsgBuf;
+
+void msgbuf_pool_init(MsgBufStats* stats);
+MsgBuf* msgbuf_alloc(size_t size);
+MsgBuf* msgbuf_copy(const char* data, size_t len);
+MsgBuf* msgbuf_ref(MsgBuf* b);
+void msgbuf_release(MsgBuf* b);
+
+#endif
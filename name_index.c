@@ -0,0 +1,97 @@
+#include <string.h>
+
+#include "name_index.h"
+
+// FNV-1a 32비트 해시 (chat-dev23 : 이름 앞 len 바이트)
+static uint32_t name_hash(const char* name, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t k = 0; k < len; k++) {
+        h ^= (unsigned char)name[k];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// chat-dev23 : 등록된 이름 key 가 name 앞 len 바이트와 같은지 (name 은 NUL 종료가 아니어도 됨)
+static int name_equal(const char* key, const char* name, size_t len) {
+    return strncmp(key, name, len) == 0 && key[len] == '\0';
+}
+
+void name_index_init(NameIndex* idx, NameIndexEntry* entries, uint32_t capacity, NameIndexKeyFn key_of) {
+    idx->entries = entries;
+    idx->capacity = capacity;
+    idx->count = 0;
+    idx->key_of = key_of;
+    for (uint32_t i = 0; i < capacity; i++) {
+        entries[i].hash = 0;
+        entries[i].value = NAME_INDEX_EMPTY;
+    }
+}
+
+// name 이 있는 칸 또는 name 을 넣을 빈 칸의 위치
+static uint32_t name_index_probe(const NameIndex* idx, const char* name, size_t len, uint32_t hash) {
+    uint32_t pos = hash % idx->capacity;
+    while (idx->entries[pos].value != NAME_INDEX_EMPTY) {
+        if (idx->entries[pos].hash == hash && name_equal(idx->key_of(idx->entries[pos].value), name, len)) {
+            break;
+        }
+        pos = (pos + 1) % idx->capacity;
+    }
+    return pos;
+}
+
+// 반환 : name 을 가진 슬롯 번호, 없으면 NAME_INDEX_EMPTY
+int name_index_find(const NameIndex* idx, const char* name) {
+    return name_index_find_n(idx, name, strlen(name));
+}
+
+// chat-dev23 : 명령어 payload 안의 이름 구간(name, len) 을 복사 없이 조회
+int name_index_find_n(const NameIndex* idx, const char* name, size_t len) {
+    return idx->entries[name_index_probe(idx, name, len, name_hash(name, len))].value;
+}
+
+// name → value 등록 (name 은 value 슬롯에 이미 기록된 이름이어야 함)
+// 반환 : 0 성공, -1 이미 등록된 이름이거나 인덱스가 가득 참
+int name_index_insert(NameIndex* idx, const char* name, int value) {
+    if (idx->count + 1 >= idx->capacity) {
+        return -1; // 빈 칸이 최소 하나는 남아 있어야 조회가 끝남
+    }
+    size_t len = strlen(name);
+    uint32_t hash = name_hash(name, len);
+    uint32_t pos = name_index_probe(idx, name, len, hash);
+    if (idx->entries[pos].value != NAME_INDEX_EMPTY) {
+        return -1;
+    }
+    idx->entries[pos].hash = hash;
+    idx->entries[pos].value = value;
+    idx->count++;
+    return 0;
+}
+
+// name 이 value 슬롯으로 등록되어 있을 때만 삭제 (다른 슬롯이 같은 이름을 가진 경우 보호)
+// 반환 : 0 삭제, -1 없음
+int name_index_remove(NameIndex* idx, const char* name, int value) {
+    size_t len = strlen(name);
+    uint32_t pos = name_index_probe(idx, name, len, name_hash(name, len));
+    if (idx->entries[pos].value == NAME_INDEX_EMPTY || idx->entries[pos].value != value) {
+        return -1;
+    }
+
+    // backward shift : 빈 칸 뒤에서 원래 자리(home) 로 가는 길이 빈 칸을 지나는 항목을 당겨 채움
+    uint32_t hole = pos;
+    uint32_t next = (hole + 1) % idx->capacity;
+    while (idx->entries[next].value != NAME_INDEX_EMPTY) {
+        uint32_t home = idx->entries[next].hash % idx->capacity;
+        // home 이 (hole, next] 구간 밖이면 hole 로 옮겨도 조회 경로가 유지됨
+        int in_range = (hole <= next) ? (home > hole && home <= next) : (home > hole || home <= next);
+        if (!in_range) {
+            idx->entries[hole] = idx->entries[next];
+            hole = next;
+        }
+        next = (next + 1) % idx->capacity;
+    }
+    idx->entries[hole].hash = 0;
+    idx->entries[hole].value = NAME_INDEX_EMPTY;
+    idx->count--;
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// chat-dev11 : 이름(닉네임 등) → 슬롯 번호 open addressing 해시 인덱스 (linear probing)
+// => 이름 문자열은 인덱스에 복사하지 않고 슬롯 번호만 저장하며, 비교할 이름은 key_of(슬롯) 로 원본 배열에서 가져옴
+//    삭제 시 tombstone 없이 뒤따르는 항목을 당겨와(backward shift) 조회 길이가 늘어나지 않도록 함
+//    entries 는 호출하는 쪽이 제공 (workers 모드는 공유 메모리에 두어 모든 worker 가 같은 인덱스를 사용)
+#define NAME_INDEX_EMPTY (-1)
+
+typedef struct {
+    uint32_t hash;  // 이름 해시 (재해시 없이 비교/이동에 사용)
+    int32_t value;  // 슬롯 번호 (NAME_INDEX_EMPTY : 빈 칸)
+} NameIndexEntry;
+
+typedef const char* (*NameIndexKeyFn)(int value);
+
+typedef struct {
+    NameIndexEntry* entries;
+    uint32_t capacity;  // 항목 최대 수보다 충분히 크게 (load factor 0.5 이하 권장)
+    uint32_t count;
+    NameIndexKeyFn key_of;
+} NameIndex;
+
+void name_index_init(NameIndex* idx, NameIndexEntry* entries, uint32_t capacity, NameIndexKeyFn key_of);
+int name_index_find(const NameIndex* idx, const char* name);
+int name_index_find_n(const NameIndex* idx, const char* name, size_t len);
+int name_index_insert(NameIndex* idx, const char* name, int value);
+int name_index_remove(NameIndex* idx, const char* name, int value);
+
+#endif
@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+#include <arpa/inet.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#include "protocol.h"
+#include "lz.h" // chat-dev22 : 압축 프레임
+
+// chat-dev7 : 명령어 바이트 ↔ 명령어 이름 변환 테이블 (로그 출력, 클라이언트 입력 파싱에 사용)
+static const char* cmd_names[CMD_MAX] = {
+    [CMD_NONE] = "NONE",
+    [CMD_NICK] = "NICK",
+    [CMD_MSG] = "MSG",
+    [CMD_ADD] = "ADD",
+    [CMD_LEAVE] = "LEAVE",
+    [CMD_RM] = "RM",
+    [CMD_USER] = "USER",
+    [CMD_LIST] = "LIST",
+    [CMD_JOIN] = "JOIN",
+    [CMD_WHISPER] = "WHISPER",
+    [CMD_QUIT] = "QUIT",
+    [CMD_ERROR] = "ERROR",
+    [CMD_STATS] = "STATS",
+    [CMD_HISTORY] = "HISTORY",
+    [CMD_CAPS] = "CAPS",
+    [CMD_PING] = "PING",
+    [CMD_PONG] = "PONG",
+};
+
+const char* frame_cmd_name(int cmd) {
+    if (cmd <= CMD_NONE || cmd >= CMD_MAX) {
+        return "NONE";
+    }
+    return cmd_names[cmd];
+}
+
+// 명령어 이름(길이 len) 을 명령어 바이트로 변환, 없는 명령어면 CMD_NONE
+int frame_cmd_from_name(const char* name, size_t len) {
+    for (int cmd = CMD_NONE + 1; cmd < CMD_MAX; cmd++) {
+        if (strlen(cmd_names[cmd]) == len && memcmp(cmd_names[cmd], name, len) == 0) {
+            return cmd;
+        }
+    }
+    return CMD_NONE;
+}
+
+// 헤더 5바이트 작성 (chat-dev23 : payload 를 dst 뒤에 직접 쓴 경우에도 사용)
+void frame_put_header(char* dst, int cmd, size_t len) {
+    uint32_t be_len = htonl((uint32_t)len);
+    memcpy(dst, &be_len, 4);
+    dst[4] = (char)cmd;
+}
+
+// dst 에 프레임 한 개를 작성하고 전체 바이트 수 반환 (cap 부족 또는 payload 초과 시 0)
+size_t frame_encode(char* dst, size_t cap, int cmd, const char* payload, size_t len) {
+    if (len > FRAME_MAX_PAYLOAD || cap < FRAME_HEADER_SIZE + len) {
+        return 0;
+    }
+    frame_put_header(dst, cmd, len);
+    memcpy(dst + FRAME_HEADER_SIZE, payload, len);
+    return FRAME_HEADER_SIZE + len;
+}
+
+// fd 에 프레임 한 개를 모두 쓸 때까지 전송 (헤더와 payload 를 writev 로 묶어 복사 없이 전송)
+// 반환 : 0 성공, -1 실패
+int frame_write(int fd, int cmd, const char* payload, size_t len) {
+    char header[FRAME_HEADER_SIZE];
+    if (len > FRAME_MAX_PAYLOAD) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+    frame_put_header(header, cmd, len);
+
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = FRAME_HEADER_SIZE;
+    iov[1].iov_base = (void*)payload;
+    iov[1].iov_len = len;
+    int iovcnt = 2;
+    struct iovec* cur = iov;
+
+    while (iovcnt > 0) {
+        ssize_t n = writev(fd, cur, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        // 부분 전송된 만큼 iovec 을 앞으로 이동
+        while (iovcnt > 0 && (size_t)n >= cur->iov_len) {
+            n -= cur->iov_len;
+            cur++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            cur->iov_base = (char*)cur->iov_base + n;
+            cur->iov_len -= n;
+        }
+    }
+    return 0;
+}
+
+// chat-dev22 : 인코딩된 프레임(frame, len) 을 압축 프레임으로 dst 에 작성
+// 반환 : 압축 프레임 전체 바이트 수 (0 : 원본보다 1/8 이상 줄지 않아 원본을 그대로 보내는 편이 나음)
+size_t frame_compress(char* dst, size_t cap, const char* frame, size_t len) {
+    if (len <= FRAME_HEADER_SIZE || (frame[4] & FRAME_FLAG_LZ)) {
+        return 0;
+    }
+    size_t plain = len - FRAME_HEADER_SIZE;
+    size_t limit = len - len / 8; // 이 크기보다 커지면 압축하지 않음
+    if (limit > cap) {
+        limit = cap;
+    }
+    if (limit <= FRAME_HEADER_SIZE + FRAME_LZ_HEADER) {
+        return 0;
+    }
+    size_t n = lz_compress(frame + FRAME_HEADER_SIZE, plain, dst + FRAME_HEADER_SIZE + FRAME_LZ_HEADER,
+                           limit - FRAME_HEADER_SIZE - FRAME_LZ_HEADER);
+    if (n == 0) {
+        return 0;
+    }
+    uint32_t be_plain = htonl((uint32_t)plain);
+    memcpy(dst + FRAME_HEADER_SIZE, &be_plain, 4);
+    frame_put_header(dst, FRAME_CMD(frame[4]) | FRAME_FLAG_LZ, FRAME_LZ_HEADER + n);
+    return FRAME_HEADER_SIZE + FRAME_LZ_HEADER + n;
+}
+
+// chat-dev22 : 압축 프레임(frame, len) 을 원본 프레임으로 dst 에 풀어 씀
+// 반환 : 원본 프레임 전체 바이트 수, -1 잘못된 압축 프레임 또는 cap 부족
+long frame_decompress(char* dst, size_t cap, const char* frame, size_t len) {
+    if (len < FRAME_HEADER_SIZE + FRAME_LZ_HEADER || !(frame[4] & FRAME_FLAG_LZ)) {
+        return -1;
+    }
+    uint32_t be_plain;
+    memcpy(&be_plain, frame + FRAME_HEADER_SIZE, 4);
+    size_t plain = ntohl(be_plain);
+    if (plain > FRAME_MAX_PAYLOAD || cap < FRAME_HEADER_SIZE + plain) {
+        return -1;
+    }
+    long n = lz_decompress(frame + FRAME_HEADER_SIZE + FRAME_LZ_HEADER, len - FRAME_HEADER_SIZE - FRAME_LZ_HEADER,
+                           dst + FRAME_HEADER_SIZE, plain);
+    if (n != (long)plain) {
+        return -1;
+    }
+    frame_put_header(dst, FRAME_CMD(frame[4]), plain);
+    return FRAME_HEADER_SIZE + plain;
+}
+
+void frame_decoder_init(FrameDecoder* d) {
+    memset(d, 0, sizeof(FrameDecoder));
+}
+
+void frame_decoder_free(FrameDecoder* d) {
+    free(d->buf);
+    free(d->inflate);
+    memset(d, 0, sizeof(FrameDecoder));
+}
+
+// 이전 frame_decoder_next 에서 NUL 종료를 위해 덮어쓴 바이트 복원
+static void frame_decoder_restore(FrameDecoder* d) {
+    if (d->saved_at) {
+        d->buf[d->saved_at] = d->saved_byte;
+        d->saved_at = 0;
+    }
+}
+
+// 이미 꺼낸 프레임을 버퍼 앞에서 제거하고, 최소 want 바이트의 여유 공간 확보
+static int frame_decoder_reserve(FrameDecoder* d, size_t want) {
+    frame_decoder_restore(d);
+    if (d->pos > 0) {
+        memmove(d->buf, d->buf + d->pos, d->len - d->pos);
+        d->len -= d->pos;
+        d->pos = 0;
+    }
+    // +1 : 마지막 payload 뒤 NUL 종료 공간
+    if (d->len + want + 1 > d->cap) {
+        size_t new_cap = d->cap ? d->cap : BUFSIZ;
+        while (new_cap < d->len + want + 1) {
+            new_cap *= 2;
+        }
+        if (new_cap > (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD) * 2) {
+            new_cap = (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD) * 2;
+            if (d->len + want + 1 > new_cap) {
+                return -1;
+            }
+        }
+        char* new_buf = realloc(d->buf, new_cap);
+        if (new_buf == NULL) {
+            return -1;
+        }
+        d->buf = new_buf;
+        d->cap = new_cap;
+    }
+    return 0;
+}
+
+// 이미 메모리에 있는 데이터를 디코더에 추가
+int frame_decoder_feed(FrameDecoder* d, const char* data, size_t n) {
+    if (frame_decoder_reserve(d, n) < 0) {
+        return -1;
+    }
+    memcpy(d->buf + d->len, data, n);
+    d->len += n;
+    return 0;
+}
+
+// fd 에서 한 번 read 하여 디코더에 추가 (반환 : read 와 동일 - 0 EOF, -1 오류)
+ssize_t frame_decoder_read(FrameDecoder* d, int fd) {
+    if (frame_decoder_reserve(d, BUFSIZ) < 0) {
+        errno = ENOBUFS;
+        return -1;
+    }
+    ssize_t n = read(fd, d->buf + d->len, d->cap - d->len - 1);
+    if (n > 0) {
+        d->len += n;
+    }
+    return n;
+}
+
+// 완성된 프레임 한 개를 꺼냄
+// 반환 : 1 프레임 꺼냄, 0 데이터 부족(다음 read 필요), -1 프로토콜 오류(잘못된 길이 또는 명령어)
+int frame_decoder_next(FrameDecoder* d, Frame* out) {
+    frame_decoder_restore(d);
+
+    size_t avail = d->len - d->pos;
+    if (avail < FRAME_HEADER_SIZE) {
+        return 0;
+    }
+    char* p = d->buf + d->pos;
+    uint32_t be_len;
+    memcpy(&be_len, p, 4);
+    size_t len = ntohl(be_len);
+    int cmd = FRAME_CMD(p[4]);
+
+    if (len > FRAME_MAX_PAYLOAD || cmd <= CMD_NONE || cmd >= CMD_MAX) {
+        return -1;
+    }
+    if (avail < FRAME_HEADER_SIZE + len) {
+        return 0;
+    }
+
+    // chat-dev22 : 압축 프레임은 원본 프레임으로 풀어서 돌려줌 (raw 도 풀어낸 원본 프레임을 가리킴)
+    if (p[4] & FRAME_FLAG_LZ) {
+        if (d->inflate == NULL) {
+            d->inflate = malloc(FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + 1);
+            if (d->inflate == NULL) {
+                return -1;
+            }
+        }
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        long n = frame_decompress(d->inflate, FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD, p, FRAME_HEADER_SIZE + len);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (n < 0) {
+            return -1;
+        }
+        d->inflate[n] = '\0';
+        out->cmd = cmd;
+        out->payload = d->inflate + FRAME_HEADER_SIZE;
+        out->len = n - FRAME_HEADER_SIZE;
+        out->raw = d->inflate;
+        out->raw_len = n;
+        out->compressed = 1;
+        out->wire_len = FRAME_HEADER_SIZE + len;
+        out->inflate_ns = (uint64_t)(t1.tv_sec - t0.tv_sec) * 1000000000ull + (t1.tv_nsec - t0.tv_nsec);
+        d->pos += FRAME_HEADER_SIZE + len;
+        return 1;
+    }
+
+    out->cmd = cmd;
+    out->payload = p + FRAME_HEADER_SIZE;
+    out->len = len;
+    out->raw = p;
+    out->raw_len = FRAME_HEADER_SIZE + len;
+    out->compressed = 0;
+    out->wire_len = out->raw_len;
+    out->inflate_ns = 0;
+    d->pos += FRAME_HEADER_SIZE + len;
+
+    // payload 를 문자열로 바로 쓸 수 있도록 뒤 바이트(다음 프레임 헤더일 수 있음)를 임시로 NUL 로 바꿈
+    d->saved_at = d->pos;
+    d->saved_byte = d->buf[d->pos];
+    d->buf[d->pos] = '\0';
+    return 1;
+}
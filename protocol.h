@@ -0,0 +1,82 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// chat-dev7 : 길이 기반 메시지 프레이밍 프로토콜 (클라이언트 소켓, 서버 부모/자식 파이프 공용)
+// 프레임 구조 : [payload 길이 4바이트 (network byte order)][명령어 1바이트][payload]
+// => TCP 스트림/파이프에서 메시지 경계가 보장되지 않아 두 메시지가 한 번의 read 로 붙어 오거나
+//    하나의 메시지가 여러 번의 read 로 나뉘어 와도 FrameDecoder 가 정확히 한 메시지씩 분리함
+#define FRAME_HEADER_SIZE 5
+#define FRAME_MAX_PAYLOAD (BUFSIZ * 16) // 한 프레임 payload 최대 크기 (/USER all, /LIST all 응답 고려)
+
+// chat-dev22 : 압축 프레임 - 명령어 바이트의 최상위 비트가 1 이면 payload 가 [원본 payload 길이 4바이트 (network byte order)][LZ4 블록]
+// => CMD_CAPS 로 압축을 협상한 상대에게만 보내며, FrameDecoder 가 받는 즉시 원본 프레임으로 풀어서 돌려줌
+//    원본 payload 길이도 FRAME_MAX_PAYLOAD 이하 (풀어낸 프레임을 그대로 다른 fd 로 전달할 수 있도록)
+#define FRAME_FLAG_LZ     0x80
+#define FRAME_LZ_HEADER   4
+#define FRAME_CMD(byte)   ((unsigned char)(byte) & ~FRAME_FLAG_LZ) // 프레임 명령어 바이트에서 압축 표시를 뺀 명령어
+
+// 프레임 명령어 바이트 (클라이언트 → 서버 요청, 서버 → 클라이언트 응답 공용)
+enum {
+    CMD_NONE = 0,
+    CMD_NICK,    // 요청 payload : 닉네임, 응답 payload : OK / DUP
+    CMD_MSG,     // payload : 닉네임:메시지
+    CMD_ADD,
+    CMD_LEAVE,
+    CMD_RM,
+    CMD_USER,
+    CMD_LIST,
+    CMD_JOIN,
+    CMD_WHISPER, // 요청 payload : 보낸닉네임:받는닉네임 메시지
+    CMD_QUIT,    // 클라이언트 종료 요청
+    CMD_ERROR,   // 서버 → 클라이언트 오류 통지 (서버 수용량 초과, 프로토콜 오류 등)
+    CMD_STATS,   // chat-dev13 : 서버 지표 요약 요청 / 응답
+    CMD_HISTORY, // chat-dev14 : 요청 payload : 메시지 수, 응답 : 안내 문구 뒤에 저장된 CMD_MSG 프레임들
+    CMD_CAPS,    // chat-dev22 : 요청 payload : 클라이언트가 지원하는 기능 ("lz4"), 응답 : 서버가 켠 기능 ("lz4 min=압축 최소 프레임 크기", 없으면 빈 문자열)
+    CMD_PING,    // chat-dev27 : 연결 확인 (양방향) - 받은 쪽은 같은 payload 로 CMD_PONG 응답
+    CMD_PONG,    // chat-dev27 : CMD_PING 응답
+    CMD_MAX
+};
+
+// 디코딩된 프레임 한 개 (payload 는 디코더 내부 버퍼를 가리키며 다음 frame_decoder_next 호출 전까지 NUL 종료가 보장됨)
+typedef struct {
+    int cmd;
+    char* payload;
+    size_t len;
+    const char* raw;  // 헤더를 포함한 프레임 원본 시작 위치 (그대로 다른 fd 로 전달할 때 사용)
+    size_t raw_len;   // FRAME_HEADER_SIZE + len
+    int compressed;   // chat-dev22 : 압축 프레임으로 받아 디코더가 풀었음
+    size_t wire_len;  // chat-dev22 : 실제로 받은 프레임 길이 (압축 프레임이면 압축된 길이, 아니면 raw_len)
+    uint64_t inflate_ns; // chat-dev22 : 압축 프레임을 푸는 데 걸린 시간 (압축 프레임이 아니면 0)
+} Frame;
+
+// 부분 read, 여러 메시지가 붙은 read 를 모두 처리하는 스트리밍 디코더
+typedef struct {
+    char* buf;
+    size_t len;   // 버퍼에 채워진 바이트 수
+    size_t cap;
+    size_t pos;   // 이미 프레임으로 꺼낸 바이트 수
+    size_t saved_at; // payload NUL 종료를 위해 임시로 덮어쓴 위치 (0 : 없음)
+    char saved_byte;
+    char* inflate; // chat-dev22 : 압축 프레임을 풀어 둔 원본 프레임 (처음 받을 때 할당)
+} FrameDecoder;
+
+const char* frame_cmd_name(int cmd);
+int frame_cmd_from_name(const char* name, size_t len);
+
+void frame_put_header(char* dst, int cmd, size_t len);
+size_t frame_encode(char* dst, size_t cap, int cmd, const char* payload, size_t len);
+int frame_write(int fd, int cmd, const char* payload, size_t len);
+size_t frame_compress(char* dst, size_t cap, const char* frame, size_t len);
+long frame_decompress(char* dst, size_t cap, const char* frame, size_t len);
+
+void frame_decoder_init(FrameDecoder* d);
+void frame_decoder_free(FrameDecoder* d);
+int frame_decoder_feed(FrameDecoder* d, const char* data, size_t n);
+ssize_t frame_decoder_read(FrameDecoder* d, int fd);
+int frame_decoder_next(FrameDecoder* d, Frame* out);
+
+#endif
@@ -0,0 +1,166 @@
+#include <string.h>
+#include <sys/mman.h>
+
+#include "room_history.h"
+
+static RoomHistory* history_of(const RoomHistoryTable* t, int room) {
+    return (RoomHistory*)(t->base + t->stride * room);
+}
+
+static uint64_t* history_offsets(RoomHistory* h) {
+    return (uint64_t*)(h + 1);
+}
+
+static char* history_data(const RoomHistoryTable* t, RoomHistory* h) {
+    return (char*)(history_offsets(h) + t->max_msgs);
+}
+
+// 쓰기 시작 - seq 를 짝수에서 홀수로 바꾼 프로세스만 기록을 변경 (workers 모드의 /RM 처럼 채널 소유 worker 가 아닌 쪽이 비우는 경우 대비)
+static void history_write_begin(RoomHistory* h) {
+    while (1) {
+        uint32_t seq = __atomic_load_n(&h->seq, __ATOMIC_RELAXED);
+        if (!(seq & 1) && __atomic_compare_exchange_n(&h->seq, &seq, seq + 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void history_write_end(RoomHistory* h) {
+    __atomic_store_n(&h->seq, h->seq + 1, __ATOMIC_RELEASE);
+}
+
+// rooms 개 채널의 기록 영역 생성 (MAP_NORESERVE - 기록이 쓰인 페이지만 실제 메모리 사용)
+int room_history_create(RoomHistoryTable* t, int rooms, uint32_t max_msgs, uint32_t max_bytes) {
+    t->max_msgs = max_msgs;
+    t->max_bytes = max_bytes;
+    t->rooms = rooms;
+    t->stride = sizeof(RoomHistory) + sizeof(uint64_t) * max_msgs + max_bytes;
+    t->stride = (t->stride + 63) & ~(size_t)63; // 채널마다 캐시 라인 경계에서 시작
+    t->base = NULL;
+    if (max_msgs == 0 || max_bytes == 0) {
+        t->max_msgs = 0;
+        return 0;
+    }
+    void* mem = mmap(NULL, t->stride * rooms, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    t->base = mem;
+    return 0;
+}
+
+// 채널 메시지 프레임 한 개 기록 - 메시지 수나 바이트 수가 넘치면 오래된 메시지부터 버림
+// 반환 : 기록하지 않은 경우(기록 사용 안 함, 프레임이 데이터 영역보다 큼) -1, entry : 기록한 메시지 번호 (chat-dev15 : 저널 중복 제거용)
+int room_history_append(RoomHistoryTable* t, int room, const char* frame, size_t len, uint64_t* entry) {
+    if (t->max_msgs == 0 || len > t->max_bytes) {
+        return -1;
+    }
+    RoomHistory* h = history_of(t, room);
+    uint64_t* offsets = history_offsets(h);
+    char* data = history_data(t, h);
+
+    history_write_begin(h);
+    while (h->first < h->next &&
+           (h->next - h->first >= t->max_msgs || h->head + len - offsets[h->first % t->max_msgs] > t->max_bytes)) {
+        h->first++;
+    }
+    size_t off = h->head % t->max_bytes;
+    size_t part = t->max_bytes - off;
+    if (part > len) {
+        part = len;
+    }
+    memcpy(data + off, frame, part);
+    memcpy(data, frame + part, len - part);
+    offsets[h->next % t->max_msgs] = h->head;
+    *entry = h->next++;
+    h->head += len;
+    history_write_end(h);
+    return 0;
+}
+
+// 최근 메시지 최대 n 개를 buf 에 이어 붙여 복사 (cap 을 넘지 않는 만큼만, 오래된 순서)
+// 반환 : 복사한 바이트 수, count : 복사한 메시지 수, next_entry : (NULL 이 아니면) 마지막 메시지 번호 + 1
+size_t room_history_read(const RoomHistoryTable* t, int room, uint32_t n, char* buf, size_t cap, uint32_t* count, uint64_t* next_entry) {
+    *count = 0;
+    if (next_entry != NULL) {
+        *next_entry = 0;
+    }
+    if (t->max_msgs == 0 || n == 0) {
+        return 0;
+    }
+    RoomHistory* h = history_of(t, room);
+    uint64_t* offsets = history_offsets(h);
+    char* data = history_data(t, h);
+
+    while (1) {
+        uint32_t seq = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            continue; // 쓰는 중
+        }
+        uint64_t first = h->first;
+        uint64_t next = h->next;
+        uint64_t head = h->head;
+        uint64_t start = (next - first > n) ? next - n : first;
+        while (start < next && head - offsets[start % t->max_msgs] > cap) {
+            start++;
+        }
+        size_t len = 0;
+        if (start < next) {
+            uint64_t from = offsets[start % t->max_msgs];
+            len = head - from;
+            size_t off = from % t->max_bytes;
+            size_t part = t->max_bytes - off;
+            if (part > len) {
+                part = len;
+            }
+            memcpy(buf, data + off, part);
+            memcpy(buf + part, data, len - part);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&h->seq, __ATOMIC_RELAXED) == seq) {
+            *count = next - start;
+            if (next_entry != NULL) {
+                *next_entry = next;
+            }
+            return len;
+        }
+    }
+}
+
+// 채널 삭제 시 기록 비움 (같은 채널 번호를 다시 쓰는 새 채널에 이전 메시지가 보이지 않도록)
+void room_history_clear(RoomHistoryTable* t, int room) {
+    if (t->max_msgs == 0) {
+        return;
+    }
+    RoomHistory* h = history_of(t, room);
+    history_write_begin(h);
+    h->first = h->next;
+    history_write_end(h);
+}
+
+// 지표 조회용 - 기록 중인 메시지 수와 바이트 수
+void room_history_usage(const RoomHistoryTable* t, int room, uint32_t* msgs, size_t* bytes) {
+    *msgs = 0;
+    *bytes = 0;
+    if (t->max_msgs == 0) {
+        return;
+    }
+    RoomHistory* h = history_of(t, room);
+    while (1) {
+        uint32_t seq = __atomic_load_n(&h->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            continue;
+        }
+        uint64_t first = h->first;
+        uint64_t next = h->next;
+        uint64_t from = (first < next) ? history_offsets(h)[first % t->max_msgs] : h->head;
+        uint64_t head = h->head;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&h->seq, __ATOMIC_RELAXED) == seq) {
+            *msgs = next - first;
+            *bytes = head - from;
+            return;
+        }
+    }
+}
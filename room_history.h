@@ -0,0 +1,40 @@
+#ifndef ROOM_HISTORY_H
+#define ROOM_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// chat-dev14 : 채팅 채널별 최근 메시지 기록 (고정 크기 링 - 메시지 수와 바이트 수 두 가지로 제한)
+// => 채널 메시지 프레임을 그대로 저장하여 /JOIN, /LEAVE 로 들어온 클라이언트에게 최근 메시지를 한 번의 전송으로 다시 보내고,
+//    /HISTORY n 도 같은 기록에서 응답함
+//    모든 채널의 기록은 fork 전에 만든 하나의 MAP_SHARED 영역에 채널 번호 순서로 놓이며, 메시지가 쓰인 페이지만 실제 메모리를 사용
+//    기록은 채널 메시지 순서를 정하는 쪽(fork 모드 부모, epoll 모드 이벤트 루프, workers 모드 채널 소유 worker) 이 하고,
+//    읽는 쪽은 seqlock 으로 쓰는 도중의 기록을 읽지 않음
+#define ROOM_HISTORY_MSGS  50    // 기본 채널당 최대 메시지 수
+#define ROOM_HISTORY_BYTES 16384 // 기본 채널당 최대 바이트 수
+
+// 채널 하나의 기록 헤더 (뒤에 메시지 시작 위치 배열 uint64_t[max_msgs] 와 데이터 영역 char[max_bytes] 가 이어짐)
+// 0 으로 채워진 상태가 빈 기록이므로 따로 초기화하지 않음
+typedef struct {
+    uint32_t seq;   // 쓰는 중이면 홀수 (짝수 → 홀수 CAS 에 성공한 쪽만 씀)
+    uint32_t pad;
+    uint64_t first; // 가장 오래된 메시지 번호
+    uint64_t next;  // 다음에 쓸 메시지 번호
+    uint64_t head;  // 데이터 영역에 쓴 누적 바이트 수
+} RoomHistory;
+
+typedef struct {
+    char* base;
+    size_t stride;      // 채널 하나의 기록 크기 (헤더 + 위치 배열 + 데이터 영역)
+    uint32_t max_msgs;  // 0 : 기록 사용 안 함
+    uint32_t max_bytes;
+    int rooms;
+} RoomHistoryTable;
+
+int room_history_create(RoomHistoryTable* t, int rooms, uint32_t max_msgs, uint32_t max_bytes);
+int room_history_append(RoomHistoryTable* t, int room, const char* frame, size_t len, uint64_t* entry);
+size_t room_history_read(const RoomHistoryTable* t, int room, uint32_t n, char* buf, size_t cap, uint32_t* count, uint64_t* next_entry);
+void room_history_clear(RoomHistoryTable* t, int room);
+void room_history_usage(const RoomHistoryTable* t, int room, uint32_t* msgs, size_t* bytes);
+
+#endif
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE // chat-dev25 : accept4
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -11,11 +12,64 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>  // chat-dev6 : epoll 모드
+#include <sys/signalfd.h> // chat-dev8 : SIGCHLD 를 메인 루프에서 처리
+#include <sys/eventfd.h> // chat-dev9 : 방 멤버 일괄 깨우기
+#include <sys/mman.h>    // chat-dev9 : 방 로그 공유 메모리
+#include <pthread.h>       // chat-dev10 : workers 모드 process-shared mutex
+#include <sys/ioctl.h>     // chat-dev13 : 소켓 송신 대기 바이트 조회 (SIOCOUTQ)
+#include <sys/un.h>        // chat-dev13 : 관리용 UNIX 도메인 소켓
+#include <linux/sockios.h>
+#include <netinet/tcp.h>   // chat-dev16 : TCP_NODELAY
+#include <sys/timerfd.h>   // chat-dev16 : 전송 모으기 시간 타이머
 
-#define PORT    5101
-#define PENDING_CONN 5
+#include "protocol.h" // chat-dev7 : 길이 기반 메시지 프레이밍
+#include "ipc_ring.h" // chat-dev8 : 공유 메모리 링 + eventfd IPC
+#include "name_index.h" // chat-dev11 : 닉네임 해시 인덱스
+#include "log.h"        // chat-dev12 : 비동기 일괄 로그
+#include "stats.h"      // chat-dev13 : 서버 지표
+#include "room_history.h" // chat-dev14 : 채팅 채널별 최근 메시지 기록
+#include "journal.h"      // chat-dev15 : 채팅 채널 / 최근 메시지 저널
+#include "uring.h"        // chat-dev19 : io_uring 입출력 엔진
+#include "command.h"      // chat-dev23 : 명령어 payload 파서
+#include "msgbuf.h"       // chat-dev24 : 참조 카운트 메시지 버퍼 풀
+#include "admission.h"    // chat-dev25 : 출발지 IP 별 연결 속도 제한
+#include "config.h"       // chat-dev26 : 설정 파일
+#include "timer_wheel.h"  // chat-dev27 : 계층형 타이머 휠
+
+#define PORT    5101 // 기본 포트 (chat-dev26 : --port / 설정 파일 port)
+#define PENDING_CONN 5 // 관리용 소켓 대기 연결 수 (chat-dev25 : 채팅 listen 소켓은 --backlog)
+// chat-dev11 : 닉네임 조회가 클라이언트 수와 무관해졌으므로 빌드 시 -DMAX_CLIENTS=N 으로 늘릴 수 있도록 함
+// chat-dev26 : 기본 동시 접속 상한 (--max-clients / 설정 파일 max_clients, SIGHUP 으로 다시 읽음)
+#ifndef MAX_CLIENTS
 #define MAX_CLIENTS 30 // 최대 클라이언트 수 30
-#define MAX_ROOMS 5 // 최대 채팅 채널 수 5
+#endif
+// chat-dev11 : 채팅 채널 수용량은 실행 인자(--rooms=N) 로 정하고, 지정하지 않으면 기본값 사용
+#define MAX_ROOMS 1024 // 기본 채팅 채널 수용량
+#define MAX_ROOMS_LIMIT 65536 // --rooms=N 최대값
+
+// chat-dev26 : 실행 중 용량 변경 (설정 파일 + SIGHUP)
+// => 클라이언트 / 채팅 채널 표는 fork 모드 자식, workers 모드 worker 가 fork 로 물려받은 mapping 을 그대로 쓰므로 실행 중에 옮기거나 키울 수 없음
+//    그래서 시작할 때 예약 크기(--client-reserve, --rooms) 만큼 표를 만들고 (calloc / MAP_ANONYMOUS : 실제 메모리는 사용한 슬롯의 페이지만 차지)
+//    동시 접속 상한(--max-clients) 과 활성 채팅 채널 상한(--max-rooms) 만 공유 메모리에 두어 SIGHUP 때 연결을 끊지 않고 바꿈
+//    예약 크기 안에서만 늘릴 수 있고, 상한을 현재 수보다 낮추면 기존 연결 / 채널은 그대로 두고 새 연결 / 채널만 거절
+#define CLIENT_RESERVE       1024  // 기본 클라이언트 표 예약 크기
+#define CLIENT_RESERVE_LIMIT 65536 // --client-reserve 최대값
+typedef struct {
+    int max_clients; // 동시 접속 상한 (client_reserve 이하)
+    int max_rooms;   // 활성 채팅 채널 상한 (로비 포함, room_capacity 이하)
+    int clients;     // 슬롯을 차지한 클라이언트 수 (workers 모드는 shared_lock 안에서 변경)
+    int rooms;       // 활성 채팅 채널 수 (로비 포함)
+} ServerLimits;
+
+ServerLimits* server_limits; // fork 전에 MAP_SHARED 로 생성
+int client_reserve = CLIENT_RESERVE;
+int max_clients = MAX_CLIENTS;
+int max_rooms = -1; // 지정하지 않으면 채팅 채널 수용량(--rooms)
+int listen_port = PORT;
+const char* listen_host = "0.0.0.0";
+struct in_addr listen_addr; // listen_host (기본 : INADDR_ANY)
 
 // chat-dev1 0단계(구조 변경 및 프로토콜 설계)
 // chat-dev1 : 서버 측 데이터 구조 정의 - 클라이언트를 pid 가 아닌 닉네임, 현재 접속한 방 등의 정보로 관리할 구조체 정의
@@ -24,21 +78,211 @@ typedef struct {
     int client_sock_fd; // sock_fd
     char nickName[50];
     int room_idx; // 현재 접속한 방 index (0 : lobby)
+    int worker;   // chat-dev10 : workers 모드 - 연결을 소유한 worker 번호
+    uint32_t gen; // chat-dev10 : workers 모드 - 슬롯 재사용 시 이전 연결로 가는 메시지를 구분하기 위한 연결 세대
+    int room_prev; // chat-dev11 : 같은 채팅 채널 멤버 리스트의 이전/다음 client index (-1 : 없음)
+    int room_next;
+    int caps;      // chat-dev22 : CMD_CAPS 로 협상한 기능 (CLIENT_CAP_*)
 } ClientData;
 
 // chat-dev1 : 채팅 채널 데이터 구조 정의
 typedef struct {
     char roomName[100];
     int is_active; // 1 : 활성화, 0 : 비활성화
+    // chat-dev11 : 채팅 채널 멤버 리스트 (ClientData 의 room_prev / room_next 로 연결되는 intrusive 이중 연결 리스트)
+    // => 브로드캐스트, /USER 채널명, /RM 멤버 내보내기가 전체 clients[] 가 아닌 채널 멤버 수만큼만 순회
+    int member_head; // 첫 멤버 client index (-1 : 없음)
+    int member_tail; // 마지막 멤버 client index (참가 순서대로 뒤에 붙임)
+    int member_count;
+    int lz_member_count; // chat-dev22 : 압축을 협상한 멤버 수
+    int next_free;   // chat-dev11 : 비활성 채널 free list 의 다음 채널 번호 (-1 : 없음)
 } RoomData;
 
 // chat-dev1 : 서버 측 client 와 채팅 채널 데이터 구조 struct 전역 변수
-ClientData clients[MAX_CLIENTS]; // 기존 child_pid, client_sock 배열 통합
-RoomData rooms[MAX_ROOMS]; // 채팅 채널 배열
+// chat-dev10 : workers 모드에서는 모든 worker 가 공유하는 공유 메모리를 가리키도록 포인터로 사용
+// chat-dev26 : client_reserve 개 (create_client_tables)
+ClientData* clients; // 기존 child_pid, client_sock 배열 통합
+RoomData* rooms; // 채팅 채널 배열 (chat-dev11 : 실행 시 채널 수용량만큼 공유 메모리에 생성)
+
+// chat-dev11 : 채팅 채널 레지스트리 - 채널 이름 → 채널 번호 해시 인덱스, 비활성 채널 번호 free list
+// => /ADD, /RM, /JOIN, /USER 채널명 이 채널 수와 무관하게 O(1), 채널 번호는 삭제될 때까지 바뀌지 않음
+//    fork 모드 자식, workers 모드 worker 가 fork 로 같은 mapping 을 물려받도록 실행 시 한 번만 생성 (이후 크기 변경 없음)
+typedef struct {
+    int capacity;    // 채팅 채널 수용량 (rooms[] 크기)
+    int free_head;   // 비활성 채널 free list 첫 번호 (-1 : 수용량 초과)
+    NameIndex index; // 활성 채널 이름 → 채널 번호
+} RoomRegistry;
+
+RoomRegistry* room_registry;
+int room_capacity = MAX_ROOMS;
+
+// chat-dev11 : 닉네임 → client index 해시 인덱스 (/NICK 중복 검사, /WHISPER 대상 조회를 O(1) 로)
+// => 임시 닉네임 "GUEST" 는 등록하지 않고 /NICK 으로 정한 닉네임만 등록, 슬롯 초기화 전에 삭제
+//    workers 모드에서는 공유 메모리의 인덱스를 가리킴 (clients 와 같이 shared_lock 안에서만 변경)
+#define NICK_INDEX_SIZE ((size_t)client_reserve * 2 + 1) // load factor 0.5 이하 유지
+NameIndexEntry* nick_index_table;
+NameIndex nick_index_local;
+NameIndex* nick_index = &nick_index_local;
+
+// chat-dev12 : 로그 옵션 (--log-level, --log-flush-ms)
+int server_log_level = LOG_INFO;
+int log_flush_ms = LOG_FLUSH_MS;
+
+// chat-dev13 : 관리용 UNIX 도메인 소켓 - 연결하면 Prometheus text 형식 지표를 한 번 쓰고 닫음 (예 : nc -U 경로)
+// => fork 모드는 부모, epoll 모드는 이벤트 루프, workers 모드는 모든 worker 가 같은 listen 소켓을 감시하여 응답
+#define ADMIN_SOCKET_PATH "./logs/chattingServer_admin.sock"
+const char* admin_path = ADMIN_SOCKET_PATH;
+int admin_fd = -1;
+
+// chat-dev14 : 채팅 채널별 최근 메시지 기록 (--history=N : 채널당 최대 메시지 수, 0 이면 사용 안 함, --history-bytes=N : 채널당 최대 바이트 수)
+// => /JOIN, /LEAVE 응답 뒤에 이동한 채널의 최근 메시지를 이어 붙여 한 번에 전달, /HISTORY n 도 같은 기록에서 응답
+//    다시 보내는 메시지는 응답 문구와 합쳐 최대 프레임 크기 이내 (fork 모드 부모 → 자식 링, workers 모드 라우팅 레코드 한 개에 들어가도록)
+#define HISTORY_REPLAY_MAX (FRAME_MAX_PAYLOAD - BUFSIZ)
+int history_msgs = ROOM_HISTORY_MSGS;
+int history_bytes = ROOM_HISTORY_BYTES;
+RoomHistoryTable room_history;
+
+// chat-dev15 : 채팅 채널 개설/삭제, 채널 메시지 저널 (--journal=PATH, 빈 값 : 사용 안 함)
+// => 시작할 때 스냅샷과 저널을 재생하여 채널 목록(채널 번호 포함) 과 최근 메시지를 복구
+//    닉네임은 접속(연결) 에 속한 정보이고 재시작하면 연결이 모두 끊기므로 저장하지 않음
+//    저널 파일(기본 64 MB) 을 디스크에 만들므로 --journal 로 경로를 지정할 때만 사용 (기본 : 사용 안 함)
+const char* journal_path = "";
+size_t journal_size = JOURNAL_SIZE;
+int journal_sync = JOURNAL_SYNC_BATCH;
+int journal_sync_ms = JOURNAL_SYNC_MS;
+Journal journal;
+
+// chat-dev16 : 클라이언트 전송 모아 보내기 (--coalesce-us=N)
+// => 클라이언트 소켓을 가진 쪽(fork 모드 자식, epoll / workers 모드 이벤트 루프) 이 전달할 데이터를 모아 한 번의 writev / send 로 전송
+//    0 (지연 우선, 기본) : 이벤트 한 번(fork 모드 자식) 또는 이벤트 루프 한 바퀴(epoll / workers 모드) 동안 쌓인 데이터만 모아 바로 전송
+//    N (처리량 우선) : 첫 데이터가 쌓인 뒤 최대 N us 동안 더 모아서 전송 - 큰 채널에서 전송 syscall 과 작은 TCP 세그먼트 수가 줄어듦
+//    모은 데이터가 COALESCE_BYTES 이상이면 기다리지 않고 전송하며, 클라이언트 소켓은 TCP_NODELAY 로 모아 보낸 뒤 Nagle 지연 없이 내보냄
+#define COALESCE_US_MAX 10000
+#define COALESCE_BYTES  (1 << 16)
+int coalesce_us = 0;
+int coalesce_timer_fd = -1; // 모으기 시간 타이머 (fork 모드 자식, epoll / workers 모드 이벤트 루프마다 따로 생성)
+int coalesce_timer_armed = 0;
+
+// chat-dev17 : 클라이언트별 송신 큐 상한/하한과 느린 클라이언트 정책
+// => 읽지 않는 클라이언트 하나 때문에 메모리가 계속 늘거나 다른 클라이언트의 전달이 늦어지지 않도록 클라이언트별로 쌓이는 데이터를 제한
+//    송신 큐 : fork 모드 부모 → 자식 링 (링 크기 = 상한을 2 의 거듭제곱으로 올림), epoll / workers 모드 송신 버퍼
+//    상한(--out-queue) 을 넘으면 느린 클라이언트로 표시하여 정책(--slow-policy) 대로 처리하고, 하한(--out-queue-low) 아래로 비워지면 해제
+//    drop-newest : 새 프레임을 버림
+//    drop-oldest : 보내는 중인 프레임을 제외한 오래된 프레임을 하한까지 버리고 새 프레임을 넣음 (fork 모드 링은 자식이 읽는 중일 수 있어 drop-newest 로 처리)
+//    disconnect  : 새 프레임을 버리다가 --slow-timeout-ms 가 지나도 하한 아래로 비워지지 않으면 연결 종료
+//    fork 모드 브로드캐스트는 방 로그를 덮어쓰므로 정책과 관계없이 밀린 자식이 오래된 메시지를 건너뜀 (disconnect 정책은 소켓 전송 시간 제한으로 종료)
+#define OUT_QUEUE_KB     256
+#define OUT_QUEUE_KB_MAX 65536
+#define SLOW_POLICY_DROP_NEWEST 0
+#define SLOW_POLICY_DROP_OLDEST 1
+#define SLOW_POLICY_DISCONNECT  2
+#define SLOW_TIMEOUT_MS  5000
+int out_queue_kb = OUT_QUEUE_KB;
+int out_queue_low_kb = -1;
+size_t out_queue_high = (size_t)OUT_QUEUE_KB << 10;
+size_t out_queue_low = (size_t)OUT_QUEUE_KB << 9;
+size_t out_queue_ring = IPC_RING_SIZE; // fork 모드 부모 → 자식 링 크기
+int slow_policy = SLOW_POLICY_DROP_NEWEST;
+int slow_timeout_ms = SLOW_TIMEOUT_MS;
+const char* slow_policy_names[] = { "drop-newest", "drop-oldest", "disconnect" };
+
+// 느린 클라이언트 상태 (fork 모드 부모, epoll / workers 모드 연결을 소유한 프로세스가 관리하고 연결이 끝나면 초기화)
+typedef struct {
+    int slow;          // 상한을 넘은 뒤 하한 아래로 비워지기 전까지 1
+    int kicked;        // disconnect 정책으로 연결 종료를 요청함
+    uint64_t since_ns; // 상한을 넘은 시각
+} SlowConsumer;
+SlowConsumer* slow_consumers; // chat-dev26 : client_reserve 개 (아래 클라이언트별 배열 모두 같음)
+
+// chat-dev25 : 연결 수락 제어
+// => 재시작 직후 클라이언트들이 한꺼번에 다시 접속하면 listen 대기 큐(기존 5) 가 넘쳐 SYN 이 버려지고 클라이언트 연결이 수 초씩 걸렸음
+//    listen 대기 큐 크기(--backlog, 커널 net.core.somaxconn 을 넘으면 커널이 줄임) 를 늘리고,
+//    listen 소켓이 준비되면 non-blocking accept4 로 한 번에 최대 --accept-batch 개까지 연속으로 받아들임 (fork 모드는 기존 1 개)
+//    --conn-rate=N 이면 출발지 IP 마다 초당 N 개 (최대 --conn-burst 개 연속) 까지만 받아들이고,
+//    넘는 연결은 자식 프로세스 / IPC 링 / 슬롯을 만들기 전에 CMD_ERROR 프레임을 보내고 바로 닫음
+#define LISTEN_BACKLOG     1024
+#define LISTEN_BACKLOG_MAX 65535
+#define ACCEPT_BATCH       64
+#define ACCEPT_BATCH_MAX   4096
+#define CONN_RATE_MAX      100000
+int listen_backlog = LISTEN_BACKLOG;
+int accept_batch = ACCEPT_BATCH;
+int conn_rate = 0;   // 출발지 IP 별 초당 연결 수 (0 : 제한 없음, 기본)
+int conn_burst = -1; // 출발지 IP 별 연속 연결 수 (지정하지 않으면 초당 연결 수의 2 배)
+AdmissionTable* admission = NULL; // chat-dev26 : 항상 생성 (SIGHUP 으로 속도 제한을 켤 수 있음)
+uint64_t accept_wake_ns = 0; // listen 소켓이 준비된 것을 본 시각 (연결 수락 시간 지표의 시작)
+
+// chat-dev27 : 응답 없는 연결 정리 (PING / PONG heartbeat + 유휴 시간 제한)
+// => 절전 / NAT 시간 초과처럼 FIN, RST 없이 사라진 클라이언트가 TCP 오류가 날 때까지 슬롯, IPC 링, fork 모드 자식을 계속 차지했음
+//    --ping-interval 초 동안 아무 프레임도 받지 못하면 CMD_PING 을 보내고 (클라이언트는 CMD_PONG 으로 응답, 응답이 없으면 같은 간격으로 다시 보냄)
+//    --idle-timeout 초 동안 아무 프레임도 받지 못하면 연결을 끊고 슬롯 회수 (fork 모드는 자식에게 SIGTERM - SIGCHLD 처리에서 회수)
+//    연결마다 타이머 하나를 이벤트 루프의 타이머 휠에 두고, 프레임을 받을 때는 시각만 기록 (만료될 때 마지막 수신 시각으로 다시 예약)
+#define PING_INTERVAL  30     // 기본 PING 간격 (초, 0 : 보내지 않음)
+#define IDLE_TIMEOUT   90     // 기본 유휴 시간 제한 (초, 0 : 끊지 않음)
+#define HEARTBEAT_MAX  86400  // --ping-interval, --idle-timeout 최대값 (초)
+#define TIMER_TICK_MS  250    // 타이머 휠 tick 간격
+typedef struct {
+    TimerEntry timer;
+    uint64_t last_active_ms; // 마지막으로 프레임을 받은 시각
+    uint64_t last_ping_ms;   // 마지막으로 PING 을 보낸 시각
+} ClientHeartbeat;
+int ping_interval = PING_INTERVAL;
+int idle_timeout = IDLE_TIMEOUT;
+ClientHeartbeat* heartbeats; // client_reserve 개 (프로세스마다 따로 - 연결을 처리하는 이벤트 루프만 사용)
+TimerWheel timers;           // 이벤트 루프마다 하나 (fork 모드 부모, epoll 모드, workers 모드 worker)
+int timer_fd = -1;           // 타이머 휠 tick (TIMER_TICK_MS 주기 timerfd, 사용하지 않으면 -1)
 
 // 3 -> 4단계: 전역 변수로 pipe, conn_sock, child_pid 정의
-int pipe_parent_to_child[MAX_CLIENTS][2]; // 부모 → 자식 write 기준으로 변수 이름 정의 
-int pipe_child_to_parent[MAX_CLIENTS][2]; // 자식 → 부모 write 기준으로 변수 이름 정의
+// chat-dev8 : pipe + SIGUSR1/SIGUSR2 를 공유 메모리 SPSC 링 + eventfd 채널로 대체
+IpcChannel* ipc_to_child;  // 부모 → 자식 (부모가 생산자, 자식이 소비자)
+IpcChannel* ipc_to_parent; // 자식 → 부모 (자식이 생산자, 부모가 소비자)
+
+// chat-dev9 : 채팅 채널별 공유 메모리 메시지 로그와 방 멤버 자식들을 한 번에 깨우는 eventfd (fork 모드)
+// => 브로드캐스트 1건 = 방 로그 복사 1회 + eventfd_write 1회 (멤버 수와 무관)
+//    방 eventfd 는 아무도 read 하지 않고 자식들이 EPOLLET 로 감시하여, write 한 번마다 모든 멤버의 epoll 이 깨어남
+// chat-dev11 : 채널 수가 많아도 fd 수가 늘지 않도록 방 eventfd 는 ROOM_EFD_POOL 개를 채널 번호로 나누어 공유
+// => 같은 eventfd 를 쓰는 다른 방 멤버는 깨어나도 방 로그 head 가 그대로이므로 전달 없이 바로 다시 잠듦
+#define ROOM_EFD_POOL 64
+RoomLog** room_logs; // 채널 수용량 개
+int room_efd[ROOM_EFD_POOL];
+
+// chat-dev9 : 부모가 기록하고 자식이 읽는 클라이언트별 방 이동 정보 (공유 메모리, seqlock 으로 보호)
+typedef struct {
+    uint32_t seq;        // 부모가 갱신할 때마다 +2 (홀수 : 갱신 중)
+    int room_idx;        // 현재 방
+    uint64_t join_head;  // 현재 방에 들어온 시점의 방 로그 head (여기부터 전달)
+    int prev_room_idx;   // 직전 방 (-1 : 없음)
+    uint64_t leave_head; // 직전 방을 떠난 시점의 방 로그 head (여기까지 전달)
+} RoomCursor;
+RoomCursor* room_cursors; // client_reserve 개, fork 전에 MAP_SHARED 로 생성
+
+// chat-dev9 : 자식 전용 - 현재 전달 중인 방과 방 로그 읽기 위치
+int child_room = -1;
+uint64_t child_room_cursor = 0;
+uint32_t child_room_seq = 0;
+
+// chat-dev16 : 자식 전용 - 클라이언트에게 보낼 데이터 모음 (child_flush_client 에서 sendmsg 한 번으로 전송)
+// => 부모 → 자식 링은 공유 메모리를 복사 없이 가리키고 전송 후에 링에서 비우며, 방 로그는 부모가 덮어쓸 수 있으므로 child_out 에 복사해서 가리킴
+//    (chat-dev18 : --zero-copy=on 이면 방 로그도 먼저 복사 없이 가리키고, 다 보내지 못한 나머지만 child_out 에 복사)
+#define CHILD_IOV_MAX  8
+#define CHILD_OUT_SIZE (2 * (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD))
+struct iovec child_iov[CHILD_IOV_MAX];
+int child_iov_count = 0;
+size_t child_iov_bytes = 0;
+char child_out[CHILD_OUT_SIZE];
+size_t child_out_len = 0;   // child_out 에 복사한 방 로그 바이트
+size_t child_ring_used = 0; // 전송 후 부모 → 자식 링에서 비울 바이트
+int child_send_failed = 0;  // chat-dev17 : 클라이언트 소켓 전송 실패 (연결 종료 또는 disconnect 정책의 전송 시간 초과)
+
+// chat-dev18 : fork 모드 자식의 방 로그 복사 없는 전달 (--zero-copy=on|off)
+// => on (기본) : 방 로그의 완성 프레임을 child_out 에 복사하지 않고 공유 메모리를 그대로 가리켜 sendmsg (MSG_DONTWAIT) 로 한 번 전송
+//    소켓 버퍼가 가득 차 남은 방 로그 구간은 기다리는 동안 부모가 덮어쓸 수 있으므로 child_out 에 복사한 뒤 이어서 전송 (복사 경로로 대체)
+//    전송/복사 후 그 사이 덮어쓰였는지 확인하여, 덮어쓰였으면 클라이언트가 찢어진 프레임을 받았으므로 연결을 종료
+//    자식이 방 로그 크기의 절반 이상 밀렸거나, 밀린 양이 child_out 에 남은 공간보다 커서 프레임 경계를 찾아 나눠 보내야 하면 기존처럼 복사
+int zero_copy = 1;
+RoomLog* child_zc_log = NULL; // 복사 없이 가리킨 방 로그 (전송 전, 한 번에 한 방 로그만)
+uint64_t child_zc_from = 0;   // 가리킨 방 로그 구간의 시작 위치
+size_t child_zc_bytes = 0;    // 가리킨 방 로그 바이트 (child_out 에 이만큼의 공간을 남겨 둠)
 
 // chat-dev1 : 실제 루프를 돌 때 사용할 경계 값 추가
 int active_client_count = 0;
@@ -50,667 +294,3913 @@ int listen_fd, conn_fd;
 // 7 단계 : 서버 데몬화 처리 및 로그 출력을 파일로 리디렉션을 위한 로그 파일 디스크립터
 int file_fd;
 
-// 7단계 : 로그 출력을 위해서 시간을 [YYYY-MM-DD HH:MM:SS] 형식으로 문자열을 생성하는 함수
-void get_timestamp(char* dest, size_t size, const char* msg) {
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
+// chat-dev6 : 서버 모드 - fork(클라이언트당 자식 프로세스) 와 epoll(단일 프로세스 이벤트 루프) 중 선택
+// => 기존 fork 모드는 그대로 유지하고, 같은 부하에서 두 모드를 비교할 수 있도록 실행 인자(--mode=) 로 선택
+#define SERVER_MODE_FORK  0
+#define SERVER_MODE_EPOLL 1
+#define SERVER_MODE_WORKERS 2 // chat-dev10 : 다수 worker 프로세스(각자 epoll 루프) 모드
+int server_mode = SERVER_MODE_FORK;
+
+// chat-dev10 : workers 모드 - SO_REUSEPORT 로 같은 포트를 공유하는 N 개의 worker 가 각자 epoll 루프로 다수 연결을 처리
+// => 단일 부모 프로세스가 모든 명령어를 처리하던 구조에서 코어 수만큼 처리량이 늘어나도록 함
+//    채팅 채널은 room_idx % N 번 worker(소유 shard) 가 메시지 순서를 정하고, 멤버가 있는 worker 에게만 한 번씩 전달
+#define MAX_WORKERS 64
+
+typedef struct {
+    pthread_mutex_t lock;                     // clients / rooms 변경 보호 (process-shared, robust)
+    uint32_t next_gen;
+    NameIndex nick_index;                         // chat-dev11 : 모든 worker 가 공유하는 닉네임 인덱스
+    ClientData clients[];                         // chat-dev26 : client_reserve 개, 뒤에 닉네임 인덱스 칸 NICK_INDEX_SIZE 개
+} WorkerShared;
+
+WorkerShared* worker_shared;
+// 채팅 채널별, worker 별 멤버 수 [room * MAX_WORKERS + worker] (소유 shard 가 전달할 worker 를 고를 때 사용)
+// chat-dev11 : 채널 수용량이 실행 시 정해지므로 채팅 채널 레지스트리와 같은 공유 메모리에 생성
+int* room_members;
+int worker_count = 0;
+int worker_index = -1;          // -1 : worker 들을 관리하는 최상위 프로세스
+pid_t worker_pids[MAX_WORKERS];
+IpcChannel* worker_routes;      // worker 간 라우팅 채널 [src * worker_count + dst] (SPSC 링 + eventfd)
+
+// worker 간 라우팅 레코드 종류
+enum {
+    ROUTE_ROOM_SEQUENCE = 1, // 소유 shard 에게 : 채팅 채널 메시지 순서 결정 및 전달 요청
+    ROUTE_ROOM_DELIVER,      // 멤버가 있는 worker 에게 : 자신의 채팅 채널 멤버들에게 전달
+    ROUTE_CLIENT             // 연결을 소유한 worker 에게 : 한 클라이언트에게 전달 (귓속말 등)
+};
 
-    char timestamp[32];       // 시간 문자열 저장용
+// 라우팅 레코드 헤더 (뒤에 len 바이트의 인코딩된 프레임이 이어짐)
+typedef struct {
+    uint32_t kind;
+    int32_t target; // ROUTE_ROOM_* : room index, ROUTE_CLIENT : client index
+    uint32_t gen;   // ROUTE_CLIENT : 대상 연결 세대
+    uint32_t len;
+} RouteHeader;
+
+// chat-dev24 : 송신 큐 항목 - 보낼 풀 버퍼의 참조와 그 버퍼에서 이미 보낸 바이트
+typedef struct {
+    MsgBuf* buf;
+    size_t off;
+} OutRef;
+
+// chat-dev6 : epoll 모드에서 클라이언트 소켓에 바로 쓰지 못한(EAGAIN) 데이터를 보관하는 송신 버퍼
+// chat-dev24 : 바이트를 복사해 붙이는 대신 풀 버퍼 참조를 [head, tail) 순서로 보관 (브로드캐스트는 모든 멤버 큐가 같은 버퍼를 가리킴)
+// => 전송은 참조들을 iovec 으로 모아 sendmsg 한 번, 다 보낸 버퍼의 참조를 놓음
+typedef struct {
+    OutRef* refs;
+    size_t head;
+    size_t tail;
+    size_t cap;
+    size_t len;  // 보내지 않은 바이트 합
+    int waiting; // chat-dev16 : EPOLLOUT 감시 중 (소켓 송신 버퍼가 가득 차서 쓸 수 있을 때까지 기다림)
+    size_t inflight; // chat-dev19 : io_uring 엔진 - 커널에 제출한 send 가 아직 보내지 못한 바이트 (waiting : send 완료 대기 중)
+} OutBuffer;
+
+#define OUT_REFS_INIT 16
+#define OUT_IOV_MAX   64 // chat-dev24 : sendmsg 한 번에 모으는 최대 버퍼 수
+
+OutBuffer* client_out; // epoll 모드 전용 클라이언트별 송신 버퍼
+// chat-dev16 : 송신 버퍼에 데이터가 쌓여 이벤트 루프 끝(또는 모으기 시간 만료) 에 전송할 클라이언트 목록
+// => client_dirty 는 목록에서 빠질 때까지 유지하여 (슬롯이 회수되었다가 재사용되어도) 같은 슬롯이 두 번 들어가지 않도록 함
+int* client_dirty;
+int* dirty_clients;
+int dirty_count = 0;
+int* room_deliver_members; // workers 모드 : 채팅 채널 멤버 중 이 worker 가 소유한 연결 (worker_deliver_room_local 이 잠근 상태에서 복사)
+// chat-dev7 : 클라이언트별 수신 프레임 디코더 (fork 모드 : 부모가 자식 파이프를 읽을 때, epoll 모드 : 클라이언트 소켓을 읽을 때)
+FrameDecoder* client_in;
+int epoll_fd = -1; // epoll 모드 전용 epoll 인스턴스
+
+// chat-dev19 : epoll / workers 모드 입출력 엔진 (--io-engine=epoll|uring)
+// => uring : 이벤트 루프가 epoll_wait + accept / read / send syscall 대신 io_uring 하나로 입출력을 처리
+//    listen 소켓은 multishot accept, 클라이언트 소켓은 제공 버퍼 링을 쓰는 multishot recv 를 한 번만 제출하고,
+//    이벤트 루프 한 바퀴 동안 쌓인 클라이언트 전송은 send 요청으로 모아 다음 io_uring_enter 한 번으로 제출
+//    eventfd / timerfd / 관리용 소켓은 multishot poll 로 감시하고, 명령어 처리는 epoll 엔진과 같은 함수를 사용
+//    시작할 때 커널 지원 여부를 확인하여 사용할 수 없으면 경고를 남기고 epoll 엔진으로 동작
+#define IO_ENGINE_EPOLL 0
+#define IO_ENGINE_URING 1
+int io_engine = IO_ENGINE_EPOLL;
+Uring uring;
+
+// io_uring 요청 종류 (user_data 상위 8 비트) - 나머지는 연결 세대(24 비트) 와 client index 또는 EPOLL_*_ID
+#define URING_OP_ACCEPT 1
+#define URING_OP_RECV   2
+#define URING_OP_SEND   3
+#define URING_OP_POLL   4
+#define URING_OP_CANCEL 5
+#define URING_GEN_MASK  0xFFFFFFu
+
+// 슬롯별 제출한 send 의 버퍼 - 연결이 끊겨도 완료가 올 때까지 커널이 읽으므로 유지
+// chat-dev24 : 송신 큐 앞의 참조를 최대 URING_SEND_REFS 개 옮겨 와 sendmsg 로 제출하고, 완료될 때 참조를 놓음
+#define URING_SEND_REFS 64
+typedef struct {
+    OutRef refs[URING_SEND_REFS];
+    struct iovec iov[URING_SEND_REFS];
+    struct msghdr msg;
+    int count;  // 옮겨 온 참조 수
+    int first;  // 아직 다 보내지 않은 첫 iovec
+    size_t len;
+    size_t off; // 보낸 바이트 (일부만 보냈으면 나머지를 다시 제출)
+    int busy;   // 완료 대기 중
+} UringSend;
+
+UringSend* uring_sends;
+uint32_t* uring_gen; // 슬롯의 연결 세대 (연결을 닫을 때 증가 - 이전 연결 요청의 완료를 구분)
+
+// chat-dev22 : 협상된 프레임 압축 (--compress=on|off, --compress-min=BYTES)
+// => 클라이언트가 /NICK 이후 CMD_CAPS "lz4" 로 압축 지원을 알리면 "lz4 min=N" 으로 응답하고, 이후 N 바이트 이상인 프레임을 압축해서 주고받음
+//    명령어 응답 (/USER all, /LIST all 등) : 받는 클라이언트가 협상했으면 압축
+//    브로드캐스트 : 한 번만 압축하고 같은 압축 프레임을 협상한 멤버 모두에게 전달 (최근 메시지 기록, 저널은 원본 프레임)
+//      epoll 모드 : 협상한 멤버에게는 압축 프레임, 나머지 멤버에게는 원본 프레임
+//      workers 모드 : 소유 shard 가 압축한 프레임을 라우팅하고, 협상하지 않은 멤버가 있는 worker 만 한 번 풀어서 전달
+//      fork 모드 : 방 로그는 멤버 자식들이 같은 바이트를 그대로 보내므로 채널 멤버가 모두 협상했을 때만 압축 프레임을 기록
+//    압축해도 1/8 이상 줄지 않는 프레임은 원본으로 보냄
+#define COMPRESS_MIN     512
+#define COMPRESS_MIN_LOW 64
+#define CLIENT_CAP_LZ    0x1
+int compress_enabled = 1;
+int compress_min = COMPRESS_MIN;
+
+void epoll_send_to_client(int idx, const char* msg, size_t len);
+void epoll_send_buf(int idx, MsgBuf* b);
+void epoll_mark_dirty(int idx);
+void worker_route(int dst, int kind, int target, uint32_t gen, const char* frame, size_t len);
+void worker_room_fanout(int room, MsgBuf* b);
+void workers_shutdown();
+void admin_serve();
+void admin_watch(int efd);
+void epoll_close_client(int idx);
+
+// chat-dev10 : workers 모드에서 공유 clients / rooms 를 변경하기 전에 잠금 (다른 모드는 단일 스레드 처리이므로 잠그지 않음)
+int shared_lock_held = 0; // 이 worker 가 잠금을 가지고 있음 (잠근 상태로 호출될 수도 있는 함수가 다시 잠그지 않도록)
+void shared_lock() {
+    if (server_mode != SERVER_MODE_WORKERS) {
+        return;
+    }
+    // 잠금을 가진 worker 가 비정상 종료된 경우에도 다른 worker 가 이어서 사용할 수 있도록 robust mutex 사용
+    if (pthread_mutex_lock(&worker_shared->lock) == EOWNERDEAD) {
+        pthread_mutex_consistent(&worker_shared->lock);
+    }
+    shared_lock_held = 1;
+}
 
-    strftime(timestamp, sizeof(timestamp), "[%Y-%m-%d %H:%M:%S] ", t);
-    snprintf(dest, size, "%s%s", timestamp, msg);
+void shared_unlock() {
+    if (server_mode != SERVER_MODE_WORKERS) {
+        return;
+    }
+    shared_lock_held = 0;
+    pthread_mutex_unlock(&worker_shared->lock);
 }
 
-// 4단계: SIGUSR1, SIGUSR2 핸들러 함수 
-// 부모 시그널 핸들러 SIGUSR1 : 자식이 부모에게 메시지를 보냈음을 알리면 이를 부모가 읽음
-// chat-dev1 : 메시지를 읽고 메시지 명령어에 해당하는 동작을 취하도록 함 -> 프로토콜 처리 허브 역할
-void sigusr1_handler(int signo) {
-    // 7단계 : LOG Redirection
-    char logMsg[BUFSIZ * 2 + 32];
-    char errMsg[BUFSIZ * 2];
-    snprintf(errMsg, sizeof(errMsg), "[INFO] : [부모 pid %d] SIGUSR1 핸들러 발생", getpid()); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
-
-    char buf[BUFSIZ + 10 + 50];
-    int n;
-        
-    // 4단계 -> chat-dev1 : 메시지를 읽고 메시지 명령어에 해당하는 동작을 취하도록 함
-    // i : client index 
-    for(int i = 0; i < active_client_count; i++){
-        // 비활성 클라이언트는 건너뛰기
-        if(clients[i].pid == 0){
+// chat-dev11 : 닉네임 인덱스가 비교할 이름 (idx 번 클라이언트의 현재 닉네임)
+const char* client_nick_of(int idx) {
+    return clients[idx].nickName;
+}
+
+// chat-dev11 : idx 번 클라이언트의 닉네임을 인덱스에서 삭제 (슬롯 초기화, 닉네임 변경 전에 호출)
+// => 등록되지 않은 "GUEST" 나 다른 클라이언트가 가진 같은 이름은 삭제하지 않음
+void release_client_nick(int idx) {
+    name_index_remove(nick_index, clients[idx].nickName, idx);
+}
+
+// chat-dev11 : 채널 이름 인덱스가 비교할 이름 (room 번 채널의 이름)
+const char* room_name_of(int room) {
+    return rooms[room].roomName;
+}
+
+// chat-dev11 : 채팅 채널 레지스트리 생성 및 초기화 (로비 활성화, 나머지 채널은 free list 에 번호 순서대로 연결)
+// 레지스트리, 채널 배열, 이름 인덱스, (workers 모드) 채널별 worker 멤버 수를 하나의 공유 메모리에 둠
+int create_room_table() {
+    size_t index_size = (size_t)room_capacity * 2 + 1; // load factor 0.5 이하 유지
+    size_t size = sizeof(RoomRegistry) + sizeof(RoomData) * room_capacity + sizeof(NameIndexEntry) * index_size;
+    if (server_mode == SERVER_MODE_WORKERS) {
+        size += sizeof(int) * room_capacity * MAX_WORKERS;
+    }
+    char* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    room_registry = (RoomRegistry*)mem;
+    rooms = (RoomData*)(mem + sizeof(RoomRegistry));
+    NameIndexEntry* entries = (NameIndexEntry*)(rooms + room_capacity);
+    if (server_mode == SERVER_MODE_WORKERS) {
+        room_members = (int*)(entries + index_size);
+    }
+
+    room_registry->capacity = room_capacity;
+    name_index_init(&room_registry->index, entries, index_size, room_name_of);
+    for (int r = 0; r < room_capacity; r++) {
+        rooms[r].member_head = -1;
+        rooms[r].member_tail = -1;
+        rooms[r].next_free = (r + 1 < room_capacity) ? r + 1 : -1;
+    }
+    room_registry->free_head = (room_capacity > 1) ? 1 : -1;
+
+    strcpy(rooms[0].roomName, "lobby");
+    rooms[0].is_active = 1;
+    name_index_insert(&room_registry->index, rooms[0].roomName, 0);
+    server_limits->rooms = 1; // chat-dev26 : 로비
+    return 0;
+}
+
+// chat-dev15 : 저널에 레코드 한 개 추가 (저널이 가득 차면 버리고 경고 - 다음 스냅샷 이후 다시 기록됨)
+void journal_write(int type, int room, uint64_t entry, const void* payload, size_t len) {
+    if (journal_append(&journal, type, room, entry, payload, len) < 0) {
+        log_write(LOG_WARNING, "저널이 가득 차서 채팅 채널(%d) 기록(%zu 바이트)을 버립니다.", room, len);
+    }
+}
+
+// chat-dev15 : 채널 메시지를 최근 메시지 기록에 쓰고, 기록된 메시지 번호와 함께 저널에 추가
+void record_room_message(int room, const char* frame, size_t len) {
+    uint64_t entry;
+    if (room_history_append(&room_history, room, frame, len, &entry) == 0) {
+        journal_write(JOURNAL_MSG, room, entry, frame, len);
+    }
+}
+
+// chat-dev11 : 이름으로 활성 채팅 채널 번호 조회 (-1 : 없음)
+int find_room(const char* name) {
+    return name_index_find(&room_registry->index, name);
+}
+
+// chat-dev11 : free list 에서 채널 번호를 꺼내 name 채널 활성화 (-1 : 수용량 초과, 이름 중복은 호출 전에 확인)
+// chat-dev26 : 채팅 채널 상한 (SIGHUP 으로 바뀜, 로비 포함) 에 닿아도 -1
+int create_room(const char* name) {
+    int room = room_registry->free_head;
+    if (room < 0 || server_limits->rooms >= server_limits->max_rooms) {
+        return -1;
+    }
+    server_limits->rooms++;
+    room_registry->free_head = rooms[room].next_free;
+    rooms[room].next_free = -1;
+    rooms[room].is_active = 1;
+    snprintf(rooms[room].roomName, sizeof(rooms[room].roomName), "%s", name);
+    name_index_insert(&room_registry->index, rooms[room].roomName, room);
+    journal_write(JOURNAL_ROOM_ADD, room, 0, rooms[room].roomName, strlen(rooms[room].roomName)); // chat-dev15
+    return room;
+}
+
+// chat-dev11 : room 번 채널 비활성화 후 채널 번호를 free list 에 반환 (멤버는 호출 전에 모두 내보냄)
+void delete_room(int room) {
+    name_index_remove(&room_registry->index, rooms[room].roomName, room);
+    room_history_clear(&room_history, room); // chat-dev14 : 같은 채널 번호로 만든 새 채널에 이전 메시지가 보이지 않도록
+    journal_write(JOURNAL_ROOM_RM, room, 0, NULL, 0); // chat-dev15
+    rooms[room].is_active = 0;
+    memset(rooms[room].roomName, 0, sizeof(rooms[room].roomName)); // roomName 문자열 초기화
+    rooms[room].next_free = room_registry->free_head;
+    room_registry->free_head = room;
+    server_limits->rooms--; // chat-dev26
+}
+
+// chat-dev15 : 활성 채팅 채널 목록과 채널별 최근 메시지를 스냅샷으로 저장 (저널 압축)
+// workers 모드 worker 는 채널 목록을 바꾸는 명령어가 끼어들지 않도록 잠근 상태에서 메모리에 모으고, 파일 쓰기는 잠금 밖에서 함
+// (시작 / 종료 시 최상위 프로세스는 worker 가 없으므로 잠그지 않음)
+void journal_take_snapshot() {
+    static char frames[HISTORY_REPLAY_MAX];
+    int locked = (server_mode == SERVER_MODE_WORKERS && worker_index >= 0);
+    JournalSnapshot snapshot;
+
+    if (locked) {
+        shared_lock();
+    }
+    if (journal_snapshot_begin(&journal, &snapshot) < 0) {
+        if (locked) {
+            shared_unlock();
+        }
+        return; // 다른 worker 가 작성 중
+    }
+    for (int r = 0; r < room_capacity; r++) {
+        if (!rooms[r].is_active) {
             continue;
         }
+        uint32_t count;
+        uint64_t next_entry;
+        size_t len = room_history_read(&room_history, r, room_history.max_msgs, frames, sizeof(frames), &count, &next_entry);
+        journal_snapshot_room(&snapshot, r, rooms[r].roomName, next_entry, count, frames, len);
+    }
+    if (locked) {
+        shared_unlock();
+    }
+    if (journal_snapshot_commit(&journal, &snapshot) < 0) {
+        log_write(LOG_ERROR, "저널 스냅샷(%s.snapshot) 저장 실패 - %s", journal_path, strerror(errno));
+    }
+}
 
-        while(1) {
-            memset(buf, 0, BUFSIZ); // 버퍼를 0 으로 초기화
-            // non-blocking 으로 읽기 시도
-            n = read(pipe_child_to_parent[i][0], buf, BUFSIZ);
-            if (n <= 0) {
-                break; // 더 이상 읽을 게 없으면 break
-            }
-            
-            // 메시지를 보낸 첫 자식을 찾았을 때 처리
-            buf[n] = '\0'; // 문자열 끝 처리
-            // 7단계 : LOG Redirection
-            char logMsg[BUFSIZ * 2 + 32];
-            char errMsg[BUFSIZ * 2];
-            snprintf(errMsg, sizeof(errMsg), "[INFO] : SIGUSR1 핸들러: 클라이언트 index %d 로부터 메시지 수신을 담당 서버 자식프로세스로부터 받음 : %s", i, buf); // 로그 TYPE 문자열 결합
-            get_timestamp(logMsg, sizeof(logMsg), errMsg);
-            printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-            fflush(stdout);
-
-            char ch[10], str[BUFSIZ + 12 + 50];
-            // 클라이언트로부터 받은 문자열 분리
-            // 클라이언트로부터 받는 문자열 예시 1 : /NICK NICKNAME
-            // 예시 2 : /MSG NICKNAME:MSG
-            // chat-dev2 : 버그 수정 - 메시지에 공백이 있을 때 공백을 메시지에 포함하지 못하는 경우 수정
-            // => sscanf 는 공백 포함 문자열을 담기 어렵기 때문에 strchr 과 strcpy 구조로 변경
-            char* space = strchr(buf, ' ');
-            if (space != NULL) {
-                sscanf(buf, "/%s", ch);
-                strcpy(str, space + 1);  // 공백 이후 문자열 복사
-            }
-
-            // 닉네임 중복 검사 처리
-            if(strcmp(ch, "NICK") == 0){
-                int is_dup = 0;
-                for(int j = 0; j < active_client_count; j++){
-                    if(clients[j].pid != 0 && j != i && strcmp(clients[j].nickName, str) == 0){
-                        is_dup = 1; // 중복 처리
-                        break;
-                    } 
-                }
-                char response[BUFSIZ + 12 + 50];
-                if(is_dup){ // 중복
-                    snprintf(response, sizeof(response), "%s", "DUP");
-                } else {
-                    // 중복이 아닐 때 nickName 부여
-                    strncpy(clients[i].nickName, str, sizeof(clients[i].nickName) - 1);
-                    snprintf(response, sizeof(response), "%s", "OK");
-                }
-                
-                // 중복 처리 결과를 i 번 자식 파이프에 write
-                write(pipe_parent_to_child[i][1], response, strlen(response));
-                kill(clients[i].pid, SIGUSR2); // 해당 자식 프로세스에 SIGUSR2 시그널 알림
-            } else if(strcmp(ch, "MSG") == 0){
-                // 같은 채팅 채널에만 전송하기 위해서 사용할 임시 변수 sender_room
-                int sender_room = clients[i].room_idx;
-                
-                // 브로드캐스트할 전체 채팅 메시지
-                char sendnickName[51];
-                char msg[BUFSIZ];
-                char* colon = strchr(str, ':');
-                if (colon != NULL) {
-                    *colon = '\0'; // ':'를 문자열 종료로 바꿈
-                    strcpy(sendnickName, str);
-                    strcpy(msg, colon + 1);
-                }
-                char broadcast_msg[BUFSIZ * 3];
-                
-                // chat-dev2 : 채팅을 보낼 때 무슨 채팅 채널에서 보냈는지 를 닉네임 앞에 추가함
-                char WhereIsRoomAndNickname[BUFSIZ * 2];
-                snprintf(WhereIsRoomAndNickname, sizeof(WhereIsRoomAndNickname), "%s 채널(%d) ", rooms[sender_room].roomName, sender_room);
-                strcat(WhereIsRoomAndNickname, sendnickName);
-
-                snprintf(broadcast_msg, sizeof(broadcast_msg), "/MSG %s:%s", WhereIsRoomAndNickname, msg);
-
-                // pid 가 0 이 아니고(실제 접속 중인 클라이언트 서버한테만) 같은 채팅 공간에 브로드캐스트 메시지를 j 번 파이프에 write
-                // 하고, 해당 자식 프로세스에 SIGUSR2 시그널 알림
-                for(int j = 0; j < active_client_count; j++){
-                    if (clients[j].pid > 0 && clients[j].room_idx == sender_room) {
-                        write(pipe_parent_to_child[j][1], broadcast_msg, strlen(broadcast_msg));
-                        kill(clients[j].pid, SIGUSR2);
-                    }
+// chat-dev15 : 스냅샷 이후 저널 사용량이 절반을 넘었으면 스냅샷 저장 (이벤트 루프 한 바퀴마다 잠그지 않은 상태에서 확인)
+void journal_check_snapshot() {
+    if (journal_should_snapshot(&journal)) {
+        uint64_t started = stats_now_ns();
+        journal_take_snapshot();
+        log_write(LOG_INFO, "저널 스냅샷 저장 (%.1f ms)", (stats_now_ns() - started) / 1e6);
+    }
+}
+
+// chat-dev15 : 저널 복구 - room 번 채널을 name 으로 활성화 (free list 는 복구가 끝난 뒤 다시 만듦)
+// 반환 -1 : 채널 수용량 밖이거나 같은 이름의 다른 채널이 있어 복구하지 않음
+int journal_room_add(void* ctx, int room, const char* name) {
+    if (room == 0) {
+        return 0; // 로비는 항상 활성
+    }
+    int owner = find_room(name);
+    if (room >= room_capacity || (owner >= 0 && owner != room)) {
+        return -1;
+    }
+    if (owner < 0) {
+        if (rooms[room].is_active) {
+            name_index_remove(&room_registry->index, rooms[room].roomName, room);
+        }
+        rooms[room].is_active = 1;
+        snprintf(rooms[room].roomName, sizeof(rooms[room].roomName), "%s", name);
+        name_index_insert(&room_registry->index, rooms[room].roomName, room);
+    }
+    return 0;
+}
+
+void journal_room_rm(void* ctx, int room) {
+    if (room == 0 || room >= room_capacity || !rooms[room].is_active) {
+        return;
+    }
+    name_index_remove(&room_registry->index, rooms[room].roomName, room);
+    rooms[room].is_active = 0;
+    memset(rooms[room].roomName, 0, sizeof(rooms[room].roomName));
+    room_history_clear(&room_history, room);
+}
+
+void journal_room_msg(void* ctx, int room, const char* frame, size_t len) {
+    uint64_t entry;
+    if (room < room_capacity && rooms[room].is_active) {
+        room_history_append(&room_history, room, frame, len, &entry);
+    }
+}
+
+// chat-dev15 : 서버 시작 시 저널 열기, 스냅샷 + 저널 재생으로 채팅 채널과 최근 메시지 복구 후 새 스냅샷 저장
+// (채널 레지스트리, 최근 메시지 기록 생성 후, 서버 프로세스들을 fork 하기 전에 호출)
+void journal_restore() {
+    uint64_t started = stats_now_ns();
+    if (journal_open(&journal, journal_path, journal_size) < 0) {
+        log_write(LOG_WARNING, "저널(%s) 열기 실패 - 채팅 채널을 저장하지 않습니다. (%s)", journal_path, strerror(errno));
+        return;
+    }
+    JournalReplay replay = { journal_room_add, journal_room_rm, journal_room_msg };
+    JournalRecovery result;
+    if (journal_recover(&journal, room_capacity, &replay, NULL, &result) > 0) {
+        log_write(LOG_WARNING, "저널 스냅샷(%s.snapshot) 을 읽지 못해 스냅샷 이후 기록만 복구합니다.", journal_path);
+    }
+
+    // 복구한 채널을 제외하고 free list 를 번호 순서대로 다시 만듦
+    int active = 0;
+    room_registry->free_head = -1;
+    for (int r = room_capacity - 1; r > 0; r--) {
+        if (rooms[r].is_active) {
+            rooms[r].next_free = -1;
+            active++;
+        } else {
+            rooms[r].next_free = room_registry->free_head;
+            room_registry->free_head = r;
+        }
+    }
+    server_limits->rooms = active + 1; // chat-dev26 : 복구한 채널 + 로비
+    double recover_ms = (stats_now_ns() - started) / 1e6;
+
+    journal_take_snapshot();
+    if (journal_start(&journal, journal_size, journal_sync, journal_sync_ms) < 0) {
+        log_write(LOG_WARNING, "저널 시작 실패 - %s", strerror(errno));
+    }
+    log_write(LOG_INFO, "저널 복구 : 채팅 채널 %d 개, 메시지 %llu 건 (스냅샷 %llu 바이트, 저널 레코드 %llu 개 / %llu 바이트) - 복구 %.1f ms, 전체 %.1f ms",
+              active, (unsigned long long)result.messages, (unsigned long long)result.snapshot_bytes,
+              (unsigned long long)result.records, (unsigned long long)result.journal_bytes, recover_ms, (stats_now_ns() - started) / 1e6);
+}
+
+// chat-dev11 : workers 모드 - room 번 채널의 w 번 worker 멤버 수
+int* room_member_count(int room, int w) {
+    return &room_members[(size_t)room * MAX_WORKERS + w];
+}
+
+// chat-dev11 : 목록 응답 버퍼(used 바이트 사용 중) 에 한 줄 추가 - 버퍼가 모자라면 추가하지 않고 -1
+// => 채팅 채널, 접속자 수가 많아져도 /LIST all, /USER 응답이 버퍼를 넘지 않도록 함
+int append_list_line(char* dst, size_t cap, size_t* used, const char* line) {
+    size_t n = strlen(line);
+    if (*used + n + 1 > cap) {
+        return -1;
+    }
+    memcpy(dst + *used, line, n + 1);
+    *used += n;
+    return 0;
+}
+
+// chat-dev11 : idx 번 클라이언트를 room 번 채팅 채널 멤버 리스트 끝에 추가
+void room_member_add(int room, int idx) {
+    RoomData* r = &rooms[room];
+    if (clients[idx].caps & CLIENT_CAP_LZ) {
+        r->lz_member_count++; // chat-dev22
+    }
+    clients[idx].room_prev = r->member_tail;
+    clients[idx].room_next = -1;
+    if (r->member_tail >= 0) {
+        clients[r->member_tail].room_next = idx;
+    } else {
+        r->member_head = idx;
+    }
+    r->member_tail = idx;
+    r->member_count++;
+}
+
+// chat-dev11 : idx 번 클라이언트를 room 번 채팅 채널 멤버 리스트에서 삭제
+void room_member_remove(int room, int idx) {
+    RoomData* r = &rooms[room];
+    int prev = clients[idx].room_prev;
+    int next = clients[idx].room_next;
+    if (prev >= 0) {
+        clients[prev].room_next = next;
+    } else {
+        r->member_head = next;
+    }
+    if (next >= 0) {
+        clients[next].room_prev = prev;
+    } else {
+        r->member_tail = prev;
+    }
+    clients[idx].room_prev = -1;
+    clients[idx].room_next = -1;
+    r->member_count--;
+    if (clients[idx].caps & CLIENT_CAP_LZ) {
+        r->lz_member_count--; // chat-dev22
+    }
+}
+
+// chat-dev11 : 접속 종료된 idx 번 클라이언트의 채팅 채널 멤버, 닉네임 인덱스 정리 후 슬롯 초기화
+// workers 모드에서는 shared_lock 안에서 호출됨
+void release_client_slot(int idx) {
+    if (server_mode == SERVER_MODE_WORKERS) {
+        __atomic_sub_fetch(room_member_count(clients[idx].room_idx, clients[idx].worker), 1, __ATOMIC_RELAXED);
+    }
+    room_member_remove(clients[idx].room_idx, idx);
+    release_client_nick(idx);
+    memset(&clients[idx], 0, sizeof(ClientData)); // 슬롯 초기화
+    server_limits->clients--; // chat-dev26
+    stats_add(&server_stats->disconnects, 1); // chat-dev13
+    stats_client_reset(idx);
+    timer_wheel_cancel(&timers, &heartbeats[idx].timer); // chat-dev27 (이 프로세스의 휠에 없으면 아무것도 하지 않음)
+}
+
+// chat-dev13 : 지표 조회용 서버 모드 이름
+const char* server_mode_name() {
+    if (server_mode == SERVER_MODE_EPOLL) {
+        return "epoll";
+    }
+    return server_mode == SERVER_MODE_WORKERS ? "workers" : "fork";
+}
+
+// chat-dev13 : 지표 조회용 idx 번 슬롯 정보 (반환 0 : 빈 슬롯)
+// 전달 대기 바이트 - fork 모드 : 부모 → 자식 링에 쌓인 바이트 (기존 pipe_parent_to_child 의 FIONREAD 에 해당)
+//                   epoll / workers 모드 : 송신 버퍼 + (조회하는 프로세스가 소유한 소켓이면) 커널 송신 큐(SIOCOUTQ)
+int stats_client_info(int idx, const char** nick, uint64_t* queued) {
+    if (clients[idx].pid == 0) {
+        return 0;
+    }
+    *nick = clients[idx].nickName;
+    if (server_mode == SERVER_MODE_FORK) {
+        *queued = ipc_to_child[idx].ring != NULL ? shm_ring_used(ipc_to_child[idx].ring) : 0;
+        return 1;
+    }
+    *queued = __atomic_load_n(&server_stats->clients[idx].queued, __ATOMIC_RELAXED);
+    int outq;
+    if ((server_mode == SERVER_MODE_EPOLL || clients[idx].worker == worker_index) &&
+        ioctl(clients[idx].client_sock_fd, SIOCOUTQ, &outq) == 0) {
+        *queued += outq;
+    }
+    return 1;
+}
+
+// chat-dev14 : 지표 조회용 room 번 채널의 최근 메시지 기록 사용량 (반환 0 : 비활성 채널)
+int stats_room_info(int room, const char** name, uint32_t* history_msgs, uint64_t* history_bytes) {
+    if (!rooms[room].is_active) {
+        return 0;
+    }
+    size_t bytes;
+    *name = rooms[room].roomName;
+    room_history_usage(&room_history, room, history_msgs, &bytes);
+    *history_bytes = bytes;
+    return 1;
+}
+
+// chat-dev22 : 인코딩된 프레임(frame, len) 을 압축하고 압축 비율, CPU 시간 기록
+// 반환 : 압축 프레임을 담은 풀 버퍼 (chat-dev24, 참조는 호출한 쪽이 놓음), NULL : 압축 최소 크기 미만이거나 충분히 줄지 않음 - 원본 프레임을 보냄
+MsgBuf* compress_for_send(const char* frame, size_t len) {
+    if (!compress_enabled || len < (size_t)compress_min) {
+        return NULL;
+    }
+    MsgBuf* b = msgbuf_alloc(len); // 압축 프레임은 원본보다 작을 때만 만들어짐
+    if (b == NULL) {
+        return NULL;
+    }
+    uint64_t started = stats_now_ns();
+    size_t n = frame_compress(b->data, b->size, frame, len);
+    stats_add(&server_stats->compress_ns, stats_now_ns() - started);
+    if (n == 0) {
+        stats_add(&server_stats->compress_skipped, 1);
+        msgbuf_release(b);
+        return NULL;
+    }
+    b->len = n;
+    stats_add(&server_stats->compress_frames, 1);
+    stats_add(&server_stats->compress_in_bytes, len);
+    stats_add(&server_stats->compress_out_bytes, n);
+    return b;
+}
+
+// chat-dev22 : 압축 프레임(frame, len) 을 원본 프레임으로 dst 에 풀고 CPU 시간 기록 (반환 : 원본 프레임 바이트 수, -1 실패)
+long decompress_for_send(char* dst, size_t cap, const char* frame, size_t len) {
+    uint64_t started = stats_now_ns();
+    long n = frame_decompress(dst, cap, frame, len);
+    stats_add(&server_stats->decompress_ns, stats_now_ns() - started);
+    if (n > 0) {
+        stats_add(&server_stats->decompress_frames, 1);
+        stats_add(&server_stats->decompress_in_bytes, len);
+        stats_add(&server_stats->decompress_out_bytes, n);
+    }
+    return n;
+}
+
+// chat-dev22 : 클라이언트가 압축해서 보낸 프레임을 디코더가 풀었으면 해제 지표 기록
+void stats_add_inflated(const Frame* frame) {
+    if (frame->compressed) {
+        stats_add(&server_stats->decompress_frames, 1);
+        stats_add(&server_stats->decompress_in_bytes, frame->wire_len);
+        stats_add(&server_stats->decompress_out_bytes, frame->raw_len);
+        stats_add(&server_stats->decompress_ns, frame->inflate_ns);
+    }
+}
+
+// chat-dev17 : 송신 큐에 queued 바이트가 쌓인 idx 번 클라이언트에게 len 바이트 프레임을 넣을지 결정
+// 반환 : OUT_QUEUE_ACCEPT 넣음, OUT_QUEUE_TRIM 오래된 프레임을 하한까지 버린 뒤 넣음 (epoll / workers 모드 drop-oldest), OUT_QUEUE_DROP 버림
+#define OUT_QUEUE_ACCEPT 0
+#define OUT_QUEUE_TRIM   1
+#define OUT_QUEUE_DROP   2
+int out_queue_admit(int idx, size_t queued, size_t len) {
+    SlowConsumer* sc = &slow_consumers[idx];
+
+    if (sc->slow && queued <= out_queue_low) {
+        sc->slow = 0;
+        log_write(LOG_INFO, "클라이언트 index %d 의 송신 큐가 하한(%zu 바이트) 아래로 비워져 느린 클라이언트 표시를 해제합니다.", idx, out_queue_low);
+    }
+    if (!sc->slow) {
+        if (queued + len <= out_queue_high) {
+            return OUT_QUEUE_ACCEPT;
+        }
+        sc->slow = 1;
+        sc->since_ns = stats_now_ns();
+        stats_add(&server_stats->slow_events, 1);
+        log_write(LOG_WARNING, "클라이언트 index %d (nick: %s) 의 송신 큐가 상한(%zu 바이트) 을 넘어 느린 클라이언트로 처리합니다. (정책 : %s)",
+                  idx, clients[idx].nickName, out_queue_high, slow_policy_names[slow_policy]);
+    }
+    if (slow_policy == SLOW_POLICY_DROP_OLDEST && server_mode != SERVER_MODE_FORK) {
+        return OUT_QUEUE_TRIM;
+    }
+    if (slow_policy == SLOW_POLICY_DISCONNECT && !sc->kicked &&
+        stats_now_ns() - sc->since_ns >= (uint64_t)slow_timeout_ms * 1000000) {
+        sc->kicked = 1;
+        stats_add(&server_stats->slow_disconnects, 1);
+        log_write(LOG_WARNING, "클라이언트 index %d (nick: %s) 의 송신 큐가 %d ms 동안 비워지지 않아 연결을 종료합니다.", idx, clients[idx].nickName, slow_timeout_ms);
+        if (server_mode == SERVER_MODE_FORK) {
+            kill(clients[idx].pid, SIGTERM); // 자식 종료 후 SIGCHLD 처리에서 슬롯 회수
+        } else {
+            epoll_mark_dirty(idx); // 브로드캐스트 중일 수 있으므로 이벤트 루프 끝(epoll_flush_pending) 에서 종료
+        }
+    }
+    stats_add(&server_stats->dropped_newest, 1);
+    stats_add(&server_stats->dropped_bytes, len);
+    return OUT_QUEUE_DROP;
+}
+
+// chat-dev6 : 명령어 처리 결과를 idx 번 클라이언트에게 전달
+// fork 모드 : idx 번 자식의 공유 메모리 링에 쓰고, 자식이 잠들어 있을 때만 eventfd 로 깨움 (chat-dev8)
+// epoll 모드 : 서버가 직접 소유한 클라이언트 소켓으로 바로 전송 (파이프, 시그널 없음)
+void send_to_client(int idx, const char* msg, size_t len) {
+    if(server_mode == SERVER_MODE_EPOLL){
+        epoll_send_to_client(idx, msg, len);
+        return;
+    }
+    // chat-dev10 : workers 모드 - 다른 worker 가 소유한 연결이면 해당 worker 에게 라우팅
+    if(server_mode == SERVER_MODE_WORKERS){
+        if (clients[idx].worker == worker_index) {
+            epoll_send_to_client(idx, msg, len);
+        } else {
+            worker_route(clients[idx].worker, ROUTE_CLIENT, idx, clients[idx].gen, msg, len);
+        }
+        return;
+    }
+    // 링이 가득 찬 경우(자식이 클라이언트에게 전달하지 못하고 밀린 상태) 부모가 멈추지 않도록 메시지를 버림
+    // chat-dev17 : 링이 가득 차기 전에 송신 큐 상한/하한과 느린 클라이언트 정책으로 판단
+    if (out_queue_admit(idx, shm_ring_used(ipc_to_child[idx].ring), len) == OUT_QUEUE_DROP) {
+        return;
+    }
+    if (ipc_channel_send(&ipc_to_child[idx], msg, len) < 0) {
+        log_write(LOG_WARNING, "클라이언트 index %d 의 IPC 링이 가득 차서 메시지(%zu 바이트)를 버립니다.", idx, len);
+        return;
+    }
+    // chat-dev13 : 명령어별 / 클라이언트별 보낸 프레임, 바이트
+    stats_add(&server_stats->frames_out[FRAME_CMD(msg[4])], 1);
+    stats_add(&server_stats->clients[idx].frames_out, 1);
+    stats_add(&server_stats->clients[idx].bytes_out, len);
+}
+
+// chat-dev24 : 풀 버퍼 b 의 프레임을 idx 번 클라이언트에게 전달 (참조는 호출한 쪽이 놓음)
+// => 이 프로세스가 연결을 가진 epoll / workers 모드는 송신 큐가 참조만 잡고 (복사 없음), 나머지는 send_to_client 와 같음
+void send_buf_to_client(int idx, MsgBuf* b) {
+    if (server_mode == SERVER_MODE_EPOLL || (server_mode == SERVER_MODE_WORKERS && clients[idx].worker == worker_index)) {
+        epoll_send_buf(idx, b);
+    } else {
+        send_to_client(idx, b->data, b->len);
+    }
+}
+
+// chat-dev9 : idx 번 클라이언트의 방 이동 정보를 자식이 볼 수 있도록 공유 메모리에 기록 (seqlock 쓰기)
+void room_cursor_publish(int idx, int prev_room, int room) {
+    RoomCursor* rc = &room_cursors[idx];
+    uint32_t seq = rc->seq;
+    __atomic_store_n(&rc->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&rc->prev_room_idx, prev_room, __ATOMIC_RELAXED);
+    __atomic_store_n(&rc->leave_head, prev_room >= 0 ? room_log_head(room_logs[prev_room]) : 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rc->room_idx, room, __ATOMIC_RELAXED);
+    __atomic_store_n(&rc->join_head, room_log_head(room_logs[room]), __ATOMIC_RELAXED);
+    __atomic_store_n(&rc->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+// chat-dev9 : 클라이언트의 채팅 채널 위치 변경
+// fork 모드 : 자식이 새 방의 로그를 읽도록 방 이동 정보를 기록하고 자식을 깨움 (/RM 처럼 응답이 없는 이동도 반영되도록)
+void set_client_room(int idx, int room) {
+    int prev_room = clients[idx].room_idx;
+    clients[idx].room_idx = room;
+    // chat-dev11 : 채팅 채널 멤버 리스트 이동
+    if (clients[idx].pid > 0 && prev_room != room) {
+        room_member_remove(prev_room, idx);
+        room_member_add(room, idx);
+    }
+    // chat-dev10 : workers 모드 - 채팅 채널별, worker 별 멤버 수 갱신 (shared_lock 안에서 호출됨)
+    if (server_mode == SERVER_MODE_WORKERS && clients[idx].pid > 0 && prev_room != room) {
+        __atomic_sub_fetch(room_member_count(prev_room, clients[idx].worker), 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(room_member_count(room, clients[idx].worker), 1, __ATOMIC_RELAXED);
+    }
+    if (server_mode == SERVER_MODE_FORK && clients[idx].pid > 0 && prev_room != room) {
+        room_cursor_publish(idx, prev_room, room);
+        eventfd_write(ipc_to_child[idx].efd, 1);
+    }
+}
+
+// chat-dev9 : 인코딩된 프레임을 room 번 채팅 채널의 모든 클라이언트에게 전달
+// fork 모드 : 방 로그에 한 번 쓰고 방 eventfd 로 멤버 자식들을 한 번에 깨움
+// workers 모드 : 채팅 채널 소유 shard 가 순서를 정한 뒤 멤버가 있는 worker 마다 한 번씩 전달 (chat-dev10)
+// epoll 모드 : 방 멤버의 소켓(송신 버퍼) 에 각각 전송
+// chat-dev24 : 프레임은 풀 버퍼 b 로 받아 epoll / workers 모드 멤버 송신 큐가 같은 버퍼를 참조 (참조는 호출한 쪽이 놓음)
+void broadcast_to_room(int room, MsgBuf* b) {
+    const char* frame = b->data;
+    size_t len = b->len;
+    int members = rooms[room].member_count;
+    stats_hist_add(&server_stats->fanout, members); // chat-dev13 : 브로드캐스트 fan-out 크기
+    // chat-dev14 : 최근 메시지 기록 (workers 모드는 순서를 정하는 채널 소유 shard 가 worker_room_fanout 에서 기록)
+    if (server_mode != SERVER_MODE_WORKERS) {
+        record_room_message(room, frame, len);
+    }
+    if (server_mode == SERVER_MODE_FORK) {
+        // chat-dev22 : 채널 멤버가 모두 압축을 협상했으면 한 번 압축한 프레임을 방 로그에 기록 (멤버 자식들이 같은 바이트를 전달)
+        // => 자식은 방에 있는 동안 기록된 구간만 전달하고 협상은 취소되지 않으므로, 압축 프레임은 협상한 클라이언트에게만 전달됨
+        MsgBuf* lz = (members > 0 && rooms[room].lz_member_count == members) ? compress_for_send(frame, len) : NULL;
+        if (lz != NULL) {
+            frame = lz->data;
+            len = lz->len;
+        }
+        // 방 로그 전달은 자식이 하므로 부모가 기록할 때 멤버 수만큼 보낸 프레임으로 셈
+        stats_add(&server_stats->frames_out[FRAME_CMD(frame[4])], members);
+        stats_add(&server_stats->room_log_bytes, len);
+        room_log_append(room_logs[room], frame, len);
+        eventfd_write(room_efd[room % ROOM_EFD_POOL], 1);
+        msgbuf_release(lz);
+        return;
+    }
+    if (server_mode == SERVER_MODE_WORKERS) {
+        int owner = room % worker_count;
+        if (owner == worker_index) {
+            worker_room_fanout(room, b);
+        } else {
+            worker_route(owner, ROUTE_ROOM_SEQUENCE, room, 0, frame, len);
+        }
+        return;
+    }
+    // chat-dev22 : 압축을 협상한 멤버가 있으면 한 번만 압축하여 협상한 멤버 모두에게 같은 압축 프레임을 전달
+    MsgBuf* lz = rooms[room].lz_member_count > 0 ? compress_for_send(frame, len) : NULL;
+    // chat-dev11 : 전체 clients[] 대신 채팅 채널 멤버 리스트만 순회하여 j 번 클라이언트에게 전달
+    for (int j = rooms[room].member_head; j >= 0; j = clients[j].room_next) {
+        send_buf_to_client(j, (lz != NULL && (clients[j].caps & CLIENT_CAP_LZ)) ? lz : b);
+    }
+    msgbuf_release(lz);
+}
+
+// chat-dev24 : 헤더 뒤(b->data + FRAME_HEADER_SIZE) 에 payload len 바이트를 써 둔 풀 버퍼를 cmd 프레임으로 완성하여 idx 번 클라이언트에게 전달
+// => 큰 응답(/USER all, /LIST all) 은 풀 버퍼에 바로 작성하여 스택 버퍼 → 프레임 복사를 없앰 (참조는 호출한 쪽이 놓음)
+void send_cmd_buf(int idx, int cmd, MsgBuf* b, size_t len) {
+    frame_put_header(b->data, cmd, len);
+    b->len = FRAME_HEADER_SIZE + len;
+    // chat-dev22 : 압축을 협상한 클라이언트에게는 큰 응답을 압축해서 전달
+    MsgBuf* lz = (clients[idx].caps & CLIENT_CAP_LZ) ? compress_for_send(b->data, b->len) : NULL;
+    send_buf_to_client(idx, lz != NULL ? lz : b);
+    msgbuf_release(lz);
+}
+
+// chat-dev7 : 명령어 바이트 cmd 와 payload 문자열을 프레임으로 인코딩하여 idx 번 클라이언트에게 전달
+// chat-dev24 : 스택 / 힙 프레임 대신 풀 버퍼에 인코딩
+void send_cmd_to_client(int idx, int cmd, const char* payload) {
+    size_t len = strlen(payload);
+    if (len > FRAME_MAX_PAYLOAD) {
+        return;
+    }
+    MsgBuf* b = msgbuf_alloc(FRAME_HEADER_SIZE + len);
+    if (b == NULL) {
+        return;
+    }
+    memcpy(b->data + FRAME_HEADER_SIZE, payload, len);
+    send_cmd_buf(idx, cmd, b, len);
+    msgbuf_release(b);
+}
+
+// chat-dev14 : 응답 프레임(cmd, payload) 뒤에 room 번 채팅 채널의 최근 메시지 최대 n 개를 이어 붙여 한 번에 전달
+// => 응답과 다시 보내는 메시지가 한 번의 send (fork 모드 : 링 쓰기 1회) 로 나가며, 클라이언트는 응답 문구 다음에 메시지들을 순서대로 받음
+void send_cmd_with_history(int idx, int cmd, const char* payload, int room, uint32_t n) {
+    static char replay[FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD];
+    size_t frame_len = frame_encode(replay, sizeof(replay), cmd, payload, strlen(payload));
+    if (frame_len == 0) {
+        return;
+    }
+    uint32_t count;
+    size_t history_len = room_history_read(&room_history, room, n, replay + frame_len, HISTORY_REPLAY_MAX, &count, NULL);
+    send_to_client(idx, replay, frame_len + history_len);
+    // chat-dev13 : send_to_client 는 앞의 응답 프레임만 세므로 이어 붙인 채널 메시지 프레임 수를 더함
+    stats_add(&server_stats->frames_out[CMD_MSG], count);
+    stats_add(&server_stats->clients[idx].frames_out, count);
+}
+
+// chat-dev23 : 명령어별 처리 함수 (기존 process_client_message 의 if / else 분기를 명령어마다 분리)
+// i : 메시지를 보낸 client index, c : command_parse 가 payload 를 복사 없이 나눈 인자
+
+// 닉네임 중복 검사 처리
+void handle_nick(int i, const Command* c) {
+    // chat-dev11 : 저장될 길이로 자른 닉네임으로 인덱스 조회 (클라이언트 수와 무관한 O(1))
+    // chat-dev23 : 자른 길이만큼 payload 를 그대로 조회하고, 중복이 아닐 때만 슬롯에 기록
+    size_t len = c->arg.len < sizeof(clients[i].nickName) - 1 ? c->arg.len : sizeof(clients[i].nickName) - 1;
+    int owner = name_index_find_n(nick_index, c->arg.ptr, len);
+    int is_dup = (owner != NAME_INDEX_EMPTY && owner != i);
+
+    if(is_dup){ // 중복
+        send_cmd_to_client(i, CMD_NICK, "DUP");
+        return;
+    }
+    // 중복이 아닐 때 nickName 부여 (이전 닉네임은 인덱스에서 삭제 후 새 닉네임 등록)
+    release_client_nick(i);
+    memcpy(clients[i].nickName, c->arg.ptr, len);
+    clients[i].nickName[len] = '\0';
+    name_index_insert(nick_index, clients[i].nickName, i);
+    // 중복 처리 결과를 i 번 클라이언트에게 전달
+    send_cmd_to_client(i, CMD_NICK, "OK");
+}
+
+// 같은 채팅 채널에 채팅 메시지 브로드캐스트
+void handle_msg(int i, const Command* c) {
+    // 같은 채팅 채널에만 전송하기 위해서 사용할 임시 변수 sender_room
+    int sender_room = clients[i].room_idx;
+
+    // chat-dev2 : 채팅을 보낼 때 무슨 채팅 채널에서 보냈는지 를 닉네임 앞에 추가함
+    // chat-dev7 : 브로드캐스트 프레임은 한 번만 인코딩하고 같은 바이트를 방의 모든 클라이언트에게 전달
+    // chat-dev23 : 닉네임, 메시지 view 를 프레임 버퍼에 바로 써서 인코딩 (중간 문자열 버퍼 없음)
+    // chat-dev24 : 프레임 버퍼는 풀 버퍼 (채널 이름, 번호, 닉네임, 메시지 길이로 크기를 정함) - 멤버 송신 큐들이 같은 버퍼를 참조
+    size_t cap = strlen(rooms[sender_room].roomName) + 32 + c->nick.len + c->arg.len;
+    MsgBuf* b = msgbuf_alloc(FRAME_HEADER_SIZE + cap);
+    if (b == NULL) {
+        return;
+    }
+    int n = snprintf(b->data + FRAME_HEADER_SIZE, cap, "%s 채널(%d) %.*s:%.*s",
+                     rooms[sender_room].roomName, sender_room, (int)c->nick.len, c->nick.ptr, (int)c->arg.len, c->arg.ptr);
+    if (n >= 0 && (size_t)n < cap) {
+        frame_put_header(b->data, CMD_MSG, n);
+        b->len = FRAME_HEADER_SIZE + n;
+        // chat-dev9 : 같은 채팅 공간의 클라이언트들에게 전달 (fork 모드는 방 로그에 한 번만 씀)
+        broadcast_to_room(sender_room, b);
+    }
+    msgbuf_release(b);
+}
+
+// chat-dev2 : /add 채팅 채널 추가
+// 서버에서 체크 사항 : 채팅 채널 최대 수용량 체크, 채팅 채널 이름 중복 여부 확인 후
+// 허용 가능할 때 roomData 의 is_active 를 활성화시키고, 요청한 클라이언트의 clientData 의 room_idx 를 해당 room 으로 변경한다.
+void handle_add(int i, const Command* c) {
+    char sendMsg[500];
+    int is_valid = 0; // 채팅 채널 개설 가능 여부 변수
+    int is_duplicate = 0;
+
+    // chat-dev11 : 채팅 채널 이름 중복 여부는 이름 인덱스로, 채팅 채널 최대 수용량은 free list 로 확인 (채널 수와 무관한 O(1))
+    // => 저장될 길이로 자른 이름으로 확인하여 이름이 잘린 채널끼리 중복되지 않도록 함
+    char roomName[sizeof(rooms[0].roomName)];
+    snprintf(roomName, sizeof(roomName), "%.*s", (int)sizeof(roomName) - 1, c->arg.ptr);
+    if(find_room(roomName) >= 0){
+        // 중복 처리
+        is_duplicate = 1;
+    } else {
+        int k = create_room(roomName);
+        if(k >= 0){
+            // 허용 가능 - free list 에서 꺼낸 채팅 채널 활성화
+            is_valid = 1;
+            set_client_room(i, k); // 클라이언트의 채팅 채널 위치 변경
+
+            snprintf(sendMsg, sizeof(sendMsg), "%d 번째 %s 채팅 채널을 만들고 입장했습니다.", k, rooms[k].roomName);
+        }
+    }
+
+    // 비활성 채팅 채널 없음 (free list 가 빔)
+    if(is_duplicate){
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "중복된 채팅 채널 이름입니다.\n");
+    }
+    else if(is_valid == 0){
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "채팅 채널 최대 수용량을 초과하였습니다.\n");
+    }
+
+    // 서버에서 처리(컨트롤) 후 결과를 요청한 클라이언트에게 전달
+    send_cmd_to_client(i, CMD_ADD, sendMsg);
+}
+
+// chat-dev3 : /LEAVE 명령어. 현재 클라이언트가 로비 채널이 아닌 채팅 채널에 있을 때만, 로비 채널로 이동 시켜 준다.
+void handle_leave(int i, const Command* c) {
+    char sendMsg[500];
+
+    // 이미 로비에서 Leave 명령어 수행 시 동작하지 않음
+    if(strcmp(c->arg.ptr, "lobby") == 0){
+        if(clients[i].room_idx == 0){
+            snprintf(sendMsg, sizeof(sendMsg), "%s", "이미 로비(lobby) 채널에 있는 유저입니다.");
+        } else {
+            // 로비가 아닌 다른 채팅 채널에 있는 클라이언트일 경우 로비 채널로 이동
+            set_client_room(i, 0);
+            snprintf(sendMsg, sizeof(sendMsg), "%s", "로비(lobby) 채널로 이동합니다.");
+            // chat-dev14 : 응답 뒤에 로비의 최근 메시지를 이어서 전달
+            send_cmd_with_history(i, CMD_LEAVE, sendMsg, 0, history_msgs);
+            return;
+        }
+    } else {
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "잘못된 명령 문구를 입력했습니다.");
+    }
+
+    send_cmd_to_client(i, CMD_LEAVE, sendMsg);
+}
+
+// chat-dev4 : /RM 명령어. 로비 채널이 아닌 채팅 채널에 있을 때만, 로비 채널로 이동 시켜 줌
+void handle_rm(int i, const Command* c) {
+    char sendMsg[BUFSIZ + 100];
+    const char* name = c->arg.ptr;
+
+    if(strcmp(name, "lobby") == 0){
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "로비(lobby) 채널은 삭제할 수 없습니다.");
+    } else {
+        // 로비가 아닌 다른 채팅 채널의 이름일 경우 해당 채팅 채널을 지우고
+        // chat-dev11 : 이름 인덱스로 채널 번호 조회
+        int rm_i = find_room(name);
+        int is_valid = (rm_i > 0);
+        // 해당 채팅 채널에 있던 유저들을 로비로 내보낸다.
+        if(is_valid){
+            int is_findUser = (rooms[rm_i].member_head >= 0);
+            // 채팅 채널에 포함된 유저들을 로비로 내보냄
+            // chat-dev11 : 멤버 리스트의 첫 멤버를 로비로 옮기면 리스트에서 빠지므로 리스트가 빌 때까지 반복
+            while(rooms[rm_i].member_head >= 0){
+                set_client_room(rooms[rm_i].member_head, 0);
+            }
+
+            if(is_findUser){ // 삭제된 채팅 채널에 유저가 있었을 때의 처리
+                snprintf(sendMsg, sizeof(sendMsg), "%s 채널이 삭제되었으며, 해당 채팅 채널 유저는 로비로 이동됩니다.", rooms[rm_i].roomName);
+            } else { // 삭제된 채팅 채널에 유저가 없었을 때의 처리
+                snprintf(sendMsg, sizeof(sendMsg), "%s 채널이 삭제되었으며, 해당 채팅 채널 에는 유저가 없었습니다.", rooms[rm_i].roomName);
+            }
+            // chat-dev11 : 채널 비활성화, 이름 초기화 후 채널 번호를 free list 에 반환
+            delete_room(rm_i);
+        } else { // 삭제하려는 채팅 채널이 없음(입력한 채팅 채널 이름이 잘못됨)
+            snprintf(sendMsg, sizeof(sendMsg), "%s 이름을 가진 채팅 채널이 없습니다.", name);
+        }
+    }
+    send_cmd_to_client(i, CMD_RM, sendMsg);
+}
+
+// chat-dev4 : /USERS all - 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보(해당 유저가 접속한 채팅방, 유저 이름) 를 출력
+//             /USERS 채팅방이름 - 해당 채팅 채널방에 속해 있는 모든 클라이언트 유저 정보를 출력
+void handle_user(int i, const Command* c) {
+    // chat-dev24 : 응답은 풀 버퍼의 프레임 헤더 뒤에 바로 작성
+    const size_t cap = 1024 * 5;
+    MsgBuf* b = msgbuf_alloc(FRAME_HEADER_SIZE + cap);
+    if (b == NULL) {
+        return;
+    }
+    char* sendMsg = b->data + FRAME_HEADER_SIZE;
+    const char* name = c->arg.ptr;
+
+    // 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보를 응답에 작성
+    if(strcmp(name, "all") == 0){
+        size_t used = snprintf(sendMsg, cap, "%s", "전체 유저 정보\n");
+        for(int client_i = 0; client_i < client_reserve; client_i++){
+            if(clients[client_i].pid > 0){
+                char tempBuf[BUFSIZ * 2];
+                snprintf(tempBuf, sizeof(tempBuf), "<USER : %s>   [Channel : %s]\n", clients[client_i].nickName, rooms[clients[client_i].room_idx].roomName);
+                if(append_list_line(sendMsg, cap, &used, tempBuf) < 0){
+                    break; // chat-dev11 : 응답 버퍼가 가득 차면 이후 유저는 생략
                 }
-                // chat-dev2 : 채팅 채널 개설 명령 추가
-                // 서버에서 체크 사항 : 채팅 채널 최대 수용량 체크, 채팅 채널 이름 중복 여부 확인 후  
-                // 허용 가능할 때 roomData 의 is_active 를 활성화시키고, 요청한 클라이언트의 clientData 의 room_idx 를 해당 room 으로 변경한다. 
-            } else if(strcmp(ch, "ADD") == 0){
-                // chat-dev2 : 클라이언트의 부모 프로세스로 부터 받은 문자열을 받고 
-                // 명령어에 따라 문자열 파싱 + 파이프에 write + 현재(서버)의 부모 프로세스로 시그널 알림 동작이 발생함
-                // chat-dev2 : /add 채팅 채널 추가
-                // 서버에서 체크 사항 : 채팅 채널 최대 수용량 체크, 채팅 채널 이름 중복 여부 확인 후  
-                // 허용 가능할 때 roomData 의 is_active 를 활성화시키고, 요청한 클라이언트의 clientData 의 room_idx 를 해당 room 으로 변경한다. 
-                
-                char sendMsg[500];
-                int is_valid = 0; // 채팅 채널 개설 가능 여부 변수
-                int is_duplicate = 0;
-
-                // 채팅 채널 최대 수용량 및 채팅 채널 이름 중복 여부 확인
-                int k;
-                for (k = 0; k < MAX_ROOMS; k++){
-                    if(strcmp(rooms[k].roomName, str) == 0){
-                        // 중복 처리
-                        is_duplicate = 1;
-                        break;
-                    }
-                    if(rooms[k].is_active == 0){
-                        // 허용 가능
-                        // is_active = 0 이므로 채팅 채널 활성화 가능
-                        is_valid = 1;
-                        rooms[k].is_active = 1;
-                        strcpy(rooms[k].roomName, str); // 활성화한 채팅 채널 이름 변경
-                        clients[i].room_idx = k; // 클라이언트의 채팅 채널 위치 변경
-
-                        snprintf(sendMsg, sizeof(sendMsg), "/ADD %d 번째 %s 채팅 채널을 만들고 입장했습니다.", k, rooms[k].roomName);
-                        break;
-                    }
+            }
+        }
+    } // 특정 채팅방의 유저 정보를 출력 (없을 경우 그에 따른 문구 출력)
+    else {
+        int is_empty = 1;
+        size_t used = 0;
+        // chat-dev11 : 이름 인덱스로 채팅 채널을 찾고 해당 채널의 멤버 리스트만 순회
+        int room_i = find_room(name);
+        for(int client_i = room_i >= 0 ? rooms[room_i].member_head : -1; client_i >= 0; client_i = clients[client_i].room_next){
+            char tempBuf[BUFSIZ * 2];
+            if(is_empty){
+                is_empty = 0;
+                used = snprintf(sendMsg, cap, "채널 [%s] 유저 정보\n", name);
+            }
+            snprintf(tempBuf, sizeof(tempBuf), "<USER : %s>   [Channel : %s]\n", clients[client_i].nickName, rooms[room_i].roomName);
+            if(append_list_line(sendMsg, cap, &used, tempBuf) < 0){
+                break;
+            }
+        }
+        if(is_empty){
+            snprintf(sendMsg, cap, "[%s] 채팅 채널은 존재하지 않거나, 인원이 없는 채팅 채널방입니다.", name);
+        }
+    }
+    send_cmd_buf(i, CMD_USER, b, strlen(sendMsg));
+    msgbuf_release(b);
+}
+
+// chat-dev4 : /LIST all : 모든 채팅방 리스트를 출력함, all 이 아닐 경우 경고 문구 출력
+void handle_list(int i, const Command* c) {
+    // chat-dev24 : 응답은 풀 버퍼의 프레임 헤더 뒤에 바로 작성
+    const size_t cap = BUFSIZ * 10;
+    MsgBuf* b = msgbuf_alloc(FRAME_HEADER_SIZE + cap);
+    if (b == NULL) {
+        return;
+    }
+    char* sendMsg = b->data + FRAME_HEADER_SIZE;
+
+    if(strcmp(c->arg.ptr, "all") == 0){
+        size_t used = snprintf(sendMsg, cap, "%s", "***** 모든 채팅 채널방 리스트를 출력합니다. ***** \n");
+        for(int room_i = 0; room_i < room_capacity; room_i++){
+            char tempBuf[BUFSIZ * 2];
+            // 활성화된 방의 리스트를 모두 모아서 출력한다.
+            if(rooms[room_i].is_active){
+                snprintf(tempBuf, sizeof(tempBuf), "[%s] 채널\n", rooms[room_i].roomName);
+                if(append_list_line(sendMsg, cap, &used, tempBuf) < 0){
+                    break; // chat-dev11 : 응답 버퍼가 가득 차면 이후 채널은 생략
                 }
+            }
+        }
+    } else {
+        snprintf(sendMsg, cap, "%s", "채널방 리스트 출력 명령을 잘못 입력했습니다.");
+    }
+    send_cmd_buf(i, CMD_LIST, b, strlen(sendMsg));
+    msgbuf_release(b);
+}
+
+// chat-dev13 : /STATS all : 서버 지표 요약 (연결 수, 명령어별 메시지 수, fan-out, 처리 시간, 전달 대기 바이트)
+void handle_stats(int i, const Command* c) {
+    char sendMsg[BUFSIZ * 2];
+
+    if(strcmp(c->arg.ptr, "all") == 0){
+        stats_render_summary(sendMsg, sizeof(sendMsg), server_mode_name(), stats_client_info);
+    } else {
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "서버 지표 출력 명령을 잘못 입력했습니다. (/STATS all)");
+    }
+    send_cmd_to_client(i, CMD_STATS, sendMsg);
+}
+
+// chat-dev14 : /HISTORY n : 현재 채팅 채널의 최근 메시지 최대 n 개를 안내 문구 뒤에 이어서 다시 전달
+void handle_history(int i, const Command* c) {
+    char sendMsg[BUFSIZ];
+    long n = c->number; // chat-dev23 : 숫자가 아니면 -1
+    int room = clients[i].room_idx;
+
+    if(history_msgs == 0){
+        snprintf(sendMsg, sizeof(sendMsg), "%s", "서버가 최근 메시지를 기록하지 않도록 설정되어 있습니다.");
+    } else if(n < 1 || n > history_msgs){
+        snprintf(sendMsg, sizeof(sendMsg), "최근 메시지 개수는 1 ~ %d 사이의 숫자로 입력해주세요. (/HISTORY 개수)", history_msgs);
+    } else {
+        uint32_t stored;
+        size_t stored_bytes;
+        room_history_usage(&room_history, room, &stored, &stored_bytes);
+        snprintf(sendMsg, sizeof(sendMsg), "[%s] 채널의 최근 메시지 %u 건", rooms[room].roomName, stored < n ? stored : (uint32_t)n);
+        send_cmd_with_history(i, CMD_HISTORY, sendMsg, room, n);
+        return;
+    }
+    send_cmd_to_client(i, CMD_HISTORY, sendMsg);
+}
+
+// chat-dev4 : /JOIN 채팅방이름 : 클라이언트가 기존 채팅 채널에서 새 채널로 이동한다.
+// 단, 기존과 동일한 채널을 선택하거나 없는 채널방이름을 입력했을 땐 그에 따른 주의 문구를 출력함
+void handle_join(int i, const Command* c) {
+    char sendMsg[BUFSIZ];
+    const char* name = c->arg.ptr;
+
+    // 목적지 채널은 활성화되었지만, 클라이언트가 이미 목적지 채팅채널에 있을 때 처리
+    if(rooms[clients[i].room_idx].is_active &&
+        strcmp(rooms[clients[i].room_idx].roomName, name) == 0){
+        snprintf(sendMsg, sizeof(sendMsg), "이미 [%s] 채팅 채널에 있습니다.", name);
+    }
+    // 목적지 채널도 활성화되어있고, 클라이언트가 현재 있는 채널과 목적지 채널이 다를 때(정상)
+    else if(rooms[clients[i].room_idx].is_active &&
+        strcmp(rooms[clients[i].room_idx].roomName, name) != 0){
+        snprintf(sendMsg, sizeof(sendMsg), "[%s] 채팅 채널에 참가했습니다.", name);
+        // client data 변경 진행 (채팅 채널 이동)
+        // chat-dev11 : 이름 인덱스로 목적지 채널 조회
+        int room_i = find_room(name);
+        if(room_i >= 0){
+            // 채널 이동
+            set_client_room(i, room_i);
+            // chat-dev14 : 응답 뒤에 참가한 채널의 최근 메시지를 이어서 전달
+            send_cmd_with_history(i, CMD_JOIN, sendMsg, room_i, history_msgs);
+            return;
+        }
+        // 목적지 채널이 비활성화이거나, 입력한 채널명을 가진 채팅채널이 없을 때 처리
+        snprintf(sendMsg, sizeof(sendMsg), "[%s] 채팅 채널이 비활성화이거나, 해당 채팅 채널이 존재하지 않습니다.", name);
+    } else {
+        snprintf(sendMsg, sizeof(sendMsg), "[%s] 잘못된 채팅 채널명을 입력했습니다.", name);
+    }
+
+    send_cmd_to_client(i, CMD_JOIN, sendMsg);
+}
+
+// chat-dev5 : /WHISPER 사용자이름 메시지 - 서버에 접속한 사용자에게만 귓속말 전달
+void handle_whisper(int i, const Command* c) {
+    // 같은 채팅 채널에만 전송하기 위해서 사용할 임시 변수 sender_room
+    int sender_room = clients[i].room_idx;
+    char sendMsg[BUFSIZ * 3];
+
+    // 귓속말을 받을 대상 닉네임을 명령어 사용 방법(/WHISPER 대상닉네임 메시지) 대로 입력하지 못함. (대상닉네임과 메시지 사이의 공백이 없음)
+    if(c->arg.ptr == NULL){
+        snprintf(sendMsg, sizeof(sendMsg), "From_%.*s: %s", (int)c->nick.len, c->nick.ptr, "명령어 사용 방법(/WHISPER 대상닉네임 메시지) 대로 입력했는지 다시 확인해주세요.");
+        send_cmd_to_client(i, CMD_WHISPER, sendMsg);
+        return;
+    }
+
+    // whisper 하려는 대상이 현재 접속 유저 중에 있는지 find
+    // chat-dev11 : 전체 슬롯 strcmp 대신 닉네임 인덱스로 귓속말 대상 클라이언트의 clients 인덱스 조회
+    // chat-dev23 : 대상 닉네임 view 를 복사 없이 조회
+    int find_user = name_index_find_n(nick_index, c->target.ptr, c->target.len);
+    if(find_user == i){
+        find_user = NAME_INDEX_EMPTY; // 자기 자신한테는 귓속말 불가
+    }
+
+    // 귓속말을 하려는 클라이언트가 접속 중이고(인덱스에 등록됨), 귓속말 요청 클라이언트 자신이 아닐 경우(정상)
+    if(find_user != NAME_INDEX_EMPTY){
+        // chat-dev2 : 채팅을 보낼 때 무슨 채팅 채널에서 보냈는지 를 닉네임 앞에 추가함
+        snprintf(sendMsg, sizeof(sendMsg), "[귓속말] - %s 채널(%d) %.*s:%.*s", rooms[sender_room].roomName, sender_room,
+                 (int)c->nick.len, c->nick.ptr, (int)c->arg.len, c->arg.ptr);
+        // 귓속말 수신 대상 클라이언트에게 전달하고
+        send_cmd_to_client(find_user, CMD_WHISPER, sendMsg);
+        // 귓속말을 보낸 클라이언트에도 전달하여 대화를 주고받도록 함
+        send_cmd_to_client(i, CMD_WHISPER, sendMsg);
+    } else { // 귓속말을 받을 클라이언트가 없음(수신 대상 없을 때)
+        snprintf(sendMsg, sizeof(sendMsg), "To_%.*s: %s", (int)c->target.len, c->target.ptr, "사용자가 접속 중인 닉네임을 정확하게 입력하지 않거나 자기 자신한테는 귓속말을 할 수 없습니다.");
+        // 귓속말을 받을 대상 클라이언트가 없을 때는 귓속말을 보낸 클라이언트에게만 전달
+        send_cmd_to_client(i, CMD_WHISPER, sendMsg);
+    }
+}
+
+// chat-dev22 : CAPS 기능목록 - 클라이언트가 지원하는 기능 중 서버가 켠 기능으로 협상하고 협상한 기능 목록을 응답
+void handle_caps(int i, const Command* c) {
+    char sendMsg[100];
+    sendMsg[0] = '\0';
+
+    // payload 는 공백으로 구분한 기능 이름 목록 (모르는 기능은 무시)
+    int want_lz = 0;
+    const char* p = c->arg.ptr;
+    const char* end = p + c->arg.len;
+    while(p < end){
+        const char* space = memchr(p, ' ', end - p);
+        size_t n = space != NULL ? (size_t)(space - p) : (size_t)(end - p);
+        if(n == strlen("lz4") && memcmp(p, "lz4", n) == 0){
+            want_lz = 1;
+        }
+        p += n + 1;
+    }
+    if(want_lz && compress_enabled){
+        if(!(clients[i].caps & CLIENT_CAP_LZ)){
+            clients[i].caps |= CLIENT_CAP_LZ;
+            rooms[clients[i].room_idx].lz_member_count++;
+        }
+        snprintf(sendMsg, sizeof(sendMsg), "lz4 min=%d", compress_min);
+    }
+    send_cmd_to_client(i, CMD_CAPS, sendMsg);
+}
+
+// chat-dev27 : 타이머 휠 시각 (ms, monotonic)
+uint64_t heartbeat_now_ms() {
+    return stats_now_ns() / 1000000;
+}
+
+// chat-dev27 : idx 번 연결의 다음 확인 시각으로 타이머 예약 (다음 PING 시각과 유휴 시간 제한 중 빠른 쪽)
+void heartbeat_schedule(int idx) {
+    ClientHeartbeat* hb = &heartbeats[idx];
+    uint64_t next = UINT64_MAX;
+    if (ping_interval > 0) {
+        uint64_t last = hb->last_ping_ms > hb->last_active_ms ? hb->last_ping_ms : hb->last_active_ms;
+        next = last + (uint64_t)ping_interval * 1000;
+    }
+    if (idle_timeout > 0 && hb->last_active_ms + (uint64_t)idle_timeout * 1000 < next) {
+        next = hb->last_active_ms + (uint64_t)idle_timeout * 1000;
+    }
+    timer_wheel_add(&timers, &hb->timer, next);
+}
+
+// chat-dev27 : 타이머 만료 - 유휴 시간 제한을 넘었으면 연결 종료, PING 시각이 지났으면 PING 전송 후 다시 예약
+// => 예약한 뒤 프레임을 받았으면 (heartbeat_touch) 아무것도 하지 않고 마지막 수신 시각 기준으로 다시 예약만 함
+void heartbeat_expired(void* arg) {
+    int idx = (int)((ClientHeartbeat*)arg - heartbeats);
+    ClientHeartbeat* hb = &heartbeats[idx];
+    if (clients[idx].pid == 0) {
+        return;
+    }
+    uint64_t now = heartbeat_now_ms();
+    if (idle_timeout > 0 && now - hb->last_active_ms >= (uint64_t)idle_timeout * 1000) {
+        log_write(LOG_WARNING, "클라이언트 index %d (nick: %s) 로부터 %d 초 동안 응답이 없어 연결을 종료합니다.", idx, clients[idx].nickName, idle_timeout);
+        stats_add(&server_stats->idle_disconnects, 1);
+        if (server_mode == SERVER_MODE_FORK) {
+            kill(clients[idx].pid, SIGTERM); // 자식이 소켓을 닫고 종료하면 SIGCHLD 처리(handle_sigchld) 에서 슬롯 회수
+        } else {
+            epoll_close_client(idx);
+        }
+        return;
+    }
+    if (ping_interval > 0) {
+        uint64_t last = hb->last_ping_ms > hb->last_active_ms ? hb->last_ping_ms : hb->last_active_ms;
+        if (now - last >= (uint64_t)ping_interval * 1000) {
+            send_cmd_to_client(idx, CMD_PING, "");
+            hb->last_ping_ms = now;
+            stats_add(&server_stats->heartbeat_pings, 1);
+        }
+    }
+    heartbeat_schedule(idx);
+}
+
+// chat-dev27 : 새 연결의 heartbeat 타이머 시작 (타이머 휠을 사용하지 않으면 아무것도 하지 않음)
+void heartbeat_start(int idx) {
+    if (timer_fd < 0) {
+        return;
+    }
+    ClientHeartbeat* hb = &heartbeats[idx];
+    timer_entry_init(&hb->timer, heartbeat_expired, hb);
+    hb->last_active_ms = heartbeat_now_ms();
+    hb->last_ping_ms = 0;
+    heartbeat_schedule(idx);
+}
+
+// chat-dev27 : 프레임을 받은 시각 기록 (타이머는 옮기지 않음 - 프레임마다 휠을 건드리지 않도록 만료될 때 다시 계산)
+void heartbeat_touch(int idx) {
+    heartbeats[idx].last_active_ms = heartbeat_now_ms();
+}
+
+// chat-dev27 : 타이머 휠과 tick 타이머 생성 (--ping-interval, --idle-timeout 이 모두 0 이면 만들지 않음)
+// 반환 : 타이머 fd, -1 사용 안 함 (생성 실패 시 응답 없는 연결을 정리하지 않고 동작)
+int server_timer_open() {
+    if (ping_interval == 0 && idle_timeout == 0) {
+        return -1;
+    }
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0) {
+        log_write(LOG_WARNING, "[pid %d] 타이머 휠 타이머 생성 실패 - 응답 없는 연결을 정리하지 않습니다. (%s)", getpid(), strerror(errno));
+        return -1;
+    }
+    struct itimerspec its;
+    its.it_interval.tv_sec = TIMER_TICK_MS / 1000;
+    its.it_interval.tv_nsec = (long)(TIMER_TICK_MS % 1000) * 1000000;
+    its.it_value = its.it_interval;
+    timerfd_settime(timer_fd, 0, &its, NULL);
+    timer_wheel_init(&timers, heartbeat_now_ms(), TIMER_TICK_MS);
+    return timer_fd;
+}
+
+// chat-dev27 : tick 타이머 만료 - 지금까지 지난 tick 의 타이머 실행
+void server_timer_expired() {
+    uint64_t expirations;
+    while (read(timer_fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+    }
+    timer_wheel_advance(&timers, heartbeat_now_ms());
+}
+
+// chat-dev27 : PING - 클라이언트가 보낸 PING 에는 같은 payload 로 PONG 응답 (서버가 보낸 PING 의 응답 PONG 은 처리할 것 없음)
+void handle_ping(int i, const Command* c) {
+    send_cmd_to_client(i, CMD_PONG, c->arg.ptr);
+}
+
+// chat-dev23 : 명령어 번호 → 처리 함수 표 (NULL : 응답하지 않는 명령어 - QUIT 은 연결을 가진 쪽이 프레임을 받을 때 처리)
+typedef void (*CommandHandler)(int i, const Command* c);
+
+const CommandHandler command_handlers[CMD_MAX] = {
+    [CMD_NICK] = handle_nick,
+    [CMD_MSG] = handle_msg,
+    [CMD_ADD] = handle_add,
+    [CMD_LEAVE] = handle_leave,
+    [CMD_RM] = handle_rm,
+    [CMD_USER] = handle_user,
+    [CMD_LIST] = handle_list,
+    [CMD_JOIN] = handle_join,
+    [CMD_WHISPER] = handle_whisper,
+    [CMD_STATS] = handle_stats,
+    [CMD_HISTORY] = handle_history,
+    [CMD_CAPS] = handle_caps,
+    [CMD_PING] = handle_ping,
+};
+
+// chat-dev6 : 클라이언트 명령어 처리(프로토콜 처리 허브) - sigusr1_handler(-> fork_read_child) 에서 분리
+// => fork 모드의 fork_read_child 와 epoll 모드의 이벤트 루프가 같은 명령어 처리(/NICK, /MSG, /ADD ...) 를 공유함
+// chat-dev7 : 명령어는 프레임의 명령어 바이트로 구분하고, payload 가 곧 명령어 인자 문자열
+// chat-dev23 : payload 를 복사하지 않고 명령어별 인자 형식대로 나눈 뒤 명령어 번호로 처리 함수 표에서 바로 호출 (strcmp 분기 없음)
+// => 인자 형식이 맞지 않거나 길이 제한을 넘으면 처리하지 않고 CMD_ERROR 로 알림 (연결은 유지)
+// i : 메시지를 보낸 client index, cmd : 프레임 명령어 바이트, payload : 프레임 payload (len 바이트, 뒤에 NUL)
+void process_client_message(int i, int cmd, const char* payload, size_t len) {
+    heartbeat_touch(i); // chat-dev27 : 어떤 프레임이든 받으면 살아 있는 연결
+    Command c;
+    int ret = command_parse(cmd, payload, len, &c);
+    if (ret == COMMAND_ERR_UNKNOWN || command_handlers[cmd] == NULL) {
+        return;
+    }
+    if (ret != COMMAND_OK) {
+        log_write(LOG_WARNING, "클라이언트 index %d 의 /%s 명령어 인자가 잘못되어 처리하지 않습니다. (%s)", i, frame_cmd_name(cmd), command_error_name(ret));
+        send_cmd_to_client(i, CMD_ERROR, "잘못된 명령어 형식입니다.");
+        return;
+    }
+    command_handlers[cmd](i, &c);
+}
+
+// 4단계 -> chat-dev8 : 자식 → 부모 메시지 수신 (기존 SIGUSR1 핸들러 대체)
+// 자식이 공유 메모리 링에 프레임을 쓰고 eventfd 로 알리면 부모의 epoll 메인 루프에서 호출됨
+// => 명령어 처리가 시그널 핸들러 문맥이 아닌 메인 루프에서 수행되므로 시그널 합쳐짐(coalescing) 문제가 없음
+// chat-dev1 : 메시지를 읽고 메시지 명령어에 해당하는 동작을 취하도록 함 -> 프로토콜 처리 허브 역할
+void fork_read_child(int i) {
+    IpcChannel* ch = &ipc_to_parent[i];
+    ipc_channel_clear_event(ch);
+
+    // 링에 쌓인 데이터를 프레임 디코더로 옮기고 완성된 프레임만 한 개씩 처리
+    // => 자식은 프레임 단위로만 링에 쓰지만, 디코더를 거쳐 여러 프레임이 붙어 있어도 경계를 정확히 나눔
+    while (clients[i].pid > 0) {
+        const char* p1;
+        const char* p2;
+        size_t n1, n2;
+        if (shm_ring_peek(ch->ring, &p1, &n1, &p2, &n2) == 0) {
+            break; // 더 이상 읽을 게 없으면 break
+        }
+        // 디코더 버퍼가 최대 프레임 2개 크기를 넘지 않도록 한 번에 최대 프레임 1개 분량씩 옮김
+        if (n1 > FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD) {
+            n1 = FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD;
+        }
+        frame_decoder_feed(&client_in[i], p1, n1);
+        shm_ring_consume(ch->ring, n1);
+
+        Frame frame;
+        int ret;
+        while ((ret = frame_decoder_next(&client_in[i], &frame)) == 1) {
+            log_write(LOG_INFO, "클라이언트 index %d 로부터 메시지 수신을 담당 서버 자식프로세스로부터 받음 : /%s %.*s", i, frame_cmd_name(frame.cmd), BUFSIZ, frame.payload);
+
+            // chat-dev6 : 명령어 처리는 fork / epoll 모드 공용 함수에서 수행
+            uint64_t started = stats_now_ns();
+            process_client_message(i, frame.cmd, frame.payload, frame.len);
+            stats_add(&server_stats->frames_in[frame.cmd], 1); // chat-dev13 : 명령어별 요청 수, 처리 시간
+            stats_hist_add(&server_stats->handler_ns, stats_now_ns() - started);
+        }
+        if (ret < 0) {
+            // 자식은 검증된 프레임만 전달하므로 발생하지 않아야 함 - 남은 데이터를 버리고 디코더 초기화
+            log_write(LOG_ERROR, "클라이언트 index %d 링에서 잘못된 프레임을 받아 버퍼를 초기화합니다.", i);
+            frame_decoder_free(&client_in[i]);
+        }
+    }
+}
+
+// chat-dev16 : 클라이언트 소켓 - 모아 보낸 데이터가 Nagle 알고리즘으로 다시 지연되지 않도록 TCP_NODELAY 설정
+void set_client_nodelay(int fd) {
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+// chat-dev16 : 모으기 시간 타이머 생성 (--coalesce-us 가 0 이면 만들지 않음)
+// 반환 : 타이머 fd, -1 사용 안 함 (생성 실패 시 지연 우선 모드로 동작)
+int coalesce_timer_open() {
+    if (coalesce_us == 0) {
+        return -1;
+    }
+    coalesce_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (coalesce_timer_fd < 0) {
+        log_write(LOG_WARNING, "[pid %d] 전송 모으기 타이머 생성 실패 - 모으지 않고 바로 전송합니다. (%s)", getpid(), strerror(errno));
+        coalesce_us = 0;
+    }
+    coalesce_timer_armed = 0;
+    return coalesce_timer_fd;
+}
+
+// chat-dev16 : 모으기 시간 타이머 시작 (이미 시작된 경우 그대로 두어 처음 쌓인 데이터 기준으로 최대 coalesce_us 만 기다림)
+void coalesce_timer_arm() {
+    if (coalesce_timer_armed) {
+        return;
+    }
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = coalesce_us / 1000000;
+    its.it_value.tv_nsec = (long)(coalesce_us % 1000000) * 1000;
+    timerfd_settime(coalesce_timer_fd, 0, &its, NULL);
+    coalesce_timer_armed = 1;
+}
+
+// chat-dev16 : 타이머 만료 처리 (만료 횟수를 읽어 비움)
+void coalesce_timer_expired() {
+    uint64_t expirations;
+    while (read(coalesce_timer_fd, &expirations, sizeof(expirations)) < 0 && errno == EINTR) {
+    }
+    coalesce_timer_armed = 0;
+}
+
+// chat-dev18 : 자식 - 보낸 n 바이트만큼 보낼 구간을 건너뛰고, 일부만 보낸 구간은 남은 부분부터 가리킴
+void child_iov_advance(struct iovec** iov, int* count, size_t n) {
+    while (*count > 0 && n >= (*iov)->iov_len) {
+        n -= (*iov)->iov_len;
+        (*iov)++;
+        (*count)--;
+    }
+    if (*count > 0) {
+        (*iov)->iov_base = (char*)(*iov)->iov_base + n;
+        (*iov)->iov_len -= n;
+    }
+}
+
+// chat-dev9 -> chat-dev16 : 자식 - 모은 데이터를 sendmsg(writev) 한 번으로 클라이언트 소켓에 모두 전송 (기존 child_write_client 대체)
+// more : 이어서 보낼 데이터가 더 있음 (MSG_MORE - 커널이 작은 세그먼트로 바로 내보내지 않고 다음 전송과 합침)
+// => 부모 → 자식 링과 방 로그 두 스트림을 번갈아 전달하므로 프레임이 중간에 끊긴 채 섞이지 않도록 끝까지 씀
+int child_flush_client(int more) {
+    struct iovec* iov = child_iov;
+    int count = child_iov_count;
+    int flags = MSG_NOSIGNAL | (more ? MSG_MORE : 0);
+    int ret = 0;
+
+    if (child_iov_bytes > 0) {
+        stats_hist_add(&server_stats->send_bytes, child_iov_bytes); // chat-dev16
+    }
+    // chat-dev18 : 방 로그를 가리킨 구간이 있으면 막히지 않게 한 번 보낸 뒤, 아직 못 보낸 방 로그 구간은 child_out 으로 복사
+    if (child_zc_bytes > 0) {
+        ssize_t n;
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        while ((n = sendmsg(clients[child_index].client_sock_fd, &msg, flags | MSG_DONTWAIT)) < 0 && errno == EINTR) {
+        }
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            child_send_failed = errno;
+            ret = -1;
+            count = 0;
+        }
+        child_iov_advance(&iov, &count, n > 0 ? n : 0);
+
+        size_t copied = 0;
+        const char* log_start = child_zc_log->data;
+        const char* log_end = log_start + child_zc_log->capacity;
+        for (int i = 0; i < count; i++) {
+            const char* base = iov[i].iov_base;
+            if (base >= log_start && base < log_end) {
+                memcpy(child_out + child_out_len, base, iov[i].iov_len);
+                iov[i].iov_base = child_out + child_out_len;
+                child_out_len += iov[i].iov_len;
+                copied += iov[i].iov_len;
+            }
+        }
+        if (ret == 0 && !room_log_valid(child_zc_log, child_zc_from)) {
+            log_write(LOG_WARNING, "[자식 index %d, pid %d] 채팅 채널(%d) 메시지를 보내는 중 방 로그가 덮어쓰였습니다.", child_index, getpid(), child_room);
+            child_send_failed = EIO;
+            ret = -1;
+            count = 0;
+        }
+        if (ret == 0) {
+            stats_add(&server_stats->room_log_zero_copy_bytes, child_zc_bytes - copied);
+            stats_add(&server_stats->room_log_copy_bytes, copied);
+        }
+        child_zc_log = NULL;
+        child_zc_bytes = 0;
+    }
+    while (count > 0) {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = sendmsg(clients[child_index].client_sock_fd, &msg, flags);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            child_send_failed = errno;
+            ret = -1;
+            break;
+        }
+        child_iov_advance(&iov, &count, n);
+    }
+    if (child_ring_used > 0) {
+        shm_ring_consume(ipc_to_child[child_index].ring, child_ring_used);
+    }
+    child_iov_count = 0;
+    child_iov_bytes = 0;
+    child_out_len = 0;
+    child_ring_used = 0;
+    return ret;
+}
+
+// chat-dev16 : 자식 - 보낼 구간 추가 (바로 앞 구간과 메모리가 이어지면 합침)
+// 호출하는 쪽에서 child_iov 에 자리가 있음을 보장 (링 2 구간 + 방 로그 구간들이라 CHILD_IOV_MAX 를 넘기 전에 전송함)
+void child_gather(const char* data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    child_iov_bytes += len;
+    if (child_iov_count > 0) {
+        struct iovec* last = &child_iov[child_iov_count - 1];
+        if ((const char*)last->iov_base + last->iov_len == data) {
+            last->iov_len += len;
+            return;
+        }
+    }
+    child_iov[child_iov_count].iov_base = (void*)data;
+    child_iov[child_iov_count].iov_len = len;
+    child_iov_count++;
+}
+
+// chat-dev1 -> chat-dev8 : 부모 → 자식 메시지를 클라이언트에게 전달 (기존 SIGUSR2 핸들러 대체)
+// 부모가 링에 쓰고 eventfd 로 알리면 자식의 epoll 루프에서 호출됨
+// chat-dev7 : 부모는 링에 프레임 단위로만 쓰므로 링의 바이트를 그대로 전달해도 프레임 경계가 유지됨
+// chat-dev16 : 링 끝에서 나뉜 두 구간을 복사 없이 보낼 데이터에 추가 (링은 child_flush_client 에서 전송 후 비움)
+void child_deliver_to_client() {
+    IpcChannel* ch = &ipc_to_child[child_index];
+    // 이미 추가한 링 데이터가 아직 전송 전이면 (같은 구간을 다시 가리키지 않도록) 먼저 전송
+    if (child_ring_used > 0 || child_iov_count > CHILD_IOV_MAX - 2) {
+        child_flush_client(1);
+    }
+
+    const char* p1;
+    const char* p2;
+    size_t n1, n2;
+    size_t used = shm_ring_peek(ch->ring, &p1, &n1, &p2, &n2);
+    child_gather(p1, n1);
+    child_gather(p2, n2);
+    child_ring_used = used;
+}
+
+// chat-dev9 : 자식 - 현재 방 로그를 limit 위치까지 클라이언트에게 전달
+// 방 로그는 부모가 계속 덮어쓰므로 지역 버퍼로 복사 후 검증된 완성 프레임만 전송
+// chat-dev16 : 지역 버퍼 대신 child_out 에 이어서 복사하고 보낼 데이터에 추가 (공간이 부족하면 모은 데이터를 먼저 전송)
+// chat-dev18 : zero_copy 이면 가능한 경우 복사하지 않고 방 로그를 가리킴 (전송 후 검증은 child_flush_client)
+void child_deliver_room(uint64_t limit) {
+    RoomLog* log = room_logs[child_room];
+
+    while (child_room_cursor < limit) {
+        if (child_iov_count > CHILD_IOV_MAX - 2) {
+            child_flush_client(1);
+        }
+        // chat-dev18 : 밀린 양이 적으면 완성 프레임 구간 전체를 (부모는 프레임 단위로만 공개하므로 경계 확인 없이) 복사 없이 가리킴
+        size_t lag = limit - child_room_cursor;
+        if (zero_copy && lag <= log->capacity / 2 && lag <= sizeof(child_out) - child_out_len - child_zc_bytes &&
+            (child_zc_log == NULL || child_zc_log == log)) {
+            const char* p1;
+            const char* p2;
+            size_t n1, n2;
+            if (room_log_peek(log, child_room_cursor, limit, &p1, &n1, &p2, &n2) >= 0) {
+                if (child_zc_log == NULL) {
+                    child_zc_log = log;
+                    child_zc_from = child_room_cursor;
+                }
+                child_gather(p1, n1);
+                child_gather(p2, n2);
+                child_zc_bytes += lag;
+                child_room_cursor = limit;
+                break;
+            }
+        }
+        char* buf = child_out + child_out_len;
+        ssize_t n = room_log_read(log, child_room_cursor, limit, buf, sizeof(child_out) - child_out_len - child_zc_bytes);
+        if (n < 0) {
+            // 클라이언트 전송이 밀려 부모가 읽지 않은 메시지를 덮어쓴 경우 - 유실된 만큼 건너뛰고 최신 위치부터 전달
+            log_write(LOG_WARNING, "[자식 index %d, pid %d] 채팅 채널(%d) 메시지 전달이 밀려 일부 메시지가 유실되었습니다.", child_index, getpid(), child_room);
+            stats_add(&server_stats->room_log_overruns, 1); // chat-dev17
+
+            child_room_cursor = room_log_head(log);
+            if (limit < child_room_cursor) {
+                break;
+            }
+            continue;
+        }
+        // 버퍼에 온전히 들어온 프레임까지만 전송 (나머지는 다음 반복에서 다시 읽음)
+        size_t whole = 0;
+        while (whole + FRAME_HEADER_SIZE <= (size_t)n) {
+            uint32_t be_len;
+            memcpy(&be_len, buf + whole, 4);
+            size_t frame_len = FRAME_HEADER_SIZE + ntohl(be_len);
+            if (whole + frame_len > (size_t)n) {
+                break;
+            }
+            whole += frame_len;
+        }
+        if (whole == 0) {
+            if (child_out_len + child_zc_bytes > 0) {
+                child_flush_client(1); // child_out 에 남은 공간이 부족 - 모은 데이터를 보내고 처음부터 다시 복사
+                continue;
+            }
+            break; // 부모는 프레임 단위로만 공개하므로 발생하지 않음
+        }
+        child_out_len += whole;
+        child_gather(buf, whole);
+        child_room_cursor += whole;
+        stats_add(&server_stats->room_log_copy_bytes, whole); // chat-dev18
+    }
+}
+
+// chat-dev9 : 자식 - 부모가 기록한 방 이동 정보를 확인하고 전달할 방 로그와 방 eventfd 감시를 바꿈
+void child_sync_room(int child_epoll_fd) {
+    RoomCursor* rc = &room_cursors[child_index];
+    uint32_t seq;
+    int room, prev_room;
+    uint64_t join_head, leave_head;
+
+    // seqlock 읽기 : 부모가 갱신 중(홀수)이거나 읽는 도중 바뀌었으면 다시 읽음
+    while (1) {
+        seq = __atomic_load_n(&rc->seq, __ATOMIC_ACQUIRE);
+        if (seq == child_room_seq) {
+            return; // 방 이동 없음
+        }
+        if (seq & 1) {
+            continue;
+        }
+        room = __atomic_load_n(&rc->room_idx, __ATOMIC_RELAXED);
+        join_head = __atomic_load_n(&rc->join_head, __ATOMIC_RELAXED);
+        prev_room = __atomic_load_n(&rc->prev_room_idx, __ATOMIC_RELAXED);
+        leave_head = __atomic_load_n(&rc->leave_head, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&rc->seq, __ATOMIC_RELAXED) == seq) {
+            break;
+        }
+    }
+
+    // 이전 방에서 떠나기 전까지 쌓인 메시지는 모두 전달 (확인하기 전에 여러 번 이동한 경우 중간 방 메시지는 생략)
+    if (child_room >= 0) {
+        if (prev_room == child_room) {
+            child_deliver_room(leave_head);
+        }
+        epoll_ctl(child_epoll_fd, EPOLL_CTL_DEL, room_efd[child_room % ROOM_EFD_POOL], NULL);
+    }
+
+    child_room = room;
+    child_room_cursor = join_head;
+    child_room_seq = seq;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLET; // 방 eventfd 는 아무도 read 하지 않으므로 write 될 때마다 한 번씩만 알림 받음
+    ev.data.u32 = 2; // 방 로그
+    epoll_ctl(child_epoll_fd, EPOLL_CTL_ADD, room_efd[child_room % ROOM_EFD_POOL], &ev);
+}
+
+// chat-dev16 : 자식 - 방 이동 반영, 부모 → 자식 링, 현재 방 로그 순서로 전달할 데이터를 모두 모아 한 번에 전송
+// => 전송하는 동안 링에 새로 쓰인 데이터는 (링이 비어 있지 않았으므로) 부모가 알리지 않으므로 링이 빌 때까지 반복
+// chat-dev17 : 반환 0 계속, -1 클라이언트 소켓 전송 실패로 연결 종료
+int child_deliver(int child_epoll_fd) {
+    do {
+        // chat-dev9 : 방 이동 응답보다 먼저 방 이동을 반영 (이전 방 메시지를 응답 전에 모두 전달)
+        child_sync_room(child_epoll_fd);
+        child_deliver_to_client();
+        child_deliver_room(room_log_head(room_logs[child_room]));
+        child_flush_client(0);
+    } while (!child_send_failed && shm_ring_used(ipc_to_child[child_index].ring) > 0);
+
+    if (child_send_failed) {
+        if (child_send_failed == EAGAIN || child_send_failed == EWOULDBLOCK) {
+            log_write(LOG_WARNING, "[자식 index %d, pid %d] 클라이언트가 %d ms 동안 메시지를 받지 않아 연결을 종료합니다. (느린 클라이언트)", child_index, getpid(), slow_timeout_ms);
+            stats_add(&server_stats->slow_disconnects, 1);
+        } else {
+            log_write(LOG_WARNING, "[자식 index %d, pid %d] 클라이언트 전송 실패로 연결을 종료합니다. (%s)", child_index, getpid(), strerror(child_send_failed));
+        }
+        close(clients[child_index].client_sock_fd);
+        return -1;
+    }
+    return 0;
+}
+
+// chat-dev16 : 자식 - 아직 보내지 않은 데이터 크기 (부모 → 자식 링 + 현재 방 로그)
+size_t child_pending_bytes() {
+    return shm_ring_used(ipc_to_child[child_index].ring) + (room_log_head(room_logs[child_room]) - child_room_cursor);
+}
+
+// 5단계 : 좀비 프로세스(부모 프로세스가 종료되어도 자식의 "종료" 상태(ex. pid) 가 커널에 남아 있는 상태 - 자원을 사용하진 않음) 회수용
+// chat-dev1 : sigchld 좀비 프로세스 처리(close for clear) 함수 수정(struct 사용에 따라 수정)
+void handle_sigchld(int signo) {
+    pid_t pid;
+    int status;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+        for (int i = 0; i < client_reserve; i++) {
+            // 파이프 및 클라이언트 소켓 닫기
+            if (clients[i].pid == pid) {
+                log_write(LOG_INFO, "클라이언트 %d (pid: %d, nick: %s) 접속 종료. 자원 회수 완료.", i, pid, clients[i].nickName);
+
+                // chat-dev8 : 자식이 종료 직전에 링에 남긴 메시지를 먼저 처리
+                fork_read_child(i);
+                // 부모는 fork 직후 conn_fd 를 이미 닫았으므로 소켓은 닫지 않음 (같은 번호의 다른 fd 를 닫지 않도록)
+                // 자식과의 IPC 채널(링 + eventfd) 정리
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, ipc_to_parent[i].efd, NULL);
+                ipc_channel_close(&ipc_to_parent[i]);
+                ipc_channel_close(&ipc_to_child[i]);
+                // 해당 pid 가 있는 clients 인덱스 에서 pid 0 처리 포함 memset
+                release_client_slot(i); // chat-dev11 : 채팅 채널 멤버 리스트, 닉네임 인덱스 정리 포함
+                frame_decoder_free(&client_in[i]); // chat-dev7 : 남은 수신 프레임 버퍼 해제
+                memset(&slow_consumers[i], 0, sizeof(SlowConsumer)); // chat-dev17
+                break;
+            }
+        }
+    }
+}
+
+// 6단계 : Graceful shutdown 핸들러 추가
+// 고아 프로세스(부모 프로세스가 먼저 종료된 후 자식 프로세스가 여전히 "실행 중" 인 상태 - 실제 자원을 사용)
+// chat-dev1 : clients struct 데이터 구조에 따른 구조 수정
+void graceful_shutdown_handler(int signo) {
+    // chat-dev10 : workers 모드 최상위 프로세스는 모든 worker 를 종료시키고 회수
+    if (server_mode == SERVER_MODE_WORKERS && worker_index < 0) {
+        workers_shutdown();
+    }
+    log_write(LOG_INFO, "[부모 pid %d] 서버 종료 시그널 수신 : 모든 자식 종료 중 ...", getpid());
+
+    for (int i = 0; i < active_client_count; i++) {
+        // chat-dev6 : epoll 모드는 자식 프로세스가 없으므로 클라이언트 소켓만 닫음
+        // chat-dev10 : workers 모드 worker 는 자신이 소유한 연결만 닫음 (pid 에 자신의 pid 가 기록됨)
+        if (server_mode != SERVER_MODE_FORK) {
+            if (clients[i].pid == getpid()) {
+                close(clients[i].client_sock_fd);
+            }
+            continue;
+        }
+        if (clients[i].pid > 0) {
+            // 활성화된 clients struct 에서 pid 가 활성화된 자식만 종료 요청 
+            kill(clients[i].pid, SIGTERM);
+            waitpid(clients[i].pid, NULL, 0); // 자식 PID 초기화 및 종료될 때까지 기다림
+        }
+    }
+    close(listen_fd);
+    close(file_fd);
+    // chat-dev13 : 관리용 소켓 파일은 소켓을 만든 최상위 프로세스만 삭제
+    if (admin_fd >= 0 && worker_index < 0) {
+        close(admin_fd);
+        unlink(admin_path);
+    }
+    // chat-dev15 : 저널을 연 최상위 프로세스는 모든 자식(worker) 이 종료된 뒤 마지막 스냅샷을 저장하여 다음 시작 시 재생할 저널을 비움
+    if (journal.header != NULL && getpid() == journal.owner) {
+        journal_take_snapshot();
+        journal_close(&journal);
+    }
+
+    log_write(LOG_INFO, "[부모 pid %d] 서버 종료 완료. 자원 회수 완료.", getpid());
+    log_shutdown(); // chat-dev12 : 남은 로그를 모두 쓰고 flusher 종료
+
+    exit(0);
+}
+
+// 6 단계 : 자식 프로세스 쪽 sigterm handler
+void child_sigterm_handler(int signo) {
+    log_write(LOG_INFO, "[자식 pid %d] 종료 시그널 수신. 종료 중...", getpid());
+
+    close(clients[child_index].client_sock_fd); // 클라이언트와 연결된 소켓 닫기
+    // chat-dev8 : 부모와의 IPC 채널(링 + eventfd) 정리
+    ipc_channel_close(&ipc_to_parent[child_index]);
+    ipc_channel_close(&ipc_to_child[child_index]);
+
+    exit(0); 
+}
+
+// sigaction 커스텀 함수
+/*
+    sigaction : signal 로 시그널이 발생할 때 다시 동일한 시그널이 발생할 때
+        이전 시그널을 처리하는 동안 시그널이 블록되어 처리되지 않고 버려지는 경우를 해결하는 
+        더 향상된 시그널 처리 함수
+*/
+void register_sigaction(int signo, void (*handler)(int)) {
+    // 시그널 처리를 위한 시그널 액션
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+
+    // 터미널 제어 관련 시그널 관리
+    sa.sa_handler = handler; // 시그널 발생 시 실행할 핸들러 지정
+    sigemptyset(&sa.sa_mask); // 모든 시그널 허용
+    sa.sa_flags = SA_RESTART; // 시그널 처리에 의해 방해받은 시스템 호출을 시그널 처리가 끝나면 재시작
+
+    // 시그널 처리 동작 처리
+    if (sigaction(signo, &sa, NULL) == -1) {
+        log_write(LOG_ERROR, "시그널 처리 동작이 실패하였습니다.");
+
+        exit(1);
+    }
+}
+
+// 7 단계 : 서버 데몬화 처리 
+// -> 서버 실행 시 백그라운드로 전환하고, printf 들을 별도 데일리 로그 파일에서 출력하도록 리디렉션 처리
+void daemonize_with_log() {
+    pid_t pid;
+
+    umask(0); // 파일 생성을 위한 마스크를 0 으로 설정
+
+    // fork() 로 자식 프로세스를 생성 하고 부모 프로세스는 종료
+    pid = fork();
+    if (pid < 0) exit(1);
+    if (pid > 0) exit(0); // 부모 종료
+
+    // 자식 프로세스를 세션 리더로 만들어 터미널 조작을 못하게 함
+    if (setsid() < 0) exit(1);
+
+    chdir("./"); // 현재 디렉토리로 이동
+
+    // 표준 입력 닫기
+    close(STDIN_FILENO);
+
+    // 로그 디렉토리 생성 (이미 있는 경우는 무시하도록 함)
+    if(mkdir("./logs", 0755) == -1){
+        if(errno != EEXIST){ // 디렉토리가 이미 있으면 무시 또는 생성 실패 시 처리
+            perror("mkdir");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // 날짜별 로그 파일명 생성
+    time_t now = time(NULL);
+    struct tm* t = localtime(&now);
+    char logfile[256];
+    snprintf(logfile, sizeof(logfile), "./logs/chattingServer_%04d%02d%02d.log",
+             t->tm_year + 1900, t->tm_mon + 1, t->tm_mday);
+
+    // 로그 파일 열기
+    file_fd = open(logfile, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (file_fd < 0) exit(1); // 로그 파일 열기 실패 시 종료
+
+    // stdout, stderr 을 로그 파일로 리디렉션
+    dup2(file_fd, STDOUT_FILENO); // printf()
+    dup2(file_fd, STDERR_FILENO); // perror(), fprintf(stderr, ...)
+}
+
+// chat-dev6 : epoll 모드 - 단일 프로세스가 모든 클라이언트 소켓을 non-blocking epoll 루프로 직접 처리
+// => 클라이언트당 자식 프로세스, 파이프 2개, SIGUSR1/SIGUSR2 왕복이 없어지고 메시지 한 건이 syscall 한 번으로 전달됨
+#define EPOLL_MAX_EVENTS 64
+#define EPOLL_LISTEN_ID  0xFFFFFFFFu // epoll_event.data 에서 listen 소켓을 구분하기 위한 값
+#define EPOLL_ROUTE_ID   0x80000000u // chat-dev10 : 라우팅 채널 (하위 비트 : 보낸 worker 번호)
+#define EPOLL_ADMIN_ID   0xFFFFFFFDu // chat-dev13 : 관리용 UNIX 도메인 소켓
+#define EPOLL_COALESCE_ID 0xFFFFFFFCu // chat-dev16 : 모으기 시간 타이머
+#define EPOLL_TIMER_ID   0xFFFFFFFBu // chat-dev27 : 타이머 휠 tick 타이머
+#define EPOLL_SIGNAL_ID  0xFFFFFFFEu // epoll_event.data 에서 signalfd 를 구분하기 위한 값 (chat-dev26 : epoll 모드 SIGHUP 에도 사용)
+int signal_fd = -1; // chat-dev8 : fork 모드 부모 SIGCHLD (chat-dev26 : + SIGHUP, epoll 모드는 SIGHUP 만)
+
+void worker_read_routes(int src);
+void worker_flush_routes();
+void epoll_process_frames(int idx);
+void uring_send_client(int idx);
+void uring_cancel_client(int idx);
+void server_reload();
+
+// chat-dev26 : signalfd 로 받은 신호 처리 - SIGCHLD : 종료된 자식 회수, SIGHUP : 설정 다시 읽기
+void signal_fd_read() {
+    struct signalfd_siginfo si;
+    int reap = 0;
+    int reload = 0;
+    while (read(signal_fd, &si, sizeof(si)) == sizeof(si)) {
+        // 여러 SIGCHLD 가 합쳐질 수 있으므로 handle_sigchld 가 waitpid(WNOHANG) 로 모두 회수
+        if (si.ssi_signo == SIGCHLD) {
+            reap = 1;
+        } else if (si.ssi_signo == SIGHUP) {
+            reload = 1;
+        }
+    }
+    if (reap) {
+        handle_sigchld(SIGCHLD);
+    }
+    if (reload) {
+        server_reload();
+    }
+}
+
+// fd 를 non-blocking 모드로 설정
+int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// epoll_event.data 에 client index 와 fd 를 함께 기록 (슬롯 재사용 시 이전 연결의 이벤트를 구분하기 위함)
+uint64_t epoll_make_data(uint32_t idx, int fd) {
+    return ((uint64_t)(uint32_t)fd << 32) | idx;
+}
+
+// idx 번 클라이언트의 감시 이벤트 갱신 (송신 버퍼에 남은 데이터가 있으면 EPOLLOUT 추가)
+void epoll_update_client(int idx) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    if (client_out[idx].len > 0) {
+        ev.events |= EPOLLOUT;
+    }
+    client_out[idx].waiting = (client_out[idx].len > 0); // chat-dev16
+    ev.data.u64 = epoll_make_data(idx, clients[idx].client_sock_fd);
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, clients[idx].client_sock_fd, &ev);
+}
+
+// chat-dev24 : 송신 큐 뒤에 풀 버퍼 참조 추가 (반환 -1 : 큐 확보 실패)
+// => 앞쪽이 절반 이상 비었으면 당기고, 아니면 두 배로 늘림
+int out_queue_push(OutBuffer* out, MsgBuf* b) {
+    if (out->tail == out->cap) {
+        if (out->head > 0 && out->head >= out->cap / 2) {
+            memmove(out->refs, out->refs + out->head, (out->tail - out->head) * sizeof(OutRef));
+            out->tail -= out->head;
+            out->head = 0;
+        } else {
+            size_t new_cap = out->cap ? out->cap * 2 : OUT_REFS_INIT;
+            OutRef* new_refs = realloc(out->refs, new_cap * sizeof(OutRef));
+            if (new_refs == NULL) {
+                return -1;
+            }
+            out->refs = new_refs;
+            out->cap = new_cap;
+        }
+    }
+    out->refs[out->tail].buf = msgbuf_ref(b);
+    out->refs[out->tail].off = 0;
+    out->tail++;
+    out->len += b->len;
+    return 0;
+}
+
+// chat-dev24 : 송신 큐 앞에서 n 바이트를 보냄 - 다 보낸 버퍼의 참조를 놓음 (마지막 참조면 풀에 돌아감)
+void out_queue_consume(OutBuffer* out, size_t n) {
+    out->len -= n;
+    while (n > 0) {
+        OutRef* r = &out->refs[out->head];
+        size_t left = r->buf->len - r->off;
+        if (n < left) {
+            r->off += n;
+            break;
+        }
+        n -= left;
+        msgbuf_release(r->buf);
+        out->head++;
+    }
+    if (out->head == out->tail) {
+        out->head = out->tail = 0;
+    }
+}
+
+// chat-dev24 : 송신 큐의 모든 참조를 놓고 큐 해제
+void out_queue_clear(OutBuffer* out) {
+    for (size_t k = out->head; k < out->tail; k++) {
+        msgbuf_release(out->refs[k].buf);
+    }
+    free(out->refs);
+    memset(out, 0, sizeof(OutBuffer));
+}
+
+// chat-dev17 : drop-oldest - 보내는 중인 프레임 뒤의 오래된 프레임을 송신 버퍼가 target 바이트 이하가 될 때까지 버림
+// chat-dev24 : 버리는 단위는 송신 큐의 버퍼 참조 (일부만 보낸 앞 버퍼는 남기고 바로 뒤 버퍼부터 참조를 놓음)
+void out_buffer_trim(int idx, size_t target) {
+    OutBuffer* out = &client_out[idx];
+    int keep_head = (out->head < out->tail && out->refs[out->head].off > 0);
+    size_t start = out->head + keep_head;
+    size_t end = start;
+    size_t dropped = 0;
+
+    while (end < out->tail && out->len - dropped > target) {
+        dropped += out->refs[end].buf->len;
+        msgbuf_release(out->refs[end].buf);
+        end++;
+    }
+    if (end == start) {
+        return;
+    }
+    if (keep_head) {
+        out->refs[end - 1] = out->refs[out->head];
+        out->head = end - 1;
+    } else {
+        out->head = end;
+    }
+    if (out->head == out->tail) {
+        out->head = out->tail = 0;
+    }
+    out->len -= dropped;
+    stats_add(&server_stats->dropped_oldest, end - start);
+    stats_add(&server_stats->dropped_bytes, dropped);
+}
+
+// 송신 버퍼에 남은 데이터를 소켓으로 최대한 전송
+// chat-dev24 : 송신 큐의 버퍼들을 iovec 으로 모아 sendmsg (최대 OUT_IOV_MAX 개씩)
+// 반환 : 0 정상(EAGAIN 으로 일부가 남은 경우 포함), -1 소켓 오류
+int epoll_flush_client(int idx) {
+    OutBuffer* out = &client_out[idx];
+    size_t sent = 0;
+
+    while (out->len > 0) {
+        struct iovec iov[OUT_IOV_MAX];
+        int count = 0;
+        for (size_t k = out->head; k < out->tail && count < OUT_IOV_MAX; k++, count++) {
+            iov[count].iov_base = out->refs[k].buf->data + out->refs[k].off;
+            iov[count].iov_len = out->refs[k].buf->len - out->refs[k].off;
+        }
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+        ssize_t n = sendmsg(clients[idx].client_sock_fd, &msg, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        out_queue_consume(out, n);
+        sent += n;
+    }
+    if (sent > 0) {
+        stats_hist_add(&server_stats->send_bytes, sent); // chat-dev16
+        __atomic_store_n(&server_stats->clients[idx].queued, out->len, __ATOMIC_RELAXED); // chat-dev13
+    }
+    return 0;
+}
+
+// chat-dev6 : epoll 모드 전송 - 밀린 데이터가 없으면 소켓에 바로 쓰고, 다 못 쓴 나머지만 송신 버퍼에 보관
+// chat-dev16 : 바로 쓰지 않고 송신 버퍼에 붙인 뒤, 이벤트 루프 한 바퀴가 끝날 때(또는 모으기 시간 만료 시) 클라이언트마다 한 번에 전송
+// => 브로드캐스트가 여러 건 몰려도 클라이언트당 send 1회 (epoll_flush_pending)
+// chat-dev24 : 바이트 복사 대신 풀 버퍼 b 의 참조를 송신 큐에 추가 (b 의 참조는 호출한 쪽이 놓음)
+void epoll_send_buf(int idx, MsgBuf* b) {
+    OutBuffer* out = &client_out[idx];
+    size_t len = b->len;
+
+    // chat-dev13 : 명령어별 / 클라이언트별 보낸 프레임, 바이트 (송신 버퍼에 남는 데이터 포함)
+    stats_add(&server_stats->frames_out[FRAME_CMD(b->data[4])], 1);
+    stats_add(&server_stats->clients[idx].frames_out, 1);
+    stats_add(&server_stats->clients[idx].bytes_out, len);
+
+    // chat-dev17 : 송신 큐 상한/하한과 느린 클라이언트 정책
+    int verdict = out_queue_admit(idx, out->len + out->inflight, len);
+    if (verdict == OUT_QUEUE_DROP) {
+        return;
+    }
+    if (verdict == OUT_QUEUE_TRIM) {
+        out_buffer_trim(idx, out_queue_low);
+    }
+
+    // 송신 큐 뒤에 붙임
+    if (out_queue_push(out, b) < 0) {
+        log_write(LOG_ERROR, "[epoll index %d] 송신 버퍼 확보에 실패하여 메시지를 버립니다.", idx);
+        return;
+    }
+    __atomic_store_n(&server_stats->clients[idx].queued, out->len + out->inflight, __ATOMIC_RELAXED); // chat-dev13 : workers 모드 조회용
+
+    epoll_mark_dirty(idx);
+    // 모은 데이터가 충분히 크면 기다리지 않고 전송 (소켓이 가득 차서 EPOLLOUT 을 기다리는 중이면 그때 전송)
+    if (out->len >= COALESCE_BYTES && !out->waiting) {
+        if (io_engine == IO_ENGINE_URING) {
+            uring_send_client(idx); // chat-dev19 : send 요청만 추가 (다음 io_uring_enter 에서 제출)
+        } else {
+            epoll_flush_client(idx); // 소켓 오류는 이후 read 에서 연결 종료로 처리됨
+        }
+    }
+}
+
+// chat-dev24 : 바이트로 받은 프레임은 풀 버퍼에 한 번 복사한 뒤 송신 큐에 추가 (최근 메시지 재전송, 다른 worker 에서 라우팅된 프레임 등)
+void epoll_send_to_client(int idx, const char* msg, size_t len) {
+    MsgBuf* b = msgbuf_copy(msg, len);
+    if (b == NULL) {
+        log_write(LOG_ERROR, "[epoll index %d] 송신 버퍼 확보에 실패하여 메시지를 버립니다.", idx);
+        return;
+    }
+    epoll_send_buf(idx, b);
+    msgbuf_release(b);
+}
+
+// chat-dev6 : epoll 모드 클라이언트 연결 종료 및 슬롯 회수 (fork 모드의 handle_sigchld 역할)
+void epoll_close_client(int idx) {
+    log_write(LOG_INFO, "클라이언트 %d (fd: %d, nick: %s) 접속 종료. 자원 회수 완료.", idx, clients[idx].client_sock_fd, clients[idx].nickName);
+
+    // chat-dev16 : 아직 보내지 않은 데이터(연결을 끊기 직전의 오류 응답 등) 를 닫기 전에 한 번 더 전송
+    // chat-dev19 : io_uring 엔진에서 제출한 send 가 끝나지 않았으면 순서가 바뀌므로 보내지 않음
+    if (client_out[idx].len > 0 && !(io_engine == IO_ENGINE_URING && uring_sends[idx].busy)) {
+        epoll_flush_client(idx);
+    }
+    if (io_engine == IO_ENGINE_URING) {
+        uring_cancel_client(idx); // chat-dev19
+    } else {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, clients[idx].client_sock_fd, NULL);
+    }
+    close(clients[idx].client_sock_fd);
+    out_queue_clear(&client_out[idx]); // chat-dev24 : io_uring 엔진에서 제출한 send 의 참조는 완료될 때 놓음
+    memset(&slow_consumers[idx], 0, sizeof(SlowConsumer)); // chat-dev17
+    frame_decoder_free(&client_in[idx]);
+
+    shared_lock(); // chat-dev10 : workers 모드 - 공유 슬롯 회수
+    release_client_slot(idx);
+    shared_unlock();
+}
+
+// chat-dev16 : 이벤트 루프 끝(또는 모으기 시간 만료) 에 전송할 클라이언트로 등록
+void epoll_mark_dirty(int idx) {
+    if (!client_dirty[idx]) {
+        client_dirty[idx] = 1;
+        dirty_clients[dirty_count++] = idx;
+    }
+}
+
+// chat-dev16 : 송신 버퍼에 데이터가 쌓인 클라이언트마다 한 번씩 전송하고, 다 못 보낸 클라이언트는 EPOLLOUT 감시 추가
+void epoll_flush_pending() {
+    for (int k = 0; k < dirty_count; k++) {
+        int idx = dirty_clients[k];
+        client_dirty[idx] = 0;
+        // chat-dev17 : disconnect 정책으로 종료를 요청한 느린 클라이언트
+        if (slow_consumers[idx].kicked) {
+            epoll_close_client(idx);
+            continue;
+        }
+        // 이미 연결이 종료된 슬롯은 송신 버퍼가 비어 있음 (workers 모드 : 다른 worker 가 재사용한 슬롯도 이 worker 의 버퍼는 비어 있음)
+        if (client_out[idx].len == 0 || client_out[idx].waiting) {
+            continue;
+        }
+        if (io_engine == IO_ENGINE_URING) {
+            uring_send_client(idx); // chat-dev19 : 루프 끝의 io_uring_enter 에서 모든 클라이언트의 send 를 한 번에 제출
+            continue;
+        }
+        if (epoll_flush_client(idx) < 0) {
+            epoll_close_client(idx);
+        } else if (client_out[idx].len > 0) {
+            epoll_update_client(idx);
+        }
+    }
+    dirty_count = 0;
+}
+
+// chat-dev25 : 수락한 연결을 받아들일지 판단 (모든 모드 공용, 슬롯 / IPC 링 / 자식 프로세스를 만들기 전에 호출)
+// 반환 : 1 받아들임, 0 출발지 IP 의 연결 속도 제한을 넘어 오류 프레임을 보내고 닫음
+int accept_admit(int fd, const struct sockaddr_in* cli_addr) {
+    shared_lock(); // workers 모드는 모든 worker 가 같은 IP 표를 사용
+    // chat-dev26 : 속도 제한은 SIGHUP 으로 켜고 끌 수 있으므로 잠근 상태에서 확인 (rate 0 : 제한 없음)
+    int allowed = admission->rate == 0 || admission_allow(admission, cli_addr->sin_addr.s_addr, stats_now_ns());
+    shared_unlock();
+    if (allowed) {
+        return 1;
+    }
+    log_write(LOG_WARNING, "%s 의 연결 요청이 너무 많아 접속을 거절합니다.", inet_ntoa(cli_addr->sin_addr));
+    stats_add(&server_stats->rate_limited, 1);
+
+    frame_write(fd, CMD_ERROR, "연결 요청이 너무 많습니다. 잠시 후 다시 접속하세요.\n", strlen("연결 요청이 너무 많습니다. 잠시 후 다시 접속하세요.\n"));
+    close(fd);
+    return 0;
+}
+
+// chat-dev25 : 연결 하나를 받아들이는 데 걸린 시간 기록 (listen 소켓이 준비된 것을 본 시각부터)
+void accept_record_latency() {
+    stats_hist_add(&server_stats->accept_ns, stats_now_ns() - accept_wake_ns);
+}
+
+// chat-dev6 : 수락한 연결에 빈 슬롯 배정
+// chat-dev19 : epoll_accept_clients 에서 분리 (epoll / io_uring 엔진 공용) - 반환 : 슬롯 index, -1 수용량 초과로 거절하고 닫음
+int epoll_claim_slot(int fd, struct sockaddr_in* cli_addr) {
+    // 새 클라이언트를 위한 빈 슬롯(인덱스) 찾기
+    // chat-dev10 : workers 모드는 모든 worker 가 같은 슬롯 배열을 공유하므로 잠근 상태에서 찾고 바로 차지함
+    shared_lock();
+    int new_client_idx = -1;
+    // chat-dev26 : 동시 접속 상한 (SIGHUP 으로 바뀜) 에 닿았으면 빈 슬롯이 남아 있어도 거절
+    for (int i = 0; server_limits->clients < server_limits->max_clients && i < client_reserve; i++) {
+        if (clients[i].pid == 0) {
+            new_client_idx = i;
+            break;
+        }
+    }
+    if (new_client_idx != -1) {
+        server_limits->clients++; // chat-dev26
+        // epoll 모드에는 자식 프로세스가 없으므로 슬롯 사용 중 표시로 서버(worker) 자신의 pid 를 기록
+        clients[new_client_idx].pid = getpid();
+        clients[new_client_idx].client_sock_fd = fd;
+        strcpy(clients[new_client_idx].nickName, "GUEST"); // 임시 닉네임
+        clients[new_client_idx].room_idx = 0; // 기본적으로 로비에 참가
+        room_member_add(0, new_client_idx); // chat-dev11
+        if (server_mode == SERVER_MODE_WORKERS) {
+            clients[new_client_idx].worker = worker_index;
+            clients[new_client_idx].gen = ++worker_shared->next_gen;
+            __atomic_add_fetch(room_member_count(0, worker_index), 1, __ATOMIC_RELAXED);
+        }
+    }
+    shared_unlock();
+
+    // 빈 슬롯이 없을 때 (서버 꽉 찬 상태)
+    if (new_client_idx == -1) {
+        log_write(LOG_ERROR, "서버 수용량 초과로 접속할 수 없습니다.");
+        stats_add(&server_stats->rejects, 1); // chat-dev13
+
+        frame_write(fd, CMD_ERROR, "서버가 꽉 찼습니다.\n", strlen("서버가 꽉 찼습니다.\n"));
+        close(fd);
+        return -1;
+    }
+
+    stats_add(&server_stats->accepts, 1); // chat-dev13
+    if (server_mode == SERVER_MODE_WORKERS) {
+        log_write(LOG_INFO, "클라이언트 연결됨: %s (worker %d, index %d)", inet_ntoa(cli_addr->sin_addr), worker_index, new_client_idx);
+    } else {
+        log_write(LOG_INFO, "클라이언트 연결됨: %s", inet_ntoa(cli_addr->sin_addr));
+    }
+
+    set_client_nodelay(fd); // chat-dev16 (chat-dev25 : non-blocking 은 accept4 / io_uring accept 에서 설정)
+    heartbeat_start(new_client_idx); // chat-dev27
+
+    // client_index 를 루프의 최대 경계로 사용하기 위해 업데이트
+    if (new_client_idx >= active_client_count) {
+        active_client_count = new_client_idx + 1;
+    }
+    return new_client_idx;
+}
+
+// chat-dev6 : listen 소켓에 대기 중인 연결을 모두 수락
+// chat-dev25 : 한 번에 최대 accept_batch 개 (남은 연결은 다음 epoll_wait 에서 바로 다시 깨어나 이어서 수락)
+void epoll_accept_clients() {
+    accept_wake_ns = stats_now_ns();
+    for (int b = 0; b < accept_batch; b++) {
+        struct sockaddr_in cli_addr;
+        socklen_t cli_len = sizeof(cli_addr);
+        int fd = accept4(listen_fd, (struct sockaddr*)&cli_addr, &cli_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                log_write(LOG_ERROR, "accept() - 클라이언트 연결을 수락하지 못했습니다.");
+            }
+            break; // 더 이상 대기 중인 연결 없음
+        }
+
+        if (!accept_admit(fd, &cli_addr)) {
+            continue;
+        }
+        int new_client_idx = epoll_claim_slot(fd, &cli_addr);
+        if (new_client_idx < 0) {
+            continue;
+        }
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = epoll_make_data(new_client_idx, fd);
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        accept_record_latency();
+    }
+}
+
+// chat-dev6 : idx 번 클라이언트 소켓에서 메시지를 읽고 명령어 처리 (fork 모드의 자식 루프 + fork_read_child 역할)
+// chat-dev7 : 소켓에서 읽은 바이트를 프레임 디코더에 쌓고 완성된 프레임만 한 개씩 처리
+void epoll_read_client(int idx) {
+    ssize_t n = frame_decoder_read(&client_in[idx], clients[idx].client_sock_fd);
+
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        return;
+    }
+    // read() 가 <= 0 일 때 연결 종료 처리
+    if (n <= 0) {
+        log_write(LOG_WARNING, "[epoll index %d] 클라이언트 연결 종료가 감지되어 해당 클라이언트 연결을 종료합니다.", idx);
+
+        epoll_close_client(idx);
+        return;
+    }
+    epoll_process_frames(idx);
+}
+
+// chat-dev7 : 디코더에 쌓인 완성된 프레임을 한 개씩 처리
+// chat-dev19 : epoll_read_client 에서 분리 (io_uring 엔진은 recv 완료의 데이터를 디코더에 넣은 뒤 호출)
+void epoll_process_frames(int idx) {
+    Frame frame;
+    int ret;
+    while ((ret = frame_decoder_next(&client_in[idx], &frame)) == 1) {
+        // 종료 조건 : CMD_QUIT 프레임이 들어올 때 연결 종료 처리
+        if (frame.cmd == CMD_QUIT) {
+            epoll_close_client(idx);
+            return;
+        }
+
+        log_write(LOG_INFO, "[epoll index %d] 클라이언트로부터 메시지 수신 : /%s %.*s", idx, frame_cmd_name(frame.cmd), BUFSIZ, frame.payload);
+
+        // chat-dev10 : workers 모드 - 채팅 메시지는 잠금 없이 라우팅하고, 공유 상태를 바꾸는 명령어만 잠근 상태에서 처리
+        uint64_t started = stats_now_ns();
+        // chat-dev27 : PING / PONG 도 공유 상태를 바꾸지 않으므로 잠그지 않음
+        int locked = frame.cmd != CMD_MSG && frame.cmd != CMD_PING && frame.cmd != CMD_PONG;
+        if (locked) {
+            shared_lock();
+        }
+        process_client_message(idx, frame.cmd, frame.payload, frame.len);
+        if (locked) {
+            shared_unlock();
+        }
+        stats_add(&server_stats->frames_in[frame.cmd], 1); // chat-dev13 : 명령어별 요청 수, 처리 시간 (잠금 대기 포함)
+        stats_add_inflated(&frame); // chat-dev22
+        stats_hist_add(&server_stats->handler_ns, stats_now_ns() - started);
+    }
+    if (ret < 0) {
+        // 프레임 길이/명령어가 잘못된 경우 스트림 경계를 더 이상 신뢰할 수 없으므로 연결 종료
+        log_write(LOG_WARNING, "[epoll index %d] 잘못된 프레임을 수신하여 해당 클라이언트 연결을 종료합니다.", idx);
+
+        send_cmd_to_client(idx, CMD_ERROR, "잘못된 프레임입니다.");
+        epoll_close_client(idx);
+    }
+}
+
+// chat-dev19 : io_uring 요청의 user_data (요청 종류, 연결 세대, client index 또는 EPOLL_*_ID)
+uint64_t uring_make_data(int op, uint32_t gen, uint32_t id) {
+    return ((uint64_t)op << 56) | ((uint64_t)(gen & URING_GEN_MASK) << 32) | id;
+}
+
+// chat-dev19 : 제출할 sqe 하나 (제출 큐가 가득 차면 uring_get_sqe 가 먼저 제출)
+struct io_uring_sqe* uring_sqe() {
+    struct io_uring_sqe* sqe = uring_get_sqe(&uring);
+    if (sqe == NULL) {
+        log_write(LOG_ERROR, "io_uring 제출 큐에 요청을 넣지 못했습니다. (%s)", strerror(errno));
+    }
+    return sqe;
+}
+
+// chat-dev19 : listen 소켓 multishot accept 제출 (연결마다 완료가 들어오며, 끝나면 다시 제출)
+void uring_accept() {
+    struct io_uring_sqe* sqe = uring_sqe();
+    if (sqe != NULL) {
+        uring_prep_accept_multishot(sqe, listen_fd, uring_make_data(URING_OP_ACCEPT, 0, EPOLL_LISTEN_ID));
+    }
+}
+
+// chat-dev19 : idx 번 클라이언트 소켓 multishot recv 제출
+void uring_recv_client(int idx) {
+    struct io_uring_sqe* sqe = uring_sqe();
+    if (sqe != NULL) {
+        uring_prep_recv_multishot(sqe, clients[idx].client_sock_fd, uring_make_data(URING_OP_RECV, uring_gen[idx], idx));
+    }
+}
+
+// chat-dev19 : EPOLL_*_ID 로 구분하는 보조 fd (관리용 소켓, 모으기 시간 타이머, 라우팅 채널 eventfd, chat-dev26 : SIGHUP signalfd)
+int uring_watch_fd(uint32_t id) {
+    if (id == EPOLL_ADMIN_ID) {
+        return admin_fd;
+    }
+    if (id == EPOLL_COALESCE_ID) {
+        return coalesce_timer_fd;
+    }
+    if (id == EPOLL_SIGNAL_ID) {
+        return signal_fd; // chat-dev26
+    }
+    if (id == EPOLL_TIMER_ID) {
+        return timer_fd; // chat-dev27
+    }
+    return worker_routes[(id & ~EPOLL_ROUTE_ID) * worker_count + worker_index].efd;
+}
+
+void uring_watch(uint32_t id) {
+    struct io_uring_sqe* sqe = uring_sqe();
+    if (sqe != NULL) {
+        uring_prep_poll_multishot(sqe, uring_watch_fd(id), uring_make_data(URING_OP_POLL, 0, id));
+    }
+}
+
+// chat-dev24 : 옮겨 온 참조 중 아직 보내지 않은 부분을 sendmsg 요청으로 추가
+void uring_prep_send_refs(struct io_uring_sqe* sqe, int idx, uint32_t gen) {
+    UringSend* send = &uring_sends[idx];
+    memset(&send->msg, 0, sizeof(send->msg));
+    send->msg.msg_iov = send->iov + send->first;
+    send->msg.msg_iovlen = send->count - send->first;
+    uring_prep_sendmsg(sqe, clients[idx].client_sock_fd, &send->msg, uring_make_data(URING_OP_SEND, gen, idx));
+}
+
+// chat-dev24 : 제출했던 send 의 참조를 모두 놓음 (완료, 실패, 취소)
+void uring_send_release(UringSend* send) {
+    for (int k = 0; k < send->count; k++) {
+        msgbuf_release(send->refs[k].buf);
+    }
+    send->count = 0;
+    send->first = 0;
+    send->busy = 0;
+    send->len = 0;
+    send->off = 0;
+}
+
+// chat-dev19 : 송신 버퍼를 제출용 버퍼와 바꾸고 send 요청 추가 (제출한 send 가 끝나기 전에는 다음 send 를 제출하지 않아 순서 유지)
+// => 제출 중에도 이벤트 루프는 새 메시지를 (바꿔 넣은) 송신 버퍼에 계속 쌓음
+// chat-dev24 : 버퍼를 바꾸는 대신 송신 큐 앞의 참조를 최대 URING_SEND_REFS 개 옮겨 와 sendmsg 로 제출 (남은 참조는 완료 후 다음 send)
+void uring_send_client(int idx) {
+    OutBuffer* out = &client_out[idx];
+    UringSend* send = &uring_sends[idx];
+    if (send->busy || out->len == 0) {
+        return;
+    }
+    struct io_uring_sqe* sqe = uring_sqe();
+    if (sqe == NULL) {
+        return;
+    }
+    send->count = 0;
+    send->len = 0;
+    while (out->head < out->tail && send->count < URING_SEND_REFS) {
+        OutRef* r = &out->refs[out->head++];
+        send->refs[send->count] = *r;
+        send->iov[send->count].iov_base = r->buf->data + r->off;
+        send->iov[send->count].iov_len = r->buf->len - r->off;
+        send->len += r->buf->len - r->off;
+        send->count++;
+    }
+    if (out->head == out->tail) {
+        out->head = out->tail = 0;
+    }
+    out->len -= send->len;
+    send->first = 0;
+    send->off = 0;
+    send->busy = 1;
+    out->inflight = send->len;
+    out->waiting = 1;
+    uring_prep_send_refs(sqe, idx, uring_gen[idx]);
+}
+
+// chat-dev19 : 연결을 닫기 전에 제출한 recv / send 취소 요청 추가하고 연결 세대를 올림 (이후 들어오는 완료는 이전 연결의 것으로 무시)
+void uring_cancel_client(int idx) {
+    struct io_uring_sqe* sqe = uring_sqe();
+    if (sqe != NULL) {
+        uring_prep_cancel(sqe, uring_make_data(URING_OP_RECV, uring_gen[idx], idx), uring_make_data(URING_OP_CANCEL, 0, 0));
+    }
+    if (uring_sends[idx].busy && (sqe = uring_sqe()) != NULL) {
+        uring_prep_cancel(sqe, uring_make_data(URING_OP_SEND, uring_gen[idx], idx), uring_make_data(URING_OP_CANCEL, 0, 0));
+    }
+    uring_gen[idx]++;
+}
+
+// chat-dev19 : accept 완료 - epoll 엔진과 같은 방식으로 슬롯을 배정하고 recv 제출
+void uring_accept_done(int res, uint32_t flags) {
+    if (res >= 0) {
+        struct sockaddr_in cli_addr;
+        socklen_t cli_len = sizeof(cli_addr);
+        memset(&cli_addr, 0, sizeof(cli_addr));
+        getpeername(res, (struct sockaddr*)&cli_addr, &cli_len);
+        int idx = accept_admit(res, &cli_addr) ? epoll_claim_slot(res, &cli_addr) : -1;
+        if (idx >= 0) {
+            uring_recv_client(idx);
+            accept_record_latency();
+        }
+    } else if (res != -EAGAIN && res != -EINTR) {
+        log_write(LOG_ERROR, "accept() - 클라이언트 연결을 수락하지 못했습니다. (%s)", strerror(-res));
+    }
+    if (!(flags & IORING_CQE_F_MORE)) {
+        uring_accept();
+    }
+}
+
+// chat-dev19 : recv 완료 - 제공 버퍼의 데이터를 디코더에 넣고 버퍼를 돌려준 뒤 epoll 엔진과 같은 명령어 처리
+void uring_recv_done(int idx, uint32_t gen, int res, uint32_t flags) {
+    int current = (gen == (uring_gen[idx] & URING_GEN_MASK));
+    int fed = 0;
+    if (flags & IORING_CQE_F_BUFFER) {
+        unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+        if (current && res > 0) {
+            fed = (frame_decoder_feed(&client_in[idx], uring_buffer(&uring, bid), res) == 0);
+        }
+        uring_recycle_buffer(&uring, bid);
+    }
+    if (!current) {
+        return; // 이미 닫은 연결
+    }
+    if (res == -ENOBUFS) {
+        uring_recv_client(idx); // 제공 버퍼가 모두 쓰이는 중이었음 - 다시 제출
+        return;
+    }
+    if (!fed) {
+        log_write(LOG_WARNING, "[epoll index %d] 클라이언트 연결 종료가 감지되어 해당 클라이언트 연결을 종료합니다.", idx);
+
+        epoll_close_client(idx);
+        return;
+    }
+    epoll_process_frames(idx);
+    // multishot recv 가 끝났으면 (처리 중 연결을 닫지 않은 경우) 다시 제출
+    if (!(flags & IORING_CQE_F_MORE) && gen == (uring_gen[idx] & URING_GEN_MASK)) {
+        uring_recv_client(idx);
+    }
+}
+
+// chat-dev19 : send 완료 - 일부만 보냈으면 나머지를 다시 제출하고, 다 보냈으면 그동안 쌓인 송신 버퍼를 전송 대상으로 등록
+void uring_send_done(int idx, uint32_t gen, int res) {
+    OutBuffer* out = &client_out[idx];
+    UringSend* send = &uring_sends[idx];
+    int current = (gen == (uring_gen[idx] & URING_GEN_MASK));
+
+    if (current && res > 0) {
+        stats_hist_add(&server_stats->send_bytes, res); // chat-dev16
+        send->off += res;
+        out->inflight = send->len - send->off;
+        __atomic_store_n(&server_stats->clients[idx].queued, out->len + out->inflight, __ATOMIC_RELAXED); // chat-dev13
+        if (send->off < send->len) {
+            struct io_uring_sqe* sqe = uring_sqe();
+            if (sqe != NULL) {
+                // chat-dev24 : 보낸 만큼 iovec 을 넘기고 나머지를 다시 제출
+                struct iovec* iov = send->iov + send->first;
+                int count = send->count - send->first;
+                child_iov_advance(&iov, &count, res);
+                send->first = iov - send->iov;
+                uring_prep_send_refs(sqe, idx, gen);
+                return;
+            }
+        }
+    }
+    uring_send_release(send); // chat-dev24 : 보낸 버퍼 참조를 놓음 (마지막 참조면 풀에 돌아감)
+    if (!current) {
+        // 닫은 연결의 send (취소됨) - 같은 슬롯의 새 연결이 기다리던 데이터가 있으면 전송
+        if (out->len > 0) {
+            epoll_mark_dirty(idx);
+        }
+        return;
+    }
+    out->waiting = 0;
+    out->inflight = 0;
+    if (res < 0) {
+        log_write(LOG_WARNING, "[epoll index %d] 클라이언트 전송 실패로 연결을 종료합니다. (%s)", idx, strerror(-res));
+        epoll_close_client(idx);
+        return;
+    }
+    if (out->len > 0) {
+        epoll_mark_dirty(idx);
+    }
+}
+
+// chat-dev19 : 보조 fd poll 완료 - epoll 엔진의 이벤트 처리와 동일
+void uring_poll_done(uint32_t id, int res, uint32_t flags) {
+    if (res < 0) {
+        log_write(LOG_ERROR, "io_uring poll 실패 (%s)", strerror(-res));
+        return;
+    }
+    if (id == EPOLL_ADMIN_ID) {
+        admin_serve(); // chat-dev13
+    } else if (id == EPOLL_COALESCE_ID) {
+        coalesce_timer_expired(); // chat-dev16
+        epoll_flush_pending();
+    } else if (id == EPOLL_SIGNAL_ID) {
+        signal_fd_read(); // chat-dev26
+    } else if (id == EPOLL_TIMER_ID) {
+        server_timer_expired(); // chat-dev27
+    } else {
+        worker_read_routes(id & ~EPOLL_ROUTE_ID); // chat-dev10
+    }
+    if (!(flags & IORING_CQE_F_MORE)) {
+        uring_watch(id);
+    }
+}
+
+// chat-dev19 : io_uring 인스턴스 생성, 제공 버퍼 등록, 커널 지원 확인 (실패하면 epoll 엔진으로 동작)
+int uring_engine_open() {
+    if (uring_open(&uring, URING_ENTRIES) < 0) {
+        return -1;
+    }
+    if (uring_setup_buffers(&uring, URING_BUF_COUNT, URING_BUF_SIZE) < 0 || uring_check(&uring) < 0) {
+        int err = errno;
+        uring_close(&uring);
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+// chat-dev19 : io_uring 엔진 메인 루프 (run_epoll_server 와 같은 순서로 이벤트를 처리)
+// => 루프 한 바퀴 : 쌓인 요청(recv 재제출, send, 취소) 제출 + 완료 대기를 io_uring_enter 한 번으로 → 완료 처리 → 쌓인 전송을 send 요청으로 추가
+void run_uring_server() {
+    uring_accept();
+    if (admin_fd >= 0) {
+        uring_watch(EPOLL_ADMIN_ID); // chat-dev13
+    }
+    if (coalesce_timer_open() >= 0) {
+        uring_watch(EPOLL_COALESCE_ID); // chat-dev16
+    }
+    if (signal_fd >= 0) {
+        uring_watch(EPOLL_SIGNAL_ID); // chat-dev26
+    }
+    if (server_timer_open() >= 0) {
+        uring_watch(EPOLL_TIMER_ID); // chat-dev27
+    }
+    if (server_mode == SERVER_MODE_WORKERS) {
+        for (int src = 0; src < worker_count; src++) {
+            if (src != worker_index) {
+                uring_watch(EPOLL_ROUTE_ID | src); // chat-dev10
+            }
+        }
+    }
+
+    while (1) {
+        if (uring_submit(&uring, 1) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            log_write(LOG_ERROR, "io_uring_enter() - %s", strerror(errno));
+            break;
+        }
+        accept_wake_ns = stats_now_ns(); // chat-dev25 : 연결 수락 시간 지표 (accept 완료를 꺼낸 루프가 깨어난 시각부터)
+        struct io_uring_cqe* cqe;
+        while ((cqe = uring_peek_cqe(&uring)) != NULL) {
+            uint64_t data = cqe->user_data;
+            int res = cqe->res;
+            uint32_t flags = cqe->flags;
+            uring_cqe_seen(&uring);
+
+            int op = (int)(data >> 56);
+            uint32_t gen = (uint32_t)(data >> 32) & URING_GEN_MASK;
+            uint32_t id = (uint32_t)data;
+            if (op == URING_OP_ACCEPT) {
+                uring_accept_done(res, flags);
+            } else if (op == URING_OP_RECV) {
+                uring_recv_done(id, gen, res, flags);
+            } else if (op == URING_OP_SEND) {
+                uring_send_done(id, gen, res);
+            } else if (op == URING_OP_POLL) {
+                uring_poll_done(id, res, flags);
+            }
+        }
+        // run_epoll_server 와 같은 루프 끝 처리 (쌓인 전송은 send 요청으로 추가되어 다음 io_uring_enter 에서 제출)
+        if (dirty_count > 0) {
+            if (coalesce_us == 0) {
+                epoll_flush_pending();
+            } else {
+                coalesce_timer_arm();
+            }
+        }
+        if (server_mode == SERVER_MODE_WORKERS) {
+            worker_flush_routes();
+        }
+        journal_check_snapshot(); // chat-dev15
+    }
+    uring_close(&uring);
+}
+
+// chat-dev6 : epoll 모드 메인 루프
+void run_epoll_server() {
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+
+    // chat-dev19 : io_uring 엔진 - 커널이 지원하면 io_uring 루프로 처리하고, 지원하지 않으면 epoll 루프로 대체
+    if (io_engine == IO_ENGINE_URING) {
+        if (uring_engine_open() == 0) {
+            log_write(LOG_INFO, "io_uring 입출력 엔진으로 동작합니다. (pid %d)", getpid());
+            run_uring_server();
+            return;
+        }
+        log_write(LOG_WARNING, "io_uring 을 사용할 수 없어 epoll 입출력 엔진으로 동작합니다. (%s)", strerror(errno));
+        io_engine = IO_ENGINE_EPOLL;
+    }
+
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) {
+        log_write(LOG_ERROR, "epoll_create1() - %s", strerror(errno));
+        return;
+    }
+
+    // listen 소켓도 non-blocking 으로 두고 EPOLLIN 이벤트마다 대기 중인 연결을 모두 수락
+    set_nonblocking(listen_fd);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = epoll_make_data(EPOLL_LISTEN_ID, listen_fd);
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    admin_watch(epoll_fd); // chat-dev13
+    if (coalesce_timer_open() >= 0) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = epoll_make_data(EPOLL_COALESCE_ID, coalesce_timer_fd); // chat-dev16
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, coalesce_timer_fd, &ev);
+    }
+    if (signal_fd >= 0) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = epoll_make_data(EPOLL_SIGNAL_ID, signal_fd); // chat-dev26 : epoll 모드 SIGHUP
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &ev);
+    }
+    if (server_timer_open() >= 0) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = epoll_make_data(EPOLL_TIMER_ID, timer_fd); // chat-dev27
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+    }
+
+    // chat-dev10 : workers 모드 - 다른 worker 들로부터의 라우팅 채널 eventfd 감시
+    if (server_mode == SERVER_MODE_WORKERS) {
+        for (int src = 0; src < worker_count; src++) {
+            if (src == worker_index) {
+                continue;
+            }
+            IpcChannel* ch = &worker_routes[src * worker_count + worker_index];
+            memset(&ev, 0, sizeof(ev));
+            ev.events = EPOLLIN;
+            ev.data.u64 = epoll_make_data(EPOLL_ROUTE_ID | src, ch->efd);
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ch->efd, &ev);
+        }
+    }
+
+    while (1) {
+        int n = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_write(LOG_ERROR, "epoll_wait() - %s", strerror(errno));
+            break;
+        }
+
+        for (int k = 0; k < n; k++) {
+            uint32_t idx = (uint32_t)(events[k].data.u64 & 0xFFFFFFFFu);
+            int fd = (int)(events[k].data.u64 >> 32);
+
+            if (idx == EPOLL_LISTEN_ID) {
+                epoll_accept_clients();
+                continue;
+            }
+            if (idx == EPOLL_ADMIN_ID) {
+                admin_serve(); // chat-dev13
+                continue;
+            }
+            if (idx == EPOLL_COALESCE_ID) {
+                coalesce_timer_expired(); // chat-dev16 : 모으기 시간 만료 - 아래에서 쌓인 데이터 전송
+                epoll_flush_pending();
+                continue;
+            }
+            if (idx == EPOLL_SIGNAL_ID) {
+                signal_fd_read(); // chat-dev26 : SIGHUP
+                continue;
+            }
+            if (idx == EPOLL_TIMER_ID) {
+                server_timer_expired(); // chat-dev27 : PING, 유휴 연결 종료 (보낼 PING 은 아래에서 전송)
+                continue;
+            }
+            if (idx & EPOLL_ROUTE_ID) {
+                worker_read_routes(idx & ~EPOLL_ROUTE_ID);
+                continue;
+            }
+            // 같은 epoll_wait 결과 안에서 이미 종료된(또는 재사용된) 슬롯의 이벤트는 무시
+            if (clients[idx].pid == 0 || clients[idx].client_sock_fd != fd) {
+                continue;
+            }
+            if (events[k].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                epoll_read_client(idx);
+            }
+            if (clients[idx].pid != 0 && (events[k].events & EPOLLOUT)) {
+                if (epoll_flush_client(idx) < 0) {
+                    epoll_close_client(idx);
+                } else if (client_out[idx].len == 0) {
+                    epoll_update_client(idx); // 송신 버퍼를 모두 비웠으므로 EPOLLOUT 감시 해제
+                }
+            }
+        }
+        // chat-dev16 : 이번 이벤트 처리 중 쌓인 클라이언트 데이터 전송 (처리량 우선 모드는 모으기 시간 뒤에 전송)
+        if (dirty_count > 0) {
+            if (coalesce_us == 0) {
+                epoll_flush_pending();
+            } else {
+                coalesce_timer_arm();
+            }
+        }
+        // chat-dev10 : 이번 이벤트 처리 중 다른 worker 에게 쓴 라우팅 레코드의 알림을 worker 마다 한 번만 보냄
+        if (server_mode == SERVER_MODE_WORKERS) {
+            worker_flush_routes();
+        }
+        journal_check_snapshot(); // chat-dev15
+    }
+}
+
+// chat-dev10 : workers 모드 - dst 번 worker 에게 라우팅 레코드(헤더 + 프레임) 전송
+// 알림(eventfd) 은 이벤트 루프 한 바퀴가 끝날 때 worker_flush_routes 에서 모아서 보냄
+void worker_route(int dst, int kind, int target, uint32_t gen, const char* frame, size_t len) {
+    RouteHeader header;
+    header.kind = kind;
+    header.target = target;
+    header.gen = gen;
+    header.len = len;
+
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = (void*)frame;
+    iov[1].iov_len = len;
+
+    // 받는 worker 가 밀려 채널이 가득 찬 경우 보내는 worker 가 멈추지 않도록 메시지를 버림
+    if (ipc_channel_writev(&worker_routes[worker_index * worker_count + dst], iov, 2) < 0) {
+        log_write(LOG_WARNING, "[worker %d] worker %d 로의 라우팅 채널이 가득 차서 메시지(%zu 바이트)를 버립니다.", worker_index, dst, len);
+    }
+}
+
+// 자신이 소유한 연결 중 room 번 채팅 채널 멤버들에게 전달
+// chat-dev11 : 채팅 채널 멤버 리스트만 순회
+// => 다른 worker 가 잠근 상태에서 멤버 리스트를 바꾸므로 (채널 이동, 접속 종료) 잠근 상태에서 이 worker 의 멤버만 복사한 뒤 잠금 없이 전달
+//    (리스트를 잠그지 않고 따라가면 순회 중 빠진 멤버의 room_next 를 따라가 남은 멤버가 메시지를 받지 못함)
+//    복사한 멤버는 이 worker 만 연결을 닫으므로 전달하는 동안 슬롯이 회수되지 않음
+// chat-dev22 : 압축 프레임은 협상한 멤버에게 그대로 보내고, 협상하지 않은 멤버가 있으면 worker 마다 한 번만 풀어서 보냄
+// chat-dev24 : 멤버 송신 큐들은 풀 버퍼 b (푼 프레임도 풀 버퍼 하나) 를 참조 (b 의 참조는 호출한 쪽이 놓음)
+void worker_deliver_room_local(int room, MsgBuf* b) {
+    MsgBuf* plain = NULL;
+    int inflated = 0;
+    int count = 0;
+    int locked = !shared_lock_held; // 잠근 상태에서 처리하는 명령어의 브로드캐스트이면 이미 잠겨 있음
+    if (locked) {
+        shared_lock();
+    }
+    for (int j = rooms[room].member_head; j >= 0; j = clients[j].room_next) {
+        if (clients[j].pid > 0 && clients[j].worker == worker_index) {
+            room_deliver_members[count++] = j;
+        }
+    }
+    if (locked) {
+        shared_unlock();
+    }
+    for (int k = 0; k < count; k++) {
+        int j = room_deliver_members[k];
+        if (!(b->data[4] & FRAME_FLAG_LZ) || (clients[j].caps & CLIENT_CAP_LZ)) {
+            epoll_send_buf(j, b);
+            continue;
+        }
+        if (!inflated) {
+            inflated = 1;
+            uint32_t be_plain = 0; // 압축 payload 앞 4 바이트 : 원본 payload 길이 (풀 버퍼 크기)
+            if (b->len >= FRAME_HEADER_SIZE + FRAME_LZ_HEADER) {
+                memcpy(&be_plain, b->data + FRAME_HEADER_SIZE, 4);
+            }
+            size_t plain_size = FRAME_HEADER_SIZE + ntohl(be_plain);
+            plain = plain_size <= FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD ? msgbuf_alloc(plain_size) : NULL;
+            long n = plain != NULL ? decompress_for_send(plain->data, plain->size, b->data, b->len) : -1;
+            if (n > 0) {
+                plain->len = n;
+            } else {
+                msgbuf_release(plain);
+                plain = NULL;
+            }
+        }
+        if (plain != NULL) {
+            epoll_send_buf(j, plain);
+        }
+    }
+    msgbuf_release(plain);
+}
+
+// 채팅 채널 소유 shard : 멤버가 있는 worker 마다 한 번씩 전달 (채팅 채널 메시지 순서는 소유 shard 의 처리 순서로 결정됨)
+void worker_room_fanout(int room, MsgBuf* b) {
+    record_room_message(room, b->data, b->len); // chat-dev14 : 채널 메시지 순서대로 최근 메시지 기록
+    // chat-dev22 : 압축을 협상한 멤버가 있으면 한 번만 압축하여 모든 worker 에게 같은 압축 프레임을 전달
+    MsgBuf* lz = __atomic_load_n(&rooms[room].lz_member_count, __ATOMIC_RELAXED) > 0 ? compress_for_send(b->data, b->len) : NULL;
+    MsgBuf* out = lz != NULL ? lz : b;
+    for (int w = 0; w < worker_count; w++) {
+        if (__atomic_load_n(room_member_count(room, w), __ATOMIC_RELAXED) <= 0) {
+            continue;
+        }
+        if (w == worker_index) {
+            worker_deliver_room_local(room, out);
+        } else {
+            worker_route(w, ROUTE_ROOM_DELIVER, room, 0, out->data, out->len);
+        }
+    }
+    msgbuf_release(lz);
+}
+
+// src 번 worker 로부터 온 라우팅 레코드 처리
+// chat-dev24 : 프레임은 링에서 풀 버퍼로 바로 읽어 전달 (worker 안의 멤버들은 이 버퍼를 참조)
+void worker_read_routes(int src) {
+    IpcChannel* ch = &worker_routes[src * worker_count + worker_index];
+    ipc_channel_clear_event(ch);
+
+    RouteHeader header;
+    // 레코드는 헤더와 프레임이 한 번에 공개되므로 헤더를 읽었다면 프레임도 이미 링에 있음
+    while (shm_ring_read(ch->ring, &header, sizeof(header)) == 0) {
+        MsgBuf* b = header.len <= FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD ? msgbuf_alloc(header.len) : NULL;
+        if (b == NULL || shm_ring_read(ch->ring, b->data, header.len) < 0) {
+            msgbuf_release(b);
+            break; // 보내는 쪽은 최대 프레임 크기 이하만 쓰므로 발생하지 않음
+        }
+        b->len = header.len;
+        if (header.kind == ROUTE_ROOM_SEQUENCE) {
+            worker_room_fanout(header.target, b);
+        } else if (header.kind == ROUTE_ROOM_DELIVER) {
+            worker_deliver_room_local(header.target, b);
+        } else if (header.kind == ROUTE_CLIENT) {
+            // 라우팅 중에 연결이 끊겨 슬롯이 재사용된 경우 이전 연결의 메시지는 버림
+            int t = header.target;
+            if (clients[t].pid > 0 && clients[t].worker == worker_index && clients[t].gen == header.gen) {
+                epoll_send_buf(t, b);
+            }
+        }
+        msgbuf_release(b);
+    }
+}
+
+// 밀린 라우팅 알림 전송 (받는 worker 가 잠들어 있을 수 있는 채널만 eventfd_write)
+void worker_flush_routes() {
+    for (int dst = 0; dst < worker_count; dst++) {
+        if (dst != worker_index) {
+            ipc_channel_flush(&worker_routes[worker_index * worker_count + dst]);
+        }
+    }
+}
+
+// chat-dev10 : listen 소켓 생성 (socket → bind → listen)
+// reuseport : workers 모드 - 여러 worker 가 같은 포트에 각자 listen 소켓을 두고 커널이 연결을 분배하도록 SO_REUSEPORT 설정
+int open_listen_socket(int reuseport) {
+    struct sockaddr_in serv_addr;
+    int fd;
+
+    // 1 단계 : TCP 소켓 생성(socket())
+    if ((fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        // 7단계 : 에러 발생 시간과 함께 로그 데이터를 출력하기 위해서 perror 대신에 문자열을 반환해주는
+        // strerror(errno) 를 사용한다.
+        log_write(LOG_ERROR, "%s", strerror(errno));
+        return -1;
+    }
+
+    // 서버 재시작 시 TIME_WAIT 상태의 이전 연결 때문에 bind 가 실패하지 않도록 함
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (reuseport) {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+    }
+
+    // 1 단계 : 서버 주소 구조체 설정(memset 후 server 주소 구조체 설정)
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_addr = listen_addr; // chat-dev26 : --listen (기본 INADDR_ANY)
+    serv_addr.sin_port = htons(listen_port); // chat-dev26
+
+    // 1 단계 : 소켓에 서버 주소 바인딩(bind()) 후 클라이언트 연결 대기(listen())
+    if (bind(fd, (struct sockaddr*)&serv_addr, sizeof(serv_addr)) == -1 || listen(fd, listen_backlog) < 0) {
+        log_write(LOG_ERROR, "%s", strerror(errno));
+
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// chat-dev13 : 관리용 UNIX 도메인 listen 소켓 생성 (이전 실행이 남긴 소켓 파일은 지우고 다시 만듦, 소유자만 접근)
+int open_admin_socket(const char* path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || chmod(path, 0600) < 0 || listen(fd, PENDING_CONN) < 0) {
+        close(fd);
+        return -1;
+    }
+    set_nonblocking(fd);
+    return fd;
+}
+
+// chat-dev13 : 관리용 소켓에 대기 중인 연결마다 Prometheus text 형식 지표를 쓰고 닫음
+// => 이벤트 루프에서 호출되므로 읽지 않는 상대 때문에 오래 멈추지 않도록 송신 timeout 을 둠
+void admin_serve() {
+    while (1) {
+        int fd = accept(admin_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break; // 더 이상 대기 중인 연결 없음 (workers 모드 : 다른 worker 가 먼저 수락)
+        }
+        struct timeval timeout = { 1, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        size_t len;
+        shared_lock(); // workers 모드 : 공유 슬롯의 닉네임을 읽는 동안 잠금
+        char* text = stats_render_prometheus(server_mode_name(), stats_client_info, &len);
+        shared_unlock();
+        for (size_t off = 0; text != NULL && off < len; ) {
+            ssize_t n = send(fd, text + off, len - off, MSG_NOSIGNAL);
+            if (n <= 0) {
+                break;
+            }
+            off += n;
+        }
+        free(text);
+        close(fd);
+    }
+}
+
+// chat-dev13 : 이벤트 루프의 epoll 에 관리용 소켓 등록
+void admin_watch(int efd) {
+    if (admin_fd < 0) {
+        return;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = epoll_make_data(EPOLL_ADMIN_ID, admin_fd);
+    epoll_ctl(efd, EPOLL_CTL_ADD, admin_fd, &ev);
+}
+
+// chat-dev10 : w 번 worker 프로세스 생성
+pid_t spawn_worker(int w) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    worker_index = w;
+    active_client_count = client_reserve; // 슬롯은 모든 worker 가 공유하므로 전체 범위를 확인
+    // chat-dev26 : 최상위 프로세스가 sigwaitinfo 로 받으려고 블록한 SIGCHLD 해제 (SIGHUP 은 최상위 프로세스만 처리하므로 블록 유지)
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_UNBLOCK, &mask, NULL);
+    listen_fd = open_listen_socket(1);
+    if (listen_fd < 0) {
+        exit(1);
+    }
+    run_epoll_server();
+    exit(0);
+}
+
+// chat-dev10 : 최상위 프로세스 - 모든 worker 종료 요청 후 회수
+void workers_shutdown() {
+    for (int w = 0; w < worker_count; w++) {
+        if (worker_pids[w] > 0) {
+            kill(worker_pids[w], SIGTERM);
+        }
+    }
+    for (int w = 0; w < worker_count; w++) {
+        if (worker_pids[w] > 0) {
+            waitpid(worker_pids[w], NULL, 0);
+        }
+    }
+}
+
+// chat-dev10 : 비정상 종료된 worker 가 소유하던 슬롯 회수
+void workers_release_slots(int w, pid_t pid) {
+    shared_lock();
+    for (int i = 0; i < client_reserve; i++) {
+        if (clients[i].pid == pid) {
+            release_client_slot(i);
+        }
+    }
+    shared_unlock();
+}
+
+// chat-dev10 : workers 모드 최상위 프로세스
+// 공유 상태와 worker 간 라우팅 채널을 만든 뒤 worker 들을 생성하고, 비정상 종료된 worker 는 다시 생성
+int run_worker_pool() {
+    // chat-dev26 : 클라이언트 슬롯 client_reserve 개와 닉네임 인덱스 칸을 WorkerShared 뒤에 이어서 둠
+    size_t size = sizeof(WorkerShared) + sizeof(ClientData) * client_reserve + sizeof(NameIndexEntry) * NICK_INDEX_SIZE;
+    worker_shared = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (worker_shared == MAP_FAILED) {
+        return -1;
+    }
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&worker_shared->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    // 전역 clients 가 공유 메모리를 가리키도록 변경 (chat-dev11 : rooms 는 main 에서 공유 메모리에 생성됨)
+    clients = worker_shared->clients;
+    nick_index = &worker_shared->nick_index; // chat-dev11
+    name_index_init(nick_index, (NameIndexEntry*)(worker_shared->clients + client_reserve), NICK_INDEX_SIZE, client_nick_of);
+
+    worker_routes = calloc(worker_count * worker_count, sizeof(IpcChannel));
+    if (worker_routes == NULL) {
+        return -1;
+    }
+    for (int src = 0; src < worker_count; src++) {
+        for (int dst = 0; dst < worker_count; dst++) {
+            if (src != dst && ipc_channel_open(&worker_routes[src * worker_count + dst], IPC_RING_SIZE) < 0) {
+                return -1;
+            }
+        }
+    }
+
+    // chat-dev26 : worker 종료(SIGCHLD) 와 설정 다시 읽기(SIGHUP) 를 sigwaitinfo 로 차례로 처리 (worker 생성 전에 블록)
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigaddset(&mask, SIGHUP);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+
+    for (int w = 0; w < worker_count; w++) {
+        worker_pids[w] = spawn_worker(w);
+    }
+
+    log_write(LOG_INFO, "서버가 %s:%d 에서 대기하고 있습니다...... (mode : workers, worker 수 : %d)", listen_host, listen_port, worker_count);
+
+    while (1) {
+        siginfo_t si;
+        if (sigwaitinfo(&mask, &si) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (si.si_signo == SIGHUP) {
+            server_reload(); // chat-dev26
+            continue;
+        }
+        // 여러 SIGCHLD 가 합쳐질 수 있으므로 종료된 worker 를 모두 회수
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            for (int w = 0; w < worker_count; w++) {
+                if (worker_pids[w] != pid) {
+                    continue;
+                }
+                log_write(LOG_WARNING, "worker %d (pid %d) 가 비정상 종료되어 다시 생성합니다.", w, pid);
+
+                // 라우팅 채널의 head / tail 은 공유 메모리에 있으므로 새 worker 가 그대로 이어서 사용함
+                workers_release_slots(w, pid);
+                worker_pids[w] = spawn_worker(w);
+                break;
+            }
+        }
+        if (pid < 0 && errno == ECHILD) {
+            break;
+        }
+    }
+    return 0;
+}
+
+// chat-dev8 : fork 모드 부모 이벤트 루프
+// => 기존에는 자식 메시지를 SIGUSR1 핸들러에서, 자식 종료를 SIGCHLD 핸들러에서 처리하고 main 은 accept() 에서 멈춰 있었음
+//    이제 listen 소켓, 자식별 eventfd, SIGCHLD(signalfd) 를 하나의 epoll 로 감시하여 모든 처리를 메인 루프에서 수행
+
+// 부모 epoll 인스턴스 생성 및 listen 소켓, SIGCHLD signalfd 등록
+int fork_setup_event_loop() {
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) {
+        return -1;
+    }
+
+    // chat-dev9 : 모든 채팅 채널의 방 로그, 방 eventfd, 클라이언트별 방 이동 정보를 fork 전에 미리 생성 (모든 자식이 공유)
+    // chat-dev11 : 방 로그는 채널 수용량만큼 (실제 메모리는 메시지가 쓰인 페이지만 사용), 방 eventfd 는 ROOM_EFD_POOL 개
+    room_logs = calloc(room_capacity, sizeof(RoomLog*));
+    if (room_logs == NULL) {
+        return -1;
+    }
+    for (int r = 0; r < room_capacity; r++) {
+        room_logs[r] = room_log_create(ROOM_LOG_SIZE);
+        if (room_logs[r] == NULL) {
+            return -1;
+        }
+    }
+    for (int e = 0; e < ROOM_EFD_POOL; e++) {
+        room_efd[e] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (room_efd[e] < 0) {
+            return -1;
+        }
+    }
+    room_cursors = mmap(NULL, sizeof(RoomCursor) * client_reserve, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (room_cursors == MAP_FAILED) {
+        return -1;
+    }
+
+    // SIGCHLD 를 블록하고 signalfd 로 받아서 handle_sigchld 가 메인 루프에서만 실행되도록 함
+    // => 자식 슬롯 정리와 명령어 처리(clients[] 접근) 가 서로 끼어들지 않음
+    // chat-dev26 : SIGHUP(설정 다시 읽기, main 에서 블록) 도 같은 signalfd 로 받음
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &mask, NULL);
+    sigaddset(&mask, SIGHUP);
+    signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd < 0) {
+        return -1;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = epoll_make_data(EPOLL_SIGNAL_ID, signal_fd);
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &ev);
+
+    // listen 소켓을 non-blocking 으로 두어 준비된 연결이 사라진 경우에도 accept() 에서 멈추지 않도록 함
+    set_nonblocking(listen_fd);
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = epoll_make_data(EPOLL_LISTEN_ID, listen_fd);
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+    admin_watch(epoll_fd); // chat-dev13
+    if (server_timer_open() >= 0) {
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u64 = epoll_make_data(EPOLL_TIMER_ID, timer_fd); // chat-dev27
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+    }
+    return 0;
+}
+
+// idx 번 자식 → 부모 채널의 eventfd 를 부모 epoll 에 등록
+void fork_watch_child(int idx) {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u64 = epoll_make_data(idx, ipc_to_parent[idx].efd);
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ipc_to_parent[idx].efd, &ev);
+}
+
+// 새 연결이 들어올 때까지 자식 메시지와 자식 종료를 처리
+void fork_wait_for_accept() {
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+
+    while (1) {
+        int n = epoll_wait(epoll_fd, events, EPOLL_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_write(LOG_ERROR, "epoll_wait() - %s", strerror(errno));
+            return;
+        }
 
-                // 활성화된 채팅 채널 없음 (모두 is_active = 1)
-                if(is_duplicate){
-                    snprintf(sendMsg, sizeof(sendMsg), "/ADD %s", "중복된 채팅 채널 이름입니다.\n");
-                }
-                else if(is_valid == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "/ADD %s", "채팅 채널 최대 수용량을 초과하였습니다.\n");
-                }
-                
-                // 서버 부모 프로세스에서 처리(컨트롤) 후 결과를 서버 자식 프로세스(해당 클라이언트 담당) 에게 전달할 파이프에 작성
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                // 후 서버 자식 프로세스(해당 클라이언트 담당 프로세스)에게 시그널 알림
-                kill(clients[i].pid, SIGUSR2); 
-            } // chat-dev3 : /LEAVE 명령어. 현재 클라이언트가 로비 채널이 아닌 채팅 채널에 있을 때만, 로비 채널로 이동 시켜 준다.
-            else if(strcmp(ch, "LEAVE") == 0){
-                char sendMsg[500];
-
-                // 이미 로비에서 Leave 명령어 수행 시 동작하지 않음
-                if(strcmp(str, "lobby") == 0){
-                    if(clients[i].room_idx == 0){
-                        snprintf(sendMsg, sizeof(sendMsg), "%s", "/LEAVE 이미 로비(lobby) 채널에 있는 유저입니다.");    
-                    } else {
-                        // 로비가 아닌 다른 채팅 채널에 있는 클라이언트일 경우 로비 채널로 이동
-                        clients[i].room_idx = 0;
-                        snprintf(sendMsg, sizeof(sendMsg), "%s", "/LEAVE 로비(lobby) 채널로 이동합니다.");
-                    }
-                } else {
-                    snprintf(sendMsg, sizeof(sendMsg), "%s", "/LEAVE 잘못된 명령 문구를 입력했습니다.");    
-                }
-                
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                kill(clients[i].pid, SIGUSR2);
-            } // chat-dev4 : /RM 명령어. 로비 채널이 아닌 채팅 채널에 있을 때만, 로비 채널로 이동 시켜 줌
-            else if(strcmp(ch, "RM") == 0){
-                char sendMsg[BUFSIZ + 100];
-
-                if(strcmp(str, "lobby") == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "%s", "/RM 로비(lobby) 채널은 삭제할 수 없습니다.");
-                } else {
-                    int is_valid = 0;
-                    // 로비가 아닌 다른 채팅 채널의 이름일 경우 해당 채팅 채널을 지우고
-                    int rm_i;
-                    for(rm_i = 0; rm_i < MAX_ROOMS; rm_i++){
-                        if(rooms[rm_i].is_active && strcmp(rooms[rm_i].roomName, str) == 0){
-                            is_valid = 1;
-                            rooms[rm_i].is_active = 0;
-                            break;
-                        }
-                    }
-                    // 해당 채팅 채널에 있던 유저들을 로비로 내보낸다. 
-                    if(is_valid){
-                        int is_findUser = 0;
-                        // 채팅 채널에 포함된 유저들을 찾고 로비로 내보냄
-                        for(int client_i = 0; client_i < MAX_CLIENTS; client_i++){
-                            if(clients[client_i].room_idx == rm_i){
-                                is_findUser = 1;
-                                clients[client_i].room_idx = 0;
-                            }
-                        }
-
-                        if(is_findUser){ // 삭제된 채팅 채널에 유저가 있었을 때의 처리
-                            snprintf(sendMsg, sizeof(sendMsg), "/RM %s 채널이 삭제되었으며, 해당 채팅 채널 유저는 로비로 이동됩니다.", rooms[rm_i].roomName);
-                        } else { // 삭제된 채팅 채널에 유저가 없었을 때의 처리
-                            snprintf(sendMsg, sizeof(sendMsg), "/RM %s 채널이 삭제되었으며, 해당 채팅 채널 에는 유저가 없었습니다.", rooms[rm_i].roomName);
-                        }
-                        // roomName 문자열 초기화
-                        memset(rooms[rm_i].roomName, 0, sizeof(rooms[rm_i].roomName));
-                    } else { // 삭제하려는 채팅 채널이 없음(입력한 채팅 채널 이름이 잘못됨)
-                        snprintf(sendMsg, sizeof(sendMsg), "/RM %s 이름을 가진 채팅 채널이 없습니다.", str);
-                    }
-                }
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                kill(clients[i].pid, SIGUSR2);
-            }
-            // chat-dev4 : /USERS all - 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보(해당 유저가 접속한 채팅방, 유저 이름) 를 출력
-            //             /USERS 채팅방이름 - 해당 채팅 채널방에 속해 있는 모든 클라이언트 유저 정보를 출력
-            else if(strcmp(ch, "USER") == 0){
-                char sendMsg[1024 * 5];
-
-                // 현재 채팅 서버에 접속한 모든 클라이언트 유저 정보를 파이프에 작성하고 자식 프로세스에 시그널 alarm
-                if(strcmp(str, "all") == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "%s", "/USER 전체 유저 정보\n");
-                    for(int client_i = 0; client_i < MAX_CLIENTS; client_i++){
-                        if(clients[client_i].pid > 0){
-                            char tempBuf[BUFSIZ * 2];
-                            snprintf(tempBuf, sizeof(tempBuf), "<USER : %s>   [Channel : %s]\n", clients[client_i].nickName, rooms[clients[client_i].room_idx].roomName);
-                            strcat(sendMsg, tempBuf);
-                        }
-                    }
-                } // 특정 채팅방의 유저 정보를 출력 (없을 경우 그에 따른 문구 출력)
-                else {
-                    int is_empty = 1;
-                    for(int client_i = 0; client_i < MAX_CLIENTS; client_i++){
-                        char tempBuf[BUFSIZ * 2];
-                        if(clients[client_i].pid > 0 && strcmp(rooms[clients[client_i].room_idx].roomName, str) == 0) {
-                            if(is_empty){
-                                is_empty = 0;
-                                snprintf(sendMsg, sizeof(sendMsg), "/USER 채널 [%s] 유저 정보\n", str);
-                            }
-                            snprintf(tempBuf, sizeof(tempBuf), "<USER : %s>   [Channel : %s]\n", clients[client_i].nickName, rooms[clients[client_i].room_idx].roomName);
-                            strcat(sendMsg, tempBuf);
-                        }
-                    }
-                    if(is_empty){
-                        snprintf(sendMsg, sizeof(sendMsg), "/USER [%s] 채팅 채널은 존재하지 않거나, 인원이 없는 채팅 채널방입니다.", str);
-                    }
-                }
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                kill(clients[i].pid, SIGUSR2);
-            } // chat-dev4 : /LIST all : 모든 채팅방 리스트를 출력함, all 이 아닐 경우 경고 문구 출력
-            else if(strcmp(ch, "LIST") == 0){
-                char sendMsg[BUFSIZ * 10];
-                
-                if(strcmp(str, "all") == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "%s", "/LIST ***** 모든 채팅 채널방 리스트를 출력합니다. ***** \n");
-                    for(int room_i = 0; room_i < MAX_ROOMS; room_i++){
-                        char tempBuf[BUFSIZ * 2];
-                        // 활성화된 방의 리스트를 모두 모아서 출력한다.
-                        if(rooms[room_i].is_active){
-                            snprintf(tempBuf, sizeof(tempBuf), "[%s] 채널\n", rooms[room_i].roomName);
-                            strcat(sendMsg, tempBuf);
-                        }
-                    }
-                } else {
-                    snprintf(sendMsg, sizeof(sendMsg), "%s", "/LIST 채널방 리스트 출력 명령을 잘못 입력했습니다.");
-                }
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                kill(clients[i].pid, SIGUSR2);
-            }
-            // chat-dev4 : /JOIN 채팅방이름 : 클라이언트가 기존 채팅 채널에서 새 채널로 이동한다.
-            // 단, 기존과 동일한 채널을 선택하거나 없는 채널방이름을 입력했을 땐 그에 따른 주의 문구를 출력함
-            else if(strcmp(ch, "JOIN") == 0){
-                char sendMsg[BUFSIZ];
-
-                // 목적지 채널은 활성화되었지만, 클라이언트가 이미 목적지 채팅채널에 있을 때 처리
-                if(rooms[clients[i].room_idx].is_active && 
-                    strcmp(rooms[clients[i].room_idx].roomName, str) == 0){
-                    snprintf(sendMsg, sizeof(sendMsg), "/JOIN 이미 [%s] 채팅 채널에 있습니다.", str);
-                } 
-                // 목적지 채널도 활성화되어있고, 클라이언트가 현재 있는 채널과 목적지 채널이 다를 때(정상)
-                else if(rooms[clients[i].room_idx].is_active && 
-                    strcmp(rooms[clients[i].room_idx].roomName, str) != 0){
-                    int is_notFound = 1;
-                    snprintf(sendMsg, sizeof(sendMsg), "/JOIN [%s] 채팅 채널에 참가했습니다.", str);
-                    // client data 변경 진행 (채팅 채널 이동)
-                    for(int room_i = 0; room_i < MAX_ROOMS; room_i++){
-                        if(rooms[room_i].is_active && strcmp(rooms[room_i].roomName, str) == 0){
-                            // 채널 이동
-                            clients[i].room_idx = room_i;
-                            is_notFound = 0;
-                            break;
-                        }
-                    }
-                    if(is_notFound){ // 목적지 채널이 비활성화이거나, 입력한 채널명을 가진 채팅채널이 없을 때 처리
-                        snprintf(sendMsg, sizeof(sendMsg), "/JOIN [%s] 채팅 채널이 비활성화이거나, 해당 채팅 채널이 존재하지 않습니다.", str);
-                    }
-                } else { 
-                    snprintf(sendMsg, sizeof(sendMsg), "/JOIN [%s] 잘못된 채팅 채널명을 입력했습니다.", str);
-                }
+        int listen_ready = 0;
+        for (int k = 0; k < n; k++) {
+            uint32_t idx = (uint32_t)(events[k].data.u64 & 0xFFFFFFFFu);
+            int fd = (int)(events[k].data.u64 >> 32);
 
-                write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                kill(clients[i].pid, SIGUSR2);
-            } // chat-dev5 : /WHISPER 사용자이름 메시지 - 서버에 접속한 사용자에게만 귓속말 전달
-            else if(strcmp(ch, "WHISPER") == 0){
-                // 같은 채팅 채널에만 전송하기 위해서 사용할 임시 변수 sender_room
-                int sender_room = clients[i].room_idx;
-                
-                // 귓속말 메시지 파싱 
-                char fromnickName[51];
-                char toNickNameAndmsg[BUFSIZ];
-                char toNickName[51];
-                char msg[BUFSIZ];
-                char* colon = strchr(str, ':');
-                if (colon != NULL) {
-                    *colon = '\0'; // ':'를 문자열 종료로 바꿈
-                    strcpy(fromnickName, str);
-                    strcpy(toNickNameAndmsg, colon + 1);
-                }
-                colon = strchr(toNickNameAndmsg, ' ');
-                if(colon != NULL){
-                    *colon = '\0'; // ' ' 을 문자열 종료로 바꿈
-                    strcpy(toNickName, toNickNameAndmsg);
-                    strcpy(msg, colon + 1);
-
-                    // whisper 하려는 toNickName 이 현재 접속 유저 중에 있는지 find
-                    int is_alive = 0;
-                    int find_user = -1;
-                    for(int client_i = 0; client_i < MAX_CLIENTS; client_i++){
-                        if(clients[client_i].pid > 0 && strcmp(clients[client_i].nickName, toNickName) == 0 \
-                        && strcmp(clients[i].nickName, toNickName) != 0) {
-                            is_alive = 1;
-                            find_user = client_i; // 귓속말 대상 클라이언트의 clients 인덱스 저장
-                        } 
-                    }
-
-                    char sendMsg[BUFSIZ * 3];
-                    // 귓속말을 하려는 클라이언트가 접속 중이고(pid > 0), 귓속말 요청 클라이언트 닉네임과 실제 접속 중인 닉네임이 일치할 경우(정상)
-                    if(is_alive && find_user != -1){
-                        // chat-dev2 : 채팅을 보낼 때 무슨 채팅 채널에서 보냈는지 를 닉네임 앞에 추가함
-                        // 보낼 메시지를 정돈하여 sendMsg 에 반영
-                        char WhereIsRoomAndNickname[BUFSIZ * 2];
-                        snprintf(WhereIsRoomAndNickname, sizeof(WhereIsRoomAndNickname), "[귓속말] - %s 채널(%d) ", rooms[sender_room].roomName, sender_room);
-                        strcat(WhereIsRoomAndNickname, fromnickName);
-
-                        snprintf(sendMsg, sizeof(sendMsg), "/WHISPER %s:%s", WhereIsRoomAndNickname, msg);
-                        // 귓속말 수신 대상 클라이언트를 관리하는 파이프에 데이터를 작성하고
-                        write(pipe_parent_to_child[find_user][1], sendMsg, strlen(sendMsg));
-                        // 귓속말 수신 대상 클라이언트를 관리하는 자식프로세스에 시그널 알림
-                        kill(clients[find_user].pid, SIGUSR2);
-                        // 귓속말을 보낸 클라이언트에도 파이프에 데이터를 작성 + 자식프로세스에 시그널 알림을 통해서 대화를 주고받도록 함
-                        write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                        kill(clients[i].pid, SIGUSR2);
-                    } else { // 귓속말을 받을 클라이언트가 없음(수신 대상 없을 때)
-                        snprintf(sendMsg, sizeof(sendMsg), "/WHISPER To_%s: %s", toNickName, "사용자가 접속 중인 닉네임을 정확하게 입력하지 않거나 자기 자신한테는 귓속말을 할 수 없습니다.");
-                        // 귓속말을 받을 대상 클라이언트가 없을 때는 귓속말을 보낸 클라이언트 파이프에 작성하고 자식 스트레스에 시그널 알림
-                        write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                        kill(clients[i].pid, SIGUSR2);
-                    }
-                } else { // 귓속말을 받을 대상 닉네임을 명령어 사용 방법(/WHISPER 대상닉네임 메시지) 대로 입력하지 못함. (대상닉네임과 메시지 사이의 공백이 없음)
-                    char sendMsg[BUFSIZ * 3];
-                    snprintf(sendMsg, sizeof(sendMsg), "/WHISPER From_%s: %s", fromnickName, "명령어 사용 방법(/WHISPER 대상닉네임 메시지) 대로 입력했는지 다시 확인해주세요.");
-                    write(pipe_parent_to_child[i][1], sendMsg, strlen(sendMsg));
-                    kill(clients[i].pid, SIGUSR2);
-                }
+            if (idx == EPOLL_LISTEN_ID) {
+                listen_ready = 1;
+                accept_wake_ns = stats_now_ns(); // chat-dev25
+            } else if (idx == EPOLL_ADMIN_ID) {
+                admin_serve(); // chat-dev13
+            } else if (idx == EPOLL_SIGNAL_ID) {
+                signal_fd_read(); // chat-dev26 : SIGCHLD, SIGHUP
+            } else if (idx == EPOLL_TIMER_ID) {
+                server_timer_expired(); // chat-dev27
+            } else if (clients[idx].pid != 0 && ipc_to_parent[idx].efd == fd) {
+                fork_read_child(idx);
             }
         }
+        journal_check_snapshot(); // chat-dev15
+        if (listen_ready) {
+            return;
+        }
     }
 }
 
-// chat-dev1 : sigusr2 핸들러 (자식에서 클라이언트 서버에 메시지 or 데이터 전달)
-void child_sigusr2_handler(int signo){
-    // 7단계 : LOG Redirection
-    char logMsg[BUFSIZ * 2 + 32];
-    char errMsg[BUFSIZ * 2];
-    snprintf(errMsg, sizeof(errMsg), "[INFO] : [자식 pid %d] SIGUSR2 핸들러 발생", getpid()); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
+// chat-dev8 : 자식 - 클라이언트 소켓에서 읽은 프레임을 부모와의 링으로 전달
+// 반환 : 0 계속, -1 연결 종료
+int child_read_client(FrameDecoder* decoder) {
+    IpcChannel* ch = &ipc_to_parent[child_index];
+    // chat-dev2 : 클라이언트로부터 받은 문자열이 / 으로 들어오게 됨
+    ssize_t n = frame_decoder_read(decoder, conn_fd);
+
+    if (n < 0 && errno == EINTR) {
+        return 0;
+    }
+    // 6 단계 : read() 가 <= 0 일 때 graceful 연결 종료 처리를 위한 부분 처리
+    if (n <= 0) {
+        log_write(LOG_WARNING, "[자식 index %d, pid %d] 클라이언트 연결 종료가 감지되어 해당 클라이언트 연결을 종료합니다.", child_index, getpid());
+
+        close(clients[child_index].client_sock_fd);
+        return -1;
+    }
 
-    char buf[BUFSIZ + 10 + 50];
-    int n;
+    // 한 번의 read 로 완성된 프레임들을 링에 연속으로 쓰고, eventfd 알림은 마지막에 한 번만 보냄
+    Frame frame;
+    int ret;
+    while ((ret = frame_decoder_next(decoder, &frame)) == 1) {
+        // 종료 조건 : CMD_QUIT 프레임이 들어올 때 자식을 graceful 종료 처리
+        if (frame.cmd == CMD_QUIT) {
+            ipc_channel_flush(ch);
 
-    // pipe 에서 데이터를 읽고 클라이언트 서버에 write
-    while(1){
-        memset(buf, 0, BUFSIZ); // 버퍼 초기화
-        n = read(pipe_parent_to_child[child_index][0], buf, sizeof(buf)-1);
+            log_write(LOG_INFO, "[pid %d] 클라이언트로부터의 종료 요청 수신으로 해당 클라이언트 연결을 종료합니다.", getpid());
 
-        if(n <= 0){ // 읽을 데이터가 없거나(n=0 또는 n=-1), 에러 발생 시 루프 종료
-            break;
+            close(clients[child_index].client_sock_fd); // 자식에서 종료 시 자신의 conn_fd 를 닫아야 함
+            return -1;
         }
-        if (n > 0) {
-            buf[n] = '\0'; // 문자열 끝 처리
-            write(clients[child_index].client_sock_fd, buf, n); // 클라이언트에게 전송
+
+        log_write(LOG_INFO, "[자식 index %d, pid : %d] 서버의 부모 프로세스에게 메시지(데이터) 전달: /%s %.*s", child_index, getpid(), frame_cmd_name(frame.cmd), BUFSIZ, frame.payload);
+        stats_add_inflated(&frame); // chat-dev22 : 압축 프레임은 디코더가 푼 원본 프레임을 부모에게 전달
+
+        // 링이 가득 찬 경우 부모를 깨운 뒤 부모가 비워줄 때까지 잠시 대기 (최대 프레임 크기 < 링 크기이므로 반드시 들어감)
+        while (ipc_channel_write(ch, frame.raw, frame.raw_len) < 0) {
+            ipc_channel_flush(ch);
+            usleep(1000);
         }
     }
+    ipc_channel_flush(ch);
+
+    if (ret < 0) {
+        // 프레임 길이/명령어가 잘못된 경우 스트림 경계를 더 이상 신뢰할 수 없으므로 연결 종료
+        log_write(LOG_WARNING, "[자식 index %d, pid %d] 잘못된 프레임을 수신하여 해당 클라이언트 연결을 종료합니다.", child_index, getpid());
+
+        frame_write(conn_fd, CMD_ERROR, "잘못된 프레임입니다.", strlen("잘못된 프레임입니다."));
+        close(clients[child_index].client_sock_fd);
+        return -1;
+    }
+    return 0;
 }
 
-// 5단계 : 좀비 프로세스(부모 프로세스가 종료되어도 자식의 "종료" 상태(ex. pid) 가 커널에 남아 있는 상태 - 자원을 사용하진 않음) 회수용
-// chat-dev1 : sigchld 좀비 프로세스 처리(close for clear) 함수 수정(struct 사용에 따라 수정)
-void handle_sigchld(int signo) {
-    pid_t pid;
-    int status;
-    while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
-        for (int i = 0; i < MAX_CLIENTS; i++) {
-            // 파이프 및 클라이언트 소켓 닫기
-            if (clients[i].pid == pid) {
-                // 7단계 : LOG Redirection
-                char logMsg[BUFSIZ * 2 + 32];
-                char errMsg[BUFSIZ * 2];
-                snprintf(errMsg, sizeof(errMsg), "[INFO] : 클라이언트 %d (pid: %d, nick: %s) 접속 종료. 자원 회수 완료.\n", i, pid, clients[i].nickName); // 로그 TYPE 문자열 결합
-                get_timestamp(logMsg, sizeof(logMsg), errMsg);
-                printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-                fflush(stdout);
+// chat-dev8 : 자식 이벤트 루프 - 클라이언트 소켓(→ 부모) 과 부모 → 자식 eventfd(→ 클라이언트) 를 함께 감시
+// chat-dev9 : 현재 방의 방 eventfd(방 로그 → 클라이언트) 도 함께 감시
+// chat-dev16 : 모으기 시간 타이머(--coalesce-us) 도 함께 감시
+void run_fork_child() {
+    struct epoll_event ev;
+    struct epoll_event events[4];
+    int child_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    set_client_nodelay(conn_fd); // chat-dev16
+    // chat-dev17 : disconnect 정책 - 클라이언트가 읽지 않아 전송이 --slow-timeout-ms 동안 막히면 연결 종료
+    // => 방 로그 브로드캐스트는 부모가 자식의 밀림을 알 수 없으므로 자식이 소켓 전송 시간 제한으로 직접 판단
+    if (slow_policy == SLOW_POLICY_DISCONNECT) {
+        struct timeval tv;
+        tv.tv_sec = slow_timeout_ms / 1000;
+        tv.tv_usec = (slow_timeout_ms % 1000) * 1000;
+        setsockopt(conn_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
 
-                close(clients[i].client_sock_fd);
-                close(pipe_child_to_parent[i][0]);
-                close(pipe_parent_to_child[i][1]);
-                // 해당 pid 가 있는 clients 인덱스 에서 pid 0 처리 포함 memset
-                memset(&clients[i], 0, sizeof(ClientData)); // 슬롯 초기화
-                break;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = 0; // 클라이언트 소켓
+    epoll_ctl(child_epoll_fd, EPOLL_CTL_ADD, conn_fd, &ev);
+    ev.data.u32 = 1; // 부모 → 자식 채널
+    epoll_ctl(child_epoll_fd, EPOLL_CTL_ADD, ipc_to_child[child_index].efd, &ev);
+    child_sync_room(child_epoll_fd); // chat-dev9 : 처음 참가한 방(로비) 로그 감시 시작
+    if (coalesce_timer_open() >= 0) {
+        ev.data.u32 = 3; // chat-dev16 : 모으기 시간 타이머
+        epoll_ctl(child_epoll_fd, EPOLL_CTL_ADD, coalesce_timer_fd, &ev);
+    }
+
+    // 자식은 클라이언트의 모든 메시지를 부모에게 전달만 함
+    FrameDecoder decoder;
+    frame_decoder_init(&decoder);
+    int done = 0;
+    while (!done) {
+        int n = epoll_wait(child_epoll_fd, events, 4, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int k = 0; k < n && !done; k++) {
+            if (events[k].data.u32 == 1 || events[k].data.u32 == 2) {
+                if (events[k].data.u32 == 1) {
+                    ipc_channel_clear_event(&ipc_to_child[child_index]);
+                }
+                // chat-dev16 : 처리량 우선 모드는 모은 데이터가 충분히 크지 않으면 타이머가 만료될 때 한 번에 전송
+                if (coalesce_us == 0 || child_pending_bytes() >= COALESCE_BYTES) {
+                    done = (child_deliver(child_epoll_fd) < 0);
+                } else {
+                    coalesce_timer_arm();
+                }
+            } else if (events[k].data.u32 == 3) {
+                coalesce_timer_expired();
+                done = (child_deliver(child_epoll_fd) < 0);
+            } else if (child_read_client(&decoder) < 0) {
+                done = 1;
             }
         }
     }
+    frame_decoder_free(&decoder);
+    close(child_epoll_fd);
 }
 
-// 6단계 : Graceful shutdown 핸들러 추가
-// 고아 프로세스(부모 프로세스가 먼저 종료된 후 자식 프로세스가 여전히 "실행 중" 인 상태 - 실제 자원을 사용)
-// chat-dev1 : clients struct 데이터 구조에 따른 구조 수정
-void graceful_shutdown_handler(int signo) {
-    // 7단계 : LOG Redirection
-    char logMsg[BUFSIZ * 2 + 32];
-    char errMsg[BUFSIZ * 2];
-    snprintf(errMsg, sizeof(errMsg), "[INFO] : [부모 pid %d] 서버 종료 시그널 수신 : 모든 자식 종료 중 ...", getpid()); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
+// chat-dev26 : 클라이언트 표 예약 크기(client_reserve) 만큼 클라이언트별 배열과 공유 용량 제한 생성 (fork 전에 호출)
+// => 큰 배열은 calloc 이 mmap 으로 할당하므로 실제 메모리는 사용한 슬롯의 페이지만 차지
+//    workers 모드의 clients / 닉네임 인덱스는 run_worker_pool 이 worker 공유 메모리에 생성
+int create_client_tables() {
+    server_limits = mmap(NULL, sizeof(ServerLimits), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (server_limits == MAP_FAILED) {
+        return -1;
+    }
+    server_limits->max_clients = max_clients;
+    server_limits->max_rooms = max_rooms;
 
-    for (int i = 0; i < active_client_count; i++) {
-        if (clients[i].pid > 0) {
-            // 활성화된 clients struct 에서 pid 가 활성화된 자식만 종료 요청 
-            kill(clients[i].pid, SIGTERM);
-            waitpid(clients[i].pid, NULL, 0); // 자식 PID 초기화 및 종료될 때까지 기다림
+    size_t n = client_reserve;
+    if (server_mode != SERVER_MODE_WORKERS) {
+        clients = calloc(n, sizeof(ClientData));
+        nick_index_table = calloc(NICK_INDEX_SIZE, sizeof(NameIndexEntry));
+        if (clients == NULL || nick_index_table == NULL) {
+            return -1;
         }
+        name_index_init(nick_index, nick_index_table, NICK_INDEX_SIZE, client_nick_of); // chat-dev11
     }
-    close(listen_fd);
-    close(file_fd);
-
-    // 7단계 : LOG Redirection
-    char logMsg2[BUFSIZ * 2 + 32];
-    char errMsg2[BUFSIZ * 2];
-    snprintf(errMsg2, sizeof(errMsg2), "[INFO] : [부모 pid %d] 서버 종료 완료. 자원 회수 완료.", getpid()); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg2, sizeof(logMsg2), errMsg2);
-    printf("\n%s", logMsg2); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
-
-    exit(0);
+    slow_consumers = calloc(n, sizeof(SlowConsumer));
+    ipc_to_child = calloc(n, sizeof(IpcChannel));
+    ipc_to_parent = calloc(n, sizeof(IpcChannel));
+    client_out = calloc(n, sizeof(OutBuffer));
+    client_dirty = calloc(n, sizeof(int));
+    dirty_clients = calloc(n, sizeof(int));
+    client_in = calloc(n, sizeof(FrameDecoder));
+    uring_sends = calloc(n, sizeof(UringSend));
+    uring_gen = calloc(n, sizeof(uint32_t));
+    room_deliver_members = calloc(n, sizeof(int)); // chat-dev11
+    heartbeats = calloc(n, sizeof(ClientHeartbeat)); // chat-dev27
+    if (slow_consumers == NULL || ipc_to_child == NULL || ipc_to_parent == NULL || client_out == NULL || client_dirty == NULL ||
+        dirty_clients == NULL || client_in == NULL || uring_sends == NULL || uring_gen == NULL || heartbeats == NULL ||
+        room_deliver_members == NULL) {
+        return -1;
+    }
+    return 0;
 }
 
-// 6 단계 : 자식 프로세스 쪽 sigterm handler
-void child_sigterm_handler(int signo) {
-    // 7단계 : LOG Redirection
-    char logMsg[BUFSIZ * 2 + 32];
-    char errMsg[BUFSIZ * 2];
-    snprintf(errMsg, sizeof(errMsg), "[INFO] : [자식 pid %d] 종료 시그널 수신. 종료 중...", getpid()); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
-
-    close(clients[child_index].client_sock_fd); // 클라이언트와 연결된 소켓 닫기
-    close(pipe_child_to_parent[child_index][1]); // 부모에게 쓰는 파이프 닫기
-    close(pipe_parent_to_child[child_index][0]); // 부모로부터 읽는 파이프 닫기
+// chat-dev26 : 설정 파일 / 다시 읽기 상태
+const char* config_path = NULL; // --config (NULL : 설정 파일 없이 실행 인자만 사용)
+int config_reloading = 0;       // SIGHUP 으로 다시 읽는 중 (용량 제한만 적용)
+int server_argc;
+char** server_argv;             // 다시 읽을 때도 실행 인자가 설정 파일보다 우선하도록 보관
+char** config_applied;          // 시작할 때 적용한 설정 ("--키=값") - 다시 읽을 때 재시작이 필요한 값이 바뀌었는지 비교
+int config_applied_count = 0;
+int server_option(const char* arg);
 
-    exit(0); 
+// SIGHUP 으로 다시 읽을 수 있는 설정 (용량 제한)
+int config_option_reloadable(const char* arg) {
+    static const char* reloadable[] = { "--max-clients=", "--max-rooms=", "--conn-rate=", "--conn-burst=", "--log-level=" };
+    for (size_t k = 0; k < sizeof(reloadable) / sizeof(reloadable[0]); k++) {
+        if (strncmp(arg, reloadable[k], strlen(reloadable[k])) == 0) {
+            return 1;
+        }
+    }
+    return 0;
 }
 
-// sigaction 커스텀 함수
-/*
-    sigaction : signal 로 시그널이 발생할 때 다시 동일한 시그널이 발생할 때
-        이전 시그널을 처리하는 동안 시그널이 블록되어 처리되지 않고 버려지는 경우를 해결하는 
-        더 향상된 시그널 처리 함수
-*/
-void register_sigaction(int signo, void (*handler)(int)) {
-    // 시그널 처리를 위한 시그널 액션
-    struct sigaction sa;
-    memset(&sa, 0, sizeof(sa));
-
-    // 터미널 제어 관련 시그널 관리
-    sa.sa_handler = handler; // 시그널 발생 시 실행할 핸들러 지정
-    sigemptyset(&sa.sa_mask); // 모든 시그널 허용
-    sa.sa_flags = SA_RESTART; // 시그널 처리에 의해 방해받은 시스템 호출을 시그널 처리가 끝나면 재시작
-
-    // 시그널 처리 동작 처리
-    if (sigaction(signo, &sa, NULL) == -1) {
-        // 7단계 : LOG Redirection
-        char logMsg[BUFSIZ * 2 + 32];
-        char errMsg[BUFSIZ * 2];
-        snprintf(errMsg, sizeof(errMsg), "[ERROR] : 시그널 처리 동작이 실패하였습니다."); // 로그 TYPE 문자열 결합
-        get_timestamp(logMsg, sizeof(logMsg), errMsg);
-        printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-        fflush(stdout);
+// 문자열 설정 값 복사 (설정 파일의 줄은 config_load 의 지역 버퍼이므로 그 안을 가리키면 읽은 뒤 사라짐)
+// 반환 : 복사본, NULL 메모리 부족 (stderr 출력)
+const char* config_string(const char* value) {
+    char* copy = strdup(value);
+    if (copy == NULL) {
+        fprintf(stderr, "설정 값을 저장할 메모리가 부족합니다.\n");
+    }
+    return copy;
+}
 
-        exit(1);
+// 시작할 때 적용한 설정 기록
+void config_note(const char* arg) {
+    char** grown = realloc(config_applied, sizeof(char*) * (config_applied_count + 1));
+    if (grown == NULL) {
+        return;
+    }
+    config_applied = grown;
+    config_applied[config_applied_count] = strdup(arg);
+    if (config_applied[config_applied_count] != NULL) {
+        config_applied_count++;
     }
 }
 
-// 7 단계 : 서버 데몬화 처리 
-// -> 서버 실행 시 백그라운드로 전환하고, printf 들을 별도 데일리 로그 파일에서 출력하도록 리디렉션 처리
-void daemonize_with_log() {
-    pid_t pid;
+// 다시 읽은 설정 중 재시작해야 적용되는 값이 시작할 때와 다르면 경고
+void config_check_unchanged(const char* arg) {
+    for (int k = 0; k < config_applied_count; k++) {
+        if (strcmp(config_applied[k], arg) == 0) {
+            return;
+        }
+    }
+    log_write(LOG_WARNING, "설정 %s 는 서버를 다시 시작해야 적용됩니다.", arg);
+}
 
-    umask(0); // 파일 생성을 위한 마스크를 0 으로 설정
+// chat-dev26 : 용량 제한 값 확인 및 기본값 채우기 (reloading : SIGHUP 으로 다시 읽는 중 - 예약 크기를 넘는 상한은 예약 크기로 줄임)
+// 반환 0 : 적용 가능, -1 : 잘못된 조합
+int server_check_limits(int reloading) {
+    // chat-dev25 : IP 별 연속 연결 수는 속도 제한을 켤 때만 사용하고, 지정하지 않으면 초당 연결 수의 2 배
+    if (conn_burst > 0 && conn_rate == 0) {
+        fprintf(stderr, "--conn-burst 는 --conn-rate 와 함께 사용해야 합니다.\n");
+        return -1;
+    }
+    if (conn_burst < 0) {
+        conn_burst = conn_rate * 2;
+    }
+    // 시작할 때는 상한에 맞춰 예약 크기를 늘리고, 실행 중에는 예약 크기 안에서만 바꿈 (표는 다시 시작해야 커짐)
+    if (max_rooms < 0) {
+        max_rooms = room_capacity;
+    }
+    if (!reloading) {
+        if (client_reserve < max_clients) {
+            client_reserve = max_clients;
+        }
+        if (room_capacity < max_rooms) {
+            room_capacity = max_rooms;
+        }
+        return 0;
+    }
+    if (max_clients > client_reserve) {
+        log_write(LOG_WARNING, "동시 접속 상한 %d 이 클라이언트 표 예약 크기보다 커서 %d 로 줄입니다. (예약 크기는 다시 시작해야 바뀝니다)", max_clients, client_reserve);
+        max_clients = client_reserve;
+    }
+    if (max_rooms > room_capacity) {
+        log_write(LOG_WARNING, "채팅 채널 상한 %d 이 채팅 채널 수용량보다 커서 %d 로 줄입니다. (수용량은 다시 시작해야 바뀝니다)", max_rooms, room_capacity);
+        max_rooms = room_capacity;
+    }
+    return 0;
+}
 
-    // fork() 로 자식 프로세스를 생성 하고 부모 프로세스는 종료
-    pid = fork();
-    if (pid < 0) exit(1);
-    if (pid > 0) exit(0); // 부모 종료
+// chat-dev26 : 확인한 용량 제한을 모든 서버 프로세스가 보는 공유 메모리에 반영
+void server_publish_limits() {
+    int locked = (worker_shared != NULL); // workers 모드 - worker 들이 쓰는 속도 제한 표와 같이 바꿈 (시작할 때는 worker 가 없음)
+    if (locked) {
+        shared_lock();
+    }
+    __atomic_store_n(&server_limits->max_clients, max_clients, __ATOMIC_RELAXED);
+    __atomic_store_n(&server_limits->max_rooms, max_rooms, __ATOMIC_RELAXED);
+    admission->rate = conn_rate;
+    admission->burst = conn_burst;
+    if (locked) {
+        shared_unlock();
+    }
+    server_stats->client_limit = max_clients;
+    server_stats->room_limit = max_rooms;
+}
 
-    // 자식 프로세스를 세션 리더로 만들어 터미널 조작을 못하게 함
-    if (setsid() < 0) exit(1);
+// chat-dev26 : SIGHUP - 설정 파일과 실행 인자를 다시 읽어 용량 제한 적용 (연결 / 채널은 그대로 유지)
+// => 파일에서 지운 키가 기본값으로 돌아가도록 용량 제한을 기본값으로 되돌린 뒤 설정 파일 → 실행 인자 순서로 다시 적용
+//    fork 모드 부모, epoll 모드 이벤트 루프, workers 모드 최상위 프로세스가 처리 (다른 프로세스는 SIGHUP 을 막아 둠)
+void server_reload() {
+    int saved_max_clients = max_clients;
+    int saved_max_rooms = max_rooms;
+    int saved_conn_rate = conn_rate;
+    int saved_conn_burst = conn_burst;
+    int saved_log_level = server_log_level;
+    max_clients = MAX_CLIENTS;
+    max_rooms = -1;
+    conn_rate = 0;
+    conn_burst = -1;
+    server_log_level = LOG_INFO;
 
-    chdir("./"); // 현재 디렉토리로 이동
+    config_reloading = 1;
+    int ret = 0;
+    if (config_path != NULL) {
+        ret = config_load(config_path, server_option);
+    }
+    for (int i = 1; ret == 0 && i < server_argc; i++) {
+        ret = server_option(server_argv[i]);
+    }
+    config_reloading = 0;
+    if (ret < 0 || server_check_limits(1) < 0) {
+        max_clients = saved_max_clients;
+        max_rooms = saved_max_rooms;
+        conn_rate = saved_conn_rate;
+        conn_burst = saved_conn_burst;
+        server_log_level = saved_log_level;
+        log_write(LOG_ERROR, "설정(%s) 을 다시 읽지 못해 이전 설정을 유지합니다.", config_path != NULL ? config_path : "실행 인자");
+        return;
+    }
+    server_publish_limits();
+    log_set_level(server_log_level);
+    stats_add(&server_stats->config_reloads, 1);
+    log_write(LOG_WARNING, "설정을 다시 읽었습니다. (동시 접속 상한 %d / 현재 %d, 채팅 채널 상한 %d / 현재 %d, IP 별 초당 연결 %d, 로그 레벨 %d)",
+              max_clients, server_limits->clients, max_rooms, server_limits->rooms, conn_rate, server_log_level);
+}
 
-    // 표준 입력 닫기
-    close(STDIN_FILENO);
+// chat-dev26 : 실행 인자 하나 / 설정 파일 한 줄 ("--키=값") 적용 - main 의 실행 인자 처리에서 분리 (반환 0 : 적용, -1 : 잘못된 값)
+// => SIGHUP 으로 다시 읽을 때는 용량 제한만 바꾸고, 나머지 설정은 시작할 때와 값이 다르면 경고만 남김
+int server_option(const char* arg) {
+    if (config_reloading) {
+        if (!config_option_reloadable(arg)) {
+            config_check_unchanged(arg);
+            return 0;
+        }
+    } else {
+        config_note(arg);
+    }
 
-    // 로그 디렉토리 생성 (이미 있는 경우는 무시하도록 함)
-    if(mkdir("./logs", 0755) == -1){
-        if(errno != EEXIST){ // 디렉토리가 이미 있으면 무시 또는 생성 실패 시 처리
-            perror("mkdir");
-            exit(EXIT_FAILURE);
+    // chat-dev6 : 실행 인자로 서버 모드 선택 (기본 : fork 모드)
+    if (strcmp(arg, "--mode=fork") == 0) {
+        server_mode = SERVER_MODE_FORK;
+    } else if (strcmp(arg, "--mode=epoll") == 0) {
+        server_mode = SERVER_MODE_EPOLL;
+    } else if (strcmp(arg, "--mode=workers") == 0) {
+        server_mode = SERVER_MODE_WORKERS;
+    } else if (strncmp(arg, "--rooms=", strlen("--rooms=")) == 0) {
+        // chat-dev11 : 채팅 채널 수용량 (로비 포함)
+        room_capacity = atoi(arg + strlen("--rooms="));
+        if (room_capacity < 1 || room_capacity > MAX_ROOMS_LIMIT) {
+            fprintf(stderr, "채팅 채널 수는 1 ~ %d 사이여야 합니다.\n", MAX_ROOMS_LIMIT);
+            return -1;
+        }
+    } else if (strncmp(arg, "--log-level=", strlen("--log-level=")) == 0) {
+        // chat-dev12 : 기록할 최대 로그 레벨 (error < warning < info)
+        server_log_level = log_parse_level(arg + strlen("--log-level="));
+        if (server_log_level < 0) {
+            fprintf(stderr, "로그 레벨은 error, warning, info 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--log-flush-ms=", strlen("--log-flush-ms=")) == 0) {
+        // chat-dev12 : 로그 flusher 가 쌓인 줄을 파일에 쓰는 주기
+        log_flush_ms = atoi(arg + strlen("--log-flush-ms="));
+        if (log_flush_ms < 1 || log_flush_ms > 10000) {
+            fprintf(stderr, "로그 flush 주기는 1 ~ 10000 ms 사이여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--admin-socket=", strlen("--admin-socket=")) == 0) {
+        // chat-dev13 : 관리용 UNIX 도메인 소켓 경로 (빈 값 : 사용 안 함)
+        // chat-dev26 : 설정 파일에서 온 값도 유지되도록 복사
+        if ((admin_path = config_string(arg + strlen("--admin-socket="))) == NULL) {
+            return -1;
+        }
+    } else if (strncmp(arg, "--history=", strlen("--history=")) == 0) {
+        // chat-dev14 : 채팅 채널당 최근 메시지 기록 최대 개수 (0 : 사용 안 함)
+        history_msgs = atoi(arg + strlen("--history="));
+        if (history_msgs < 0 || history_msgs > 10000) {
+            fprintf(stderr, "최근 메시지 기록 개수는 0 ~ 10000 사이여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--history-bytes=", strlen("--history-bytes=")) == 0) {
+        // chat-dev14 : 채팅 채널당 최근 메시지 기록 최대 바이트
+        history_bytes = atoi(arg + strlen("--history-bytes="));
+        if (history_bytes < 1024 || history_bytes > HISTORY_REPLAY_MAX) {
+            fprintf(stderr, "최근 메시지 기록 바이트는 1024 ~ %d 사이여야 합니다.\n", HISTORY_REPLAY_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--journal=", strlen("--journal=")) == 0) {
+        // chat-dev15 : 저널 파일 경로 (빈 값 : 사용 안 함, 스냅샷은 경로 + ".snapshot")
+        // chat-dev26 : 설정 파일에서 온 값도 유지되도록 복사
+        if ((journal_path = config_string(arg + strlen("--journal="))) == NULL) {
+            return -1;
+        }
+    } else if (strncmp(arg, "--journal-size=", strlen("--journal-size=")) == 0) {
+        // chat-dev15 : 저널 데이터 영역 크기 (MB)
+        int mb = atoi(arg + strlen("--journal-size="));
+        if (mb < 1 || mb > 4096) {
+            fprintf(stderr, "저널 크기는 1 ~ 4096 MB 사이여야 합니다.\n");
+            return -1;
+        }
+        journal_size = (size_t)mb << 20;
+    } else if (strncmp(arg, "--journal-sync=", strlen("--journal-sync=")) == 0) {
+        // chat-dev15 : 저널 디스크 동기화 정책
+        journal_sync = journal_parse_sync(arg + strlen("--journal-sync="));
+        if (journal_sync < 0) {
+            fprintf(stderr, "저널 동기화 정책은 off, batch, always 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--journal-sync-ms=", strlen("--journal-sync-ms=")) == 0) {
+        // chat-dev15 : batch 정책의 동기화 주기
+        journal_sync_ms = atoi(arg + strlen("--journal-sync-ms="));
+        if (journal_sync_ms < 1 || journal_sync_ms > 10000) {
+            fprintf(stderr, "저널 동기화 주기는 1 ~ 10000 ms 사이여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--coalesce-us=", strlen("--coalesce-us=")) == 0) {
+        // chat-dev16 : 클라이언트 전송 모으기 시간 (0 : 지연 우선, N : 최대 N us 모아서 전송)
+        coalesce_us = atoi(arg + strlen("--coalesce-us="));
+        if (coalesce_us < 0 || coalesce_us > COALESCE_US_MAX) {
+            fprintf(stderr, "전송 모으기 시간은 0 ~ %d us 사이여야 합니다.\n", COALESCE_US_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--out-queue=", strlen("--out-queue=")) == 0) {
+        // chat-dev17 : 클라이언트별 송신 큐 상한 (KB)
+        out_queue_kb = atoi(arg + strlen("--out-queue="));
+        if (out_queue_kb < OUT_QUEUE_KB || out_queue_kb > OUT_QUEUE_KB_MAX) {
+            fprintf(stderr, "송신 큐 상한은 %d ~ %d KB 사이여야 합니다.\n", OUT_QUEUE_KB, OUT_QUEUE_KB_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--out-queue-low=", strlen("--out-queue-low=")) == 0) {
+        // chat-dev17 : 느린 클라이언트 표시를 해제하는 송신 큐 하한 (KB, 기본 : 상한의 절반)
+        out_queue_low_kb = atoi(arg + strlen("--out-queue-low="));
+        if (out_queue_low_kb < 0) {
+            fprintf(stderr, "송신 큐 하한은 0 KB 이상이어야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--slow-policy=", strlen("--slow-policy=")) == 0) {
+        // chat-dev17 : 송신 큐 상한을 넘은 느린 클라이언트 처리 정책
+        const char* name = arg + strlen("--slow-policy=");
+        slow_policy = -1;
+        for (int p = 0; p < (int)(sizeof(slow_policy_names) / sizeof(slow_policy_names[0])); p++) {
+            if (strcmp(name, slow_policy_names[p]) == 0) {
+                slow_policy = p;
+            }
+        }
+        if (slow_policy < 0) {
+            fprintf(stderr, "느린 클라이언트 정책은 drop-newest, drop-oldest, disconnect 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--slow-timeout-ms=", strlen("--slow-timeout-ms=")) == 0) {
+        // chat-dev17 : disconnect 정책에서 연결을 종료하기까지 기다리는 시간
+        slow_timeout_ms = atoi(arg + strlen("--slow-timeout-ms="));
+        if (slow_timeout_ms < 1 || slow_timeout_ms > 600000) {
+            fprintf(stderr, "느린 클라이언트 종료 시간은 1 ~ 600000 ms 사이여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--zero-copy=", strlen("--zero-copy=")) == 0) {
+        // chat-dev18 : fork 모드 방 로그 복사 없는 전달 사용 여부
+        const char* value = arg + strlen("--zero-copy=");
+        if (strcmp(value, "on") == 0) {
+            zero_copy = 1;
+        } else if (strcmp(value, "off") == 0) {
+            zero_copy = 0;
+        } else {
+            fprintf(stderr, "복사 없는 전달 설정은 on, off 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--io-engine=", strlen("--io-engine=")) == 0) {
+        // chat-dev19 : epoll / workers 모드 입출력 엔진
+        const char* value = arg + strlen("--io-engine=");
+        if (strcmp(value, "epoll") == 0) {
+            io_engine = IO_ENGINE_EPOLL;
+        } else if (strcmp(value, "uring") == 0) {
+            io_engine = IO_ENGINE_URING;
+        } else {
+            fprintf(stderr, "입출력 엔진은 epoll, uring 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--compress=", strlen("--compress=")) == 0) {
+        // chat-dev22 : 클라이언트와 프레임 압축 협상 여부
+        const char* value = arg + strlen("--compress=");
+        if (strcmp(value, "on") == 0) {
+            compress_enabled = 1;
+        } else if (strcmp(value, "off") == 0) {
+            compress_enabled = 0;
+        } else {
+            fprintf(stderr, "압축 설정은 on, off 중 하나여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--compress-min=", strlen("--compress-min=")) == 0) {
+        // chat-dev22 : 압축할 최소 프레임 크기 (헤더 포함 바이트)
+        compress_min = atoi(arg + strlen("--compress-min="));
+        if (compress_min < COMPRESS_MIN_LOW || compress_min > FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD) {
+            fprintf(stderr, "압축 최소 크기는 %d ~ %d 바이트 사이여야 합니다.\n", COMPRESS_MIN_LOW, FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD);
+            return -1;
+        }
+    } else if (strncmp(arg, "--backlog=", strlen("--backlog=")) == 0) {
+        // chat-dev25 : listen 대기 큐 크기
+        listen_backlog = atoi(arg + strlen("--backlog="));
+        if (listen_backlog < 1 || listen_backlog > LISTEN_BACKLOG_MAX) {
+            fprintf(stderr, "listen 대기 큐 크기는 1 ~ %d 사이여야 합니다.\n", LISTEN_BACKLOG_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--accept-batch=", strlen("--accept-batch=")) == 0) {
+        // chat-dev25 : listen 소켓이 준비될 때마다 연속으로 받아들일 최대 연결 수
+        accept_batch = atoi(arg + strlen("--accept-batch="));
+        if (accept_batch < 1 || accept_batch > ACCEPT_BATCH_MAX) {
+            fprintf(stderr, "연속 수락 연결 수는 1 ~ %d 사이여야 합니다.\n", ACCEPT_BATCH_MAX);
+            return -1;
         }
+    } else if (strncmp(arg, "--conn-rate=", strlen("--conn-rate=")) == 0) {
+        // chat-dev25 : 출발지 IP 별 초당 연결 수 (0 : 제한 없음)
+        conn_rate = atoi(arg + strlen("--conn-rate="));
+        if (conn_rate < 0 || conn_rate > CONN_RATE_MAX) {
+            fprintf(stderr, "IP 별 초당 연결 수는 0 ~ %d 사이여야 합니다.\n", CONN_RATE_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--conn-burst=", strlen("--conn-burst=")) == 0) {
+        // chat-dev25 : 출발지 IP 별 연속으로 받아들일 수 있는 연결 수
+        conn_burst = atoi(arg + strlen("--conn-burst="));
+        if (conn_burst < 1 || conn_burst > CONN_RATE_MAX) {
+            fprintf(stderr, "IP 별 연속 연결 수는 1 ~ %d 사이여야 합니다.\n", CONN_RATE_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--workers=", strlen("--workers=")) == 0) {
+        worker_count = atoi(arg + strlen("--workers="));
+        if (worker_count < 1 || worker_count > MAX_WORKERS) {
+            fprintf(stderr, "worker 수는 1 ~ %d 사이여야 합니다.\n", MAX_WORKERS);
+            return -1;
+        }
+    } else if (strncmp(arg, "--config=", strlen("--config=")) == 0) {
+        // chat-dev26 : 설정 파일은 main 이 실행 인자보다 먼저 읽음
+    } else if (strncmp(arg, "--listen=", strlen("--listen=")) == 0) {
+        // chat-dev26 : listen 주소
+        if ((listen_host = config_string(arg + strlen("--listen="))) == NULL) {
+            return -1;
+        }
+        if (inet_pton(AF_INET, listen_host, &listen_addr) != 1) {
+            fprintf(stderr, "listen 주소는 IPv4 주소여야 합니다. (%s)\n", listen_host);
+            return -1;
+        }
+    } else if (strncmp(arg, "--port=", strlen("--port=")) == 0) {
+        // chat-dev26 : listen 포트
+        listen_port = atoi(arg + strlen("--port="));
+        if (listen_port < 1 || listen_port > 65535) {
+            fprintf(stderr, "포트는 1 ~ 65535 사이여야 합니다.\n");
+            return -1;
+        }
+    } else if (strncmp(arg, "--max-clients=", strlen("--max-clients=")) == 0) {
+        // chat-dev26 : 동시 접속 상한 (SIGHUP 으로 다시 읽음)
+        max_clients = atoi(arg + strlen("--max-clients="));
+        if (max_clients < 1 || max_clients > CLIENT_RESERVE_LIMIT) {
+            fprintf(stderr, "동시 접속 상한은 1 ~ %d 사이여야 합니다.\n", CLIENT_RESERVE_LIMIT);
+            return -1;
+        }
+    } else if (strncmp(arg, "--client-reserve=", strlen("--client-reserve=")) == 0) {
+        // chat-dev26 : 클라이언트 표 예약 크기 (실행 중 동시 접속 상한을 늘릴 수 있는 최대값)
+        client_reserve = atoi(arg + strlen("--client-reserve="));
+        if (client_reserve < 1 || client_reserve > CLIENT_RESERVE_LIMIT) {
+            fprintf(stderr, "클라이언트 표 예약 크기는 1 ~ %d 사이여야 합니다.\n", CLIENT_RESERVE_LIMIT);
+            return -1;
+        }
+    } else if (strncmp(arg, "--max-rooms=", strlen("--max-rooms=")) == 0) {
+        // chat-dev26 : 활성 채팅 채널 상한 (로비 포함, SIGHUP 으로 다시 읽음)
+        max_rooms = atoi(arg + strlen("--max-rooms="));
+        if (max_rooms < 1 || max_rooms > MAX_ROOMS_LIMIT) {
+            fprintf(stderr, "채팅 채널 상한은 1 ~ %d 사이여야 합니다.\n", MAX_ROOMS_LIMIT);
+            return -1;
+        }
+    } else if (strncmp(arg, "--ping-interval=", strlen("--ping-interval=")) == 0) {
+        // chat-dev27 : 아무 프레임도 받지 못한 연결에 PING 을 보낼 간격 (초, 0 : 보내지 않음)
+        ping_interval = atoi(arg + strlen("--ping-interval="));
+        if (ping_interval < 0 || ping_interval > HEARTBEAT_MAX) {
+            fprintf(stderr, "PING 간격은 0 ~ %d 초 사이여야 합니다.\n", HEARTBEAT_MAX);
+            return -1;
+        }
+    } else if (strncmp(arg, "--idle-timeout=", strlen("--idle-timeout=")) == 0) {
+        // chat-dev27 : 아무 프레임도 받지 못하면 연결을 끊을 시간 (초, 0 : 끊지 않음)
+        idle_timeout = atoi(arg + strlen("--idle-timeout="));
+        if (idle_timeout < 0 || idle_timeout > HEARTBEAT_MAX) {
+            fprintf(stderr, "유휴 시간 제한은 0 ~ %d 초 사이여야 합니다.\n", HEARTBEAT_MAX);
+            return -1;
+        }
+    } else {
+        fprintf(stderr, "사용법: %s [--mode=fork|--mode=epoll|--mode=workers] [--workers=N] [--rooms=N] [--log-level=error|warning|info] [--log-flush-ms=N] [--admin-socket=PATH] [--history=N] [--history-bytes=N] [--journal=PATH] [--journal-size=MB] [--journal-sync=off|batch|always] [--journal-sync-ms=N] [--coalesce-us=N] [--out-queue=KB] [--out-queue-low=KB] [--slow-policy=drop-newest|drop-oldest|disconnect] [--slow-timeout-ms=N] [--zero-copy=on|off] [--io-engine=epoll|uring] [--compress=on|off] [--compress-min=BYTES] [--backlog=N] [--accept-batch=N] [--conn-rate=N] [--conn-burst=N] [--config=PATH] [--listen=ADDR] [--port=N] [--max-clients=N] [--client-reserve=N] [--max-rooms=N] [--ping-interval=SEC] [--idle-timeout=SEC]\n", server_argv[0]);
+        return -1;
     }
+    return 0;
+}
 
-    // 날짜별 로그 파일명 생성
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
-    char logfile[256];
-    snprintf(logfile, sizeof(logfile), "./logs/chattingServer_%04d%02d%02d.log",
-             t->tm_year + 1900, t->tm_mon + 1, t->tm_mday);
+int main(int argc, char** argv) {
+    // chat-dev26 : 설정 파일(--config) 을 먼저 적용하고 실행 인자로 덮어씀 (SIGHUP 때도 같은 순서로 다시 읽음)
+    server_argc = argc;
+    server_argv = argv;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--config=", strlen("--config=")) == 0) {
+            config_path = argv[i] + strlen("--config=");
+        }
+    }
+    if (config_path != NULL && config_load(config_path, server_option) < 0) {
+        return -1;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (server_option(argv[i]) < 0) {
+            return -1;
+        }
+    }
+    // chat-dev17 : 송신 큐 하한은 상한보다 작아야 함 (지정하지 않으면 상한의 절반)
+    if (out_queue_low_kb < 0) {
+        out_queue_low_kb = out_queue_kb / 2;
+    }
+    if (out_queue_low_kb >= out_queue_kb) {
+        fprintf(stderr, "송신 큐 하한은 상한(%d KB) 보다 작아야 합니다.\n", out_queue_kb);
+        return -1;
+    }
+    // chat-dev27 : 유휴 시간 제한 안에 PING 응답을 받을 수 있도록 PING 간격이 더 짧아야 함
+    if (ping_interval > 0 && idle_timeout > 0 && ping_interval >= idle_timeout) {
+        fprintf(stderr, "PING 간격(%d 초) 은 유휴 시간 제한(%d 초) 보다 짧아야 합니다.\n", ping_interval, idle_timeout);
+        return -1;
+    }
+    // chat-dev19 : io_uring 엔진은 이벤트 루프가 클라이언트 소켓을 처리하는 모드에서만 사용
+    if (io_engine == IO_ENGINE_URING && server_mode == SERVER_MODE_FORK) {
+        fprintf(stderr, "io_uring 입출력 엔진은 --mode=epoll 또는 --mode=workers 에서만 사용할 수 있습니다.\n");
+        return -1;
+    }
+    // chat-dev26 : 용량 제한 확인 (시작할 때는 상한에 맞춰 예약 크기를 늘림)
+    if (server_check_limits(0) < 0) {
+        return -1;
+    }
+    out_queue_high = (size_t)out_queue_kb << 10;
+    out_queue_low = (size_t)out_queue_low_kb << 10;
+    while (out_queue_ring < out_queue_high) {
+        out_queue_ring <<= 1;
+    }
 
-    // 로그 파일 열기
-    file_fd = open(logfile, O_WRONLY | O_CREAT | O_APPEND, 0644);
-    if (file_fd < 0) exit(1); // 로그 파일 열기 실패 시 종료
+    // chat-dev10 : worker 수를 지정하지 않으면 코어 수만큼 생성
+    if (worker_count == 0) {
+        worker_count = sysconf(_SC_NPROCESSORS_ONLN);
+        if (worker_count < 1) {
+            worker_count = 1;
+        }
+        if (worker_count > MAX_WORKERS) {
+            worker_count = MAX_WORKERS;
+        }
+    }
 
-    // stdout, stderr 을 로그 파일로 리디렉션
-    dup2(file_fd, STDOUT_FILENO); // printf()
-    dup2(file_fd, STDERR_FILENO); // perror(), fprintf(stderr, ...)
-}
+    // chat-dev26 : 클라이언트별 표와 공유 용량 제한 생성 (fork 전에 생성)
+    if (create_client_tables() < 0) {
+        perror("mmap");
+        return -1;
+    }
+    // chat-dev11 : 채팅 채널 레지스트리 생성 (fork 모드 자식, workers 모드 worker 가 물려받도록 fork 전에 생성)
+    if (create_room_table() < 0) {
+        perror("mmap");
+        return -1;
+    }
+    // chat-dev13 : 서버 지표 공유 메모리 (모든 서버 프로세스가 갱신하도록 fork 전에 생성)
+    if (stats_init(client_reserve) < 0) {
+        perror("mmap");
+        return -1;
+    }
+    msgbuf_pool_init(&server_stats->msgbuf); // chat-dev24 : 메시지 버퍼 풀 지표를 공유 메모리에 기록
+    // chat-dev25 : 출발지 IP 별 연결 속도 제한 표 (workers 모드 worker 들이 함께 쓰도록 fork 전에 생성)
+    // chat-dev26 : SIGHUP 으로 속도 제한을 켤 수 있도록 항상 생성 (rate 0 : 제한 없음)
+    if ((admission = admission_create(conn_rate, conn_burst)) == NULL) {
+        perror("mmap");
+        return -1;
+    }
+    server_publish_limits(); // chat-dev26
+    // chat-dev14 : 채팅 채널별 최근 메시지 기록 공유 메모리 (채널 레지스트리와 같이 fork 전에 생성)
+    if (room_history_create(&room_history, room_capacity, history_msgs, history_bytes) < 0) {
+        perror("mmap");
+        return -1;
+    }
+    stats_set_rooms(room_capacity, room_history.max_msgs > 0 ? room_history.stride : 0, stats_room_info);
 
-int main(int argc, char** argv) {
-    // 데이터 구조 초기화
-    memset(clients, 0, sizeof(clients));
-    memset(rooms, 0, sizeof(rooms));
-    strcpy(rooms[0].roomName, "lobby");
-    rooms[0].is_active = 1;
+    // chat-dev26 : SIGHUP(설정 다시 읽기) 블록 - fork 모드 부모 / epoll 모드는 signalfd, workers 모드 최상위 프로세스는 sigwaitinfo 로 받음
+    // => 이후 생성하는 자식 프로세스, worker 는 블록된 상태를 물려받아 SIGHUP 에 종료되지 않음
+    sigset_t hup_mask;
+    sigemptyset(&hup_mask);
+    sigaddset(&hup_mask, SIGHUP);
+    sigprocmask(SIG_BLOCK, &hup_mask, NULL);
 
     // 7 단계 : 서버 데몬화 처리
     daemonize_with_log();
 
-    // 4단계: 부모에서 시그널 핸들러 SIGUSR1 등록
-    register_sigaction(SIGUSR1, sigusr1_handler); 
-    // 5단계 : 좀비 프로세스(자식이 종료된 후 PID 만 남아서 자원 누수가 발생하는 프로세스) 방지
-    // -> 자식이 종료될 경우 자원을 회수하여 좀비 프로세스가 남지 않도록 함
-    register_sigaction(SIGCHLD, handle_sigchld); 
+    // chat-dev12 : 로그 링 생성 및 flusher 프로세스 시작 (stdout 이 로그 파일로 바뀐 뒤, 다른 프로세스를 fork 하기 전)
+    if (log_init(server_log_level, log_flush_ms) < 0) {
+        log_write(LOG_WARNING, "로그 링 생성 실패 - 로그를 줄마다 바로 기록합니다. (%s)", strerror(errno));
+    }
+
+    // chat-dev15 : 저널로 채팅 채널과 최근 메시지 복구 (daemonize 후 작업 디렉토리 기준 경로, 서버 프로세스들을 fork 하기 전)
+    if (journal_path[0] != '\0') {
+        journal_restore();
+    }
+
+    // chat-dev13 : 관리용 소켓 생성 (daemonize 후 작업 디렉토리 기준 경로, workers 모드 worker 가 물려받도록 fork 전에 생성)
+    if (admin_path[0] != '\0' && (admin_fd = open_admin_socket(admin_path)) < 0) {
+        log_write(LOG_WARNING, "관리용 소켓(%s) 생성 실패 - %s", admin_path, strerror(errno));
+    }
+
+    // 4단계 -> chat-dev8 : fork 모드의 SIGUSR1(자식 메시지), SIGCHLD(자식 종료) 는 시그널 핸들러 대신
+    // 부모 이벤트 루프에서 eventfd, signalfd 로 처리 (fork_setup_event_loop)
     // 6단계 : 부모 프로세스 Graceful shutdown 핸들러 추가
     // 고아 프로세스(부모 프로세스가 먼저 종료된 후 자식 프로세스가 여전히 "실행 중" 인 상태 - 실제 자원을 사용)
     register_sigaction(SIGINT, graceful_shutdown_handler);
     register_sigaction(SIGTERM, graceful_shutdown_handler);
 
-    struct sockaddr_in serv_addr;
-
-    // 1 단계 : TCP 소켓 생성(socket())
-    if ((listen_fd = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
-        // 7단계 : get_timestamp 에서 에러 발생 시간과 함께 로그 데이터를 출력하기 위해서 perror 대신에 문자열을 반환해주는
-        // strerror(errno) 를 사용한다.
-
-        // 7단계 : LOG Redirection
-        char logMsg[BUFSIZ * 2 + 32];
-        char errMsg[BUFSIZ * 2];
-        snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", strerror(errno)); // 로그 TYPE 문자열 결합
-        get_timestamp(logMsg, sizeof(logMsg), errMsg);
-        printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-        fflush(stdout);
+    // chat-dev10 : workers 모드는 각 worker 가 SO_REUSEPORT listen 소켓을 직접 생성 (최상위 프로세스는 listen 하지 않음)
+    if (server_mode == SERVER_MODE_WORKERS) {
+        if (run_worker_pool() < 0) {
+            log_write(LOG_ERROR, "worker 공유 자원 생성 실패 - %s", strerror(errno));
+        }
+        journal_close(&journal); // chat-dev15
+        log_shutdown(); // chat-dev12
+        close(file_fd); // 로그 파일 디스크립터 닫음
+        return 0;
+    }
 
+    // 1 단계 : TCP 소켓 생성(socket()), 서버 주소 바인딩(bind()), 클라이언트 연결 대기(listen())
+    // chat-dev10 : open_listen_socket 으로 분리 (workers 모드와 공용)
+    if ((listen_fd = open_listen_socket(0)) < 0) {
+        journal_close(&journal); // chat-dev15
+        log_shutdown(); // chat-dev12
         close(file_fd); // 로그 파일 디스크립터 닫음
         return -1;
     }
 
-    // 1 단계 : 서버 주소 구조체 설정(memset 후 server 주소 구조체 설정)
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    serv_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-    serv_addr.sin_port = htons(PORT);
-
-    // 1 단계 : 소켓에 서버 주소 바인딩(bind())
-    if (bind(listen_fd, (struct sockaddr*)&serv_addr, sizeof(serv_addr)) == -1) {
-        // 7단계 : LOG Redirection
-        char logMsg[BUFSIZ * 2 + 32];
-        char errMsg[BUFSIZ * 2];
-        snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", strerror(errno)); // 로그 TYPE 문자열 결합
-        get_timestamp(logMsg, sizeof(logMsg), errMsg);
-        printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-        fflush(stdout);
+    log_write(LOG_INFO, "서버가 %s:%d 에서 대기하고 있습니다...... (mode : %s)", listen_host, listen_port, server_mode == SERVER_MODE_EPOLL ? "epoll" : "fork");
 
-        close(listen_fd);
+    // chat-dev6 : epoll 모드는 단일 프로세스 이벤트 루프에서 모든 클라이언트를 처리
+    if (server_mode == SERVER_MODE_EPOLL) {
+        signal_fd = signalfd(-1, &hup_mask, SFD_NONBLOCK | SFD_CLOEXEC); // chat-dev26 : SIGHUP
+        run_epoll_server();
+        log_shutdown(); // chat-dev12
         close(file_fd); // 로그 파일 디스크립터 닫음
-        return -1;
+        close(listen_fd); // listening 파일 디스크립터를 닫음
+        return 0;
     }
 
-    // 1 단계 : 클라이언트 연결 대기(listen())
-    if (listen(listen_fd, PENDING_CONN) < 0) {
-        // 7단계 : LOG Redirection
-        char logMsg[BUFSIZ * 2 + 32];
-        char errMsg[BUFSIZ * 2];
-        snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", strerror(errno)); // 로그 TYPE 문자열 결합
-        get_timestamp(logMsg, sizeof(logMsg), errMsg);
-        printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-        fflush(stdout);
-        
+    // chat-dev8 : fork 모드 부모 이벤트 루프 준비
+    if (fork_setup_event_loop() < 0) {
+        log_write(LOG_ERROR, "이벤트 루프 생성 실패 - %s", strerror(errno));
+
         close(listen_fd);
+        log_shutdown(); // chat-dev12
         close(file_fd); // 로그 파일 디스크립터 닫음
         return -1;
     }
 
-    // 7단계 : LOG Redirection
-    char logMsg[BUFSIZ * 2 + 32];
-    char errMsg[BUFSIZ * 2];
-    snprintf(errMsg, sizeof(errMsg), "[INFO] : 서버가 %d 번 포트에서 대기하고 있습니다......\n", PORT); // 로그 TYPE 문자열 결합
-    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-    fflush(stdout);
-
+    // chat-dev25 : 이번에 깨어난 뒤 더 받아들일 수 있는 연결 수 (0 이 되면 다시 이벤트 루프로 돌아가 자식 메시지 처리)
+    int accept_budget = 0;
     while (1) {
+        // chat-dev8 : 새 연결이 들어올 때까지 자식 메시지, 자식 종료 처리
+        if (accept_budget == 0) {
+            fork_wait_for_accept();
+            accept_budget = accept_batch;
+        }
+        accept_budget--;
+
         struct sockaddr_in cli_addr;
         // 2 단계 : 클라이언트 연결 수락(accept())
+        // chat-dev25 : listen 소켓은 non-blocking 이므로 대기 중인 연결이 없으면 EAGAIN (자식이 쓰는 연결 소켓은 기존처럼 blocking)
         socklen_t cli_len = sizeof(cli_addr);
-        conn_fd = accept(listen_fd, (struct sockaddr*)&cli_addr, &cli_len);
+        conn_fd = accept4(listen_fd, (struct sockaddr*)&cli_addr, &cli_len, SOCK_CLOEXEC);
         if (conn_fd < 0) {
-            // 7단계 : LOG Redirection
-            char logMsg[BUFSIZ * 2 + 32];
-            char errMsg[BUFSIZ * 2];
-            snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", "accept() - 클라이언트 연결을 수락하지 못했습니다."); // 로그 TYPE 문자열 결합
-            get_timestamp(logMsg, sizeof(logMsg), errMsg);
-            printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 에러 로그 출력
-            fflush(stdout);
-            
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                accept_budget = 0; // 대기 중인 연결을 모두 받아들임
+                continue;
+            }
+            if (errno != EINTR) {
+                log_write(LOG_ERROR, "accept() - 클라이언트 연결을 수락하지 못했습니다.");
+            }
+            continue;
+        }
+
+        // chat-dev25 : 출발지 IP 별 연결 속도 제한 (슬롯, IPC 링, 자식 프로세스를 만들기 전에 판단)
+        if (!accept_admit(conn_fd, &cli_addr)) {
             continue;
         }
 
         // 6단계 : 새 클라이언트를 위한 빈 슬롯(인덱스) 찾기
         int new_client_idx = -1;
-        for (int i = 0; i < MAX_CLIENTS; i++) {
+        // chat-dev26 : 동시 접속 상한 (SIGHUP 으로 바뀜) 에 닿았으면 빈 슬롯이 남아 있어도 거절
+        for (int i = 0; server_limits->clients < server_limits->max_clients && i < client_reserve; i++) {
             if (clients[i].pid == 0) { // child_pid 가 0 이면 비어있는 슬롯
                 new_client_idx = i; // 비어있는 슬롯에 새 클라이언트 idx 할당하기 위함
                 break;
@@ -719,129 +4209,75 @@ int main(int argc, char** argv) {
 
         // 6 단계 : 빈 슬롯이 없을 때 (서버 꽉 찬 상태)
         if(new_client_idx == -1){
-            // 7단계 : LOG Redirection
-            char logMsg[BUFSIZ * 2 + 32];
-            char errMsg[BUFSIZ * 2];
-            snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", "서버 수용량 초과로 접속할 수 없습니다."); // 로그 TYPE 문자열 결합
-            get_timestamp(logMsg, sizeof(logMsg), errMsg);
-            printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 에러 로그 출력
-            fflush(stdout);
-
-            write(conn_fd, "서버가 꽉 찼습니다.\n", strlen("서버가 꽉 찼습니다.\n"));
+            log_write(LOG_ERROR, "서버 수용량 초과로 접속할 수 없습니다.");
+            stats_add(&server_stats->rejects, 1); // chat-dev13
+
+            frame_write(conn_fd, CMD_ERROR, "서버가 꽉 찼습니다.\n", strlen("서버가 꽉 찼습니다.\n"));
             close(conn_fd);
             continue; // 다음 accept() 대기로
         }
 
-        // 7 단계 : LOG Redirection
-        char logMsg[BUFSIZ * 2 + 32];
-        char errMsg[BUFSIZ * 2];
-        snprintf(errMsg, sizeof(errMsg), "[INFO] : 클라이언트 연결됨: %s", inet_ntoa(cli_addr.sin_addr)); // 로그 TYPE 문자열 결합
-        get_timestamp(logMsg, sizeof(logMsg), errMsg);
-        printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
+        log_write(LOG_INFO, "클라이언트 연결됨: %s", inet_ntoa(cli_addr.sin_addr));
+        stats_add(&server_stats->accepts, 1); // chat-dev13
 
         // 3 -> 4단계: pipe 생성 (자식마다)
         // 4 -> 6단계 : 찾은 인덱스(new_client_idx)를 사용하여 파이프 생성
-        if (pipe(pipe_child_to_parent[new_client_idx]) == -1 ||
-            pipe(pipe_parent_to_child[new_client_idx]) == -1) {
-            // 7단계 : LOG Redirection
-            char logMsg[BUFSIZ * 2 + 32];
-            char errMsg[BUFSIZ * 2];
-            snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", "pipe - 새 클라이언트와 연결하기 위한 파이프 생성에 실패하였습니다."); // 로그 TYPE 문자열 결합
-            get_timestamp(logMsg, sizeof(logMsg), errMsg);
-            printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 에러 로그 출력
-            fflush(stdout);
+        // chat-dev8 : 파이프 대신 공유 메모리 링 + eventfd 채널 생성 (fork 전에 만들어야 자식과 공유됨)
+        if (ipc_channel_open(&ipc_to_parent[new_client_idx], IPC_RING_SIZE) < 0 ||
+            ipc_channel_open(&ipc_to_child[new_client_idx], out_queue_ring) < 0) { // chat-dev17 : 송신 큐 상한을 담는 링
+            log_write(LOG_ERROR, "ipc - 새 클라이언트와 연결하기 위한 공유 메모리 링 생성에 실패하였습니다.");
 
+            ipc_channel_close(&ipc_to_parent[new_client_idx]);
+            ipc_channel_close(&ipc_to_child[new_client_idx]);
             close(conn_fd);
             continue;
         }
 
+        // chat-dev9 : 새 클라이언트는 로비(0) 의 현재 로그 위치부터 메시지를 받음
+        room_cursor_publish(new_client_idx, -1, 0);
+
         // 3 단계 : 자식 프로세스 생성(fork())
         pid_t pid = fork();
         if (pid < 0) {
-            // 7단계 : LOG Redirection
-            char logMsg[BUFSIZ * 2 + 32];
-            char errMsg[BUFSIZ * 2];
-            snprintf(errMsg, sizeof(errMsg), "[ERROR] : %s", "fork() - 새 클라이언트와 연결하기 위한 자식 프로세스 생성에 실패하였습니다."); // 로그 TYPE 문자열 결합
-            get_timestamp(logMsg, sizeof(logMsg), errMsg);
-            printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 에러 로그 출력
-            fflush(stdout);
+            log_write(LOG_ERROR, "fork() - 새 클라이언트와 연결하기 위한 자식 프로세스 생성에 실패하였습니다.");
 
+            ipc_channel_close(&ipc_to_parent[new_client_idx]);
+            ipc_channel_close(&ipc_to_child[new_client_idx]);
             close(conn_fd);
             continue;
         } else if (pid == 0) { // 자식 프로세스일 때의 처리
             child_index = new_client_idx;
             clients[child_index].client_sock_fd = conn_fd; // 자식만 자신의 fd를 구조체에 기록
             close(listen_fd); // 서버가 클라이언트 연결을 기다리기 위한 소켓(서버 대기용) 닫음
+            close(admin_fd);  // chat-dev13 : 관리용 소켓은 부모만 응답
 
             // 6 단계 : 자식이 sigterm 을 받을 때, 정리하기 위한 핸들러 추가
             register_sigaction(SIGTERM, child_sigterm_handler);
             register_sigaction(SIGINT, child_sigterm_handler);
-            // 4 단계: 자식에서 시그널 핸들러 SIGUSR2 등록
-            register_sigaction(SIGUSR2, child_sigusr2_handler);
 
             // 6 단계 : 새로 찾은 인덱스를 자신의 인덱스(자식)으로 사용
             child_index = new_client_idx; // 자식 전용 인덱스 설정
 
-            // 파이프 정리 (250630 주석 수정)
-            // 자식 프로세스는 pipe_child_to_parent(write 기준) 파이프에서 write 만 유지
-            close(pipe_child_to_parent[child_index][0]); 
-            // 자식 프로세스는 pipe_parent_to_child(write 기준) 파이프에서 read 만 유지
-            close(pipe_parent_to_child[child_index][1]); 
-            // 자식이 부모프로세스로부터 읽는 파이프를 non-blocking 으로 설정 (부모 write 가 막히지 않도록 하기 위함)
-            int flags = fcntl(pipe_parent_to_child[child_index][0], F_GETFL, 0);
-            fcntl(pipe_parent_to_child[child_index][0], F_SETFL, flags | O_NONBLOCK);
-            
-            // 자식은 클라이언트의 모든 메시지를 부모에게 전달만 함
-            char buf[BUFSIZ + 50 + 10];
-            int n;
-            while (1) {
-                memset(buf, 0, BUFSIZ); // 버퍼를 0 으로 초기화
-                // chat-dev2 : 클라이언트로부터 받은 문자열이 / 으로 들어오게 됨
-                n = read(conn_fd, buf, sizeof(buf)-1);
-
-                // 6 단계 : read() 가 <= 0 일 때 graceful 연결 종료 처리를 위한 부분 처리
-                if (n <= 0) {
-                    // 7단계 : LOG Redirection
-                    char logMsg[BUFSIZ * 2 + 32];
-                    char errMsg[BUFSIZ * 2];
-                    snprintf(errMsg, sizeof(errMsg), "[WARNING] : [자식 index %d, pid %d] 클라이언트 연결 종료가 감지되어 해당 클라이언트 연결을 종료합니다.", child_index, getpid()); // 로그 TYPE 문자열 결합
-                    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-                    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-                    fflush(stdout);
-
-                    close(clients[child_index].client_sock_fd);
-                    break;
-                }
+            // chat-dev8 : 부모 이벤트 루프 자원 정리 및 SIGCHLD 블록 해제
+            close(epoll_fd);
+            close(signal_fd);
+            if (timer_fd >= 0) {
+                close(timer_fd); // chat-dev27 : 응답 없는 연결 정리는 부모가 담당
+            }
+            sigset_t mask;
+            sigemptyset(&mask);
+            sigaddset(&mask, SIGCHLD);
+            sigprocmask(SIG_UNBLOCK, &mask, NULL);
 
-                // 종료 조건 : 'q' 로 메시지가 입력될 때 자식을 graceful 종료 처리
-                if (strcmp(buf, "q") == 0) {
-                    // 7단계 : LOG Redirection
-                    char logMsg[BUFSIZ * 2 + 32];
-                    char errMsg[BUFSIZ * 2];
-                    snprintf(errMsg, sizeof(errMsg), "[INFO] : [pid %d] 클라이언트로부터의 종료 요청 수신으로 해당 클라이언트 연결을 종료합니다.", getpid()); // 로그 TYPE 문자열 결합
-                    get_timestamp(logMsg, sizeof(logMsg), errMsg);
-                    printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-                    fflush(stdout);
-
-                    close(clients[child_index].client_sock_fd); // 자식에서 종료 시 자신의 conn_fd 를 닫아야 함
-                    break;
+            // 채널 정리 : 자식은 자신의 채널 두 개만 유지 (다른 자식들의 링 mapping, eventfd 는 닫음)
+            for (int i = 0; i < client_reserve; i++) {
+                if (i != child_index) {
+                    ipc_channel_close(&ipc_to_parent[i]);
+                    ipc_channel_close(&ipc_to_child[i]);
                 }
-
-                // 자식 → 부모 전송
-                buf[n] = '\0'; // 문자열 끝 처리
-
-                // 자식 프로세스에서 서버 부모 프로세스에 데이터를 파이프 작성으로 통해서 전달하도록 함
-                write(pipe_child_to_parent[child_index][1], buf, n); // 3->4단계: 자식 → 부모로 write 하기 위한 파이프 작성
-                // 7단계 : LOG Redirection
-                char logMsg[BUFSIZ * 2 + 32];
-                char errMsg[BUFSIZ * 2];
-                snprintf(errMsg, sizeof(errMsg), "[INFO] : [자식 index %d, pid : %d] 서버의 부모 프로세스에게 메시지(데이터) 작성 SIGNAL 알림: %s", child_index, getpid(), buf); // 로그 TYPE 문자열 결합
-                get_timestamp(logMsg, sizeof(logMsg), errMsg);
-                printf("\n%s", logMsg); // 로그에 현재 시간 + 관련 로그 출력
-                fflush(stdout);
-
-                kill(getppid(), SIGUSR1);
             }
+
+            run_fork_child();
             exit(0);  // 자식 프로세스 종료
         } else { // 부모 프로세스
             // 부모는 자식에게 conn_fd 를 넘기고 자신의 copy 된 conn_fd 는 닫고, 자식에서 종료 시 자신의 conn_fd 를 닫아야 함
@@ -849,18 +4285,17 @@ int main(int argc, char** argv) {
 
             // 부모가 클라이언트 정보 관리
             clients[new_client_idx].pid = pid;
+            server_limits->clients++; // chat-dev26
             clients[new_client_idx].client_sock_fd = conn_fd; // conn_fd를 저장하지만 부모가 직접 사용하진 않음
             strcpy(clients[new_client_idx].nickName, "GUEST"); // 임시 닉네임
             clients[new_client_idx].room_idx = 0; // 기본적으로 로비에 참가
+            room_member_add(0, new_client_idx); // chat-dev11
+            heartbeat_start(new_client_idx); // chat-dev27
 
-            // 파이프 정리 (250630 주석 수정)
-            // 부모는 child_to_parent(write 기준) 파이프에서 read 만 유지
-            close(pipe_child_to_parent[new_client_idx][1]); 
-            // 부모는 parent_to_child(write 기준) 파이프에서 write 만 유지
-            close(pipe_parent_to_child[new_client_idx][0]); 
-            // 부모가 자식프로세스로부터 읽는 파이프를 non-blocking 모드로 설정해 핸들러가 멈추지 않도록 함
-            int flags = fcntl(pipe_child_to_parent[new_client_idx][0], F_GETFL, 0);
-            fcntl(pipe_child_to_parent[new_client_idx][0], F_SETFL, flags | O_NONBLOCK);
+            // chat-dev8 : 자식 → 부모 채널 eventfd 감시 시작
+            // => fork 직후 자식이 이미 링에 쓴 메시지도 eventfd 카운터가 남아 있으므로 바로 처리됨
+            fork_watch_child(new_client_idx);
+            accept_record_latency(); // chat-dev25
 
             // 6단계 : client_index 를 루프의 최대 경계로 사용하기 위해 업데이트
             if (new_client_idx >= active_client_count) {
@@ -869,6 +4304,7 @@ int main(int argc, char** argv) {
         }
     }
 
+    log_shutdown(); // chat-dev12
     close(file_fd); // 로그 파일 디스크립터 닫음
     close(listen_fd); // listening 파일 디스크립터를 닫음
     return 0;
@@ -0,0 +1,376 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <arpa/inet.h>
+
+#include "protocol.h"
+#include "session.h"
+
+#define SESSION_EVENT_HEADER 9 // 시각 8바이트 + 방향 1바이트
+#define SESSION_MATCH_SCAN   256 // 응답 짝을 찾을 때 살펴볼 대기 중인 요청 수
+#define SESSION_PRINT_MAX    120 // 비교 결과에 출력할 payload 최대 바이트 (UTF-8 문자 경계에서 자름)
+
+uint64_t session_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void put_be64(char* p, uint64_t v) {
+    uint32_t hi = htonl((uint32_t)(v >> 32));
+    uint32_t lo = htonl((uint32_t)v);
+    memcpy(p, &hi, 4);
+    memcpy(p + 4, &lo, 4);
+}
+
+static uint64_t get_be64(const char* p) {
+    uint32_t hi, lo;
+    memcpy(&hi, p, 4);
+    memcpy(&lo, p + 4, 4);
+    return ((uint64_t)ntohl(hi) << 32) | ntohl(lo);
+}
+
+// 기록 파일 생성 (세션 시작 시각 = 지금)
+int session_record_open(SessionRecorder* r, const char* path) {
+    r->fp = fopen(path, "wb");
+    if (r->fp == NULL) {
+        return -1;
+    }
+    setvbuf(r->fp, NULL, _IOFBF, 1 << 16);
+    fwrite(SESSION_MAGIC, 1, 8, r->fp);
+    r->start = session_now_ns();
+    return 0;
+}
+
+// 프레임 원본 한 개 기록 (버퍼에만 쓰고 파일 쓰기는 session_record_flush 에서 모아서)
+void session_record(SessionRecorder* r, int dir, const char* raw, size_t len) {
+    if (r->fp == NULL) {
+        return;
+    }
+    char header[SESSION_EVENT_HEADER];
+    put_be64(header, session_now_ns() - r->start);
+    header[8] = (char)dir;
+    fwrite(header, 1, sizeof(header), r->fp);
+    fwrite(raw, 1, len, r->fp);
+}
+
+// 이벤트 루프 한 바퀴마다 호출 - 클라이언트가 강제 종료되어도 직전 바퀴까지의 기록은 남음
+void session_record_flush(SessionRecorder* r) {
+    if (r->fp != NULL) {
+        fflush(r->fp);
+    }
+}
+
+void session_record_close(SessionRecorder* r) {
+    if (r->fp != NULL) {
+        fclose(r->fp);
+        r->fp = NULL;
+    }
+}
+
+// 이벤트 한 개 추가 (프레임 원본 복사)
+int session_log_append(SessionLog* log, uint64_t ts, int dir, const char* raw, size_t len) {
+    if (log->size + len > log->cap) {
+        size_t cap = log->cap ? log->cap : (1 << 16);
+        while (cap < log->size + len) {
+            cap *= 2;
+        }
+        char* data = realloc(log->data, cap);
+        if (data == NULL) {
+            return -1;
+        }
+        log->data = data;
+        log->cap = cap;
+    }
+    if (log->count == log->events_cap) {
+        size_t cap = log->events_cap ? log->events_cap * 2 : 1024;
+        SessionEvent* events = realloc(log->events, cap * sizeof(SessionEvent));
+        if (events == NULL) {
+            return -1;
+        }
+        log->events = events;
+        log->events_cap = cap;
+    }
+    SessionEvent* e = &log->events[log->count++];
+    e->ts = ts;
+    e->dir = dir;
+    e->cmd = (unsigned char)raw[4];
+    e->off = log->size;
+    e->len = len;
+    memcpy(log->data + log->size, raw, len);
+    log->size += len;
+    return 0;
+}
+
+// 기록 파일 읽기 - 끝까지 쓰이지 않은 마지막 이벤트(기록 중 강제 종료) 는 무시
+// 반환 : 0 성공, -1 파일을 읽을 수 없거나 기록 파일이 아님
+int session_load(SessionLog* log, const char* path) {
+    memset(log, 0, sizeof(*log));
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return -1;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char* buf = malloc(size > 0 ? size : 1);
+    if (buf == NULL || size < 8 || fread(buf, 1, size, fp) != (size_t)size || memcmp(buf, SESSION_MAGIC, 8) != 0) {
+        free(buf);
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+
+    size_t pos = 8;
+    while (pos + SESSION_EVENT_HEADER + FRAME_HEADER_SIZE <= (size_t)size) {
+        const char* raw = buf + pos + SESSION_EVENT_HEADER;
+        uint32_t be_len;
+        memcpy(&be_len, raw, 4);
+        size_t len = FRAME_HEADER_SIZE + ntohl(be_len);
+        int dir = buf[pos + 8];
+        if ((dir != SESSION_SENT && dir != SESSION_RECV) || len > FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD ||
+            pos + SESSION_EVENT_HEADER + len > (size_t)size) {
+            break;
+        }
+        if (session_log_append(log, get_be64(buf + pos), dir, raw, len) < 0) {
+            free(buf);
+            session_free(log);
+            return -1;
+        }
+        pos += SESSION_EVENT_HEADER + len;
+    }
+    free(buf);
+    return 0;
+}
+
+void session_free(SessionLog* log) {
+    free(log->data);
+    free(log->events);
+    memset(log, 0, sizeof(*log));
+}
+
+const char* session_payload(const SessionLog* log, const SessionEvent* e) {
+    return log->data + e->off + FRAME_HEADER_SIZE;
+}
+
+static int ends_with(const char* s, size_t len, const char* suffix, size_t suffix_len) {
+    return suffix_len <= len && memcmp(s + len - suffix_len, suffix, suffix_len) == 0;
+}
+
+static int starts_with(const char* s, size_t len, const char* prefix) {
+    size_t n = strlen(prefix);
+    return n <= len && memcmp(s, prefix, n) == 0;
+}
+
+// 받은 프레임 recv 가 보낸 프레임 sent 의 응답인지
+// MSG : 받은 채널 메시지가 보낸 "닉네임:메시지" 로 끝남 (서버가 앞에 채널 정보를 붙임)
+// WHISPER : 받은 귓속말이 "보낸닉네임:메시지" 로 끝나거나 보낸 클라이언트에게만 오는 오류 안내 (To_ / From_)
+// 그 밖의 명령어 : 같은 명령어의 응답이면 순서대로 짝지음
+static int session_answers(const SessionLog* log, const SessionEvent* sent, const SessionEvent* recv) {
+    const char* req = session_payload(log, sent);
+    size_t req_len = sent->len - FRAME_HEADER_SIZE;
+    const char* res = session_payload(log, recv);
+    size_t res_len = recv->len - FRAME_HEADER_SIZE;
+    if (sent->cmd == CMD_MSG) {
+        return ends_with(res, res_len, req, req_len);
+    }
+    if (sent->cmd == CMD_WHISPER) {
+        if (starts_with(res, res_len, "To_") || starts_with(res, res_len, "From_")) {
+            return 1;
+        }
+        const char* colon = memchr(req, ':', req_len);
+        const char* space = colon ? memchr(colon, ' ', req + req_len - colon) : NULL;
+        if (space == NULL) {
+            return 0;
+        }
+        size_t nick_len = colon + 1 - req; // "보낸닉네임:"
+        size_t msg_len = req + req_len - (space + 1);
+        return res_len >= nick_len + msg_len && ends_with(res, res_len, space + 1, msg_len) &&
+               memcmp(res + res_len - msg_len - nick_len, req, nick_len) == 0;
+    }
+    return 1;
+}
+
+// 명령어별 응답 지연 (ns) 목록과 응답을 받지 못한 요청 수
+typedef struct {
+    uint64_t* v;
+    size_t n;
+    size_t cap;
+    size_t unanswered;
+} SessionLatency;
+
+static void latency_add(SessionLatency* l, uint64_t ns) {
+    if (l->n == l->cap) {
+        size_t cap = l->cap ? l->cap * 2 : 256;
+        uint64_t* v = realloc(l->v, cap * sizeof(uint64_t));
+        if (v == NULL) {
+            return;
+        }
+        l->v = v;
+        l->cap = cap;
+    }
+    l->v[l->n++] = ns;
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// 보낸 요청과 받은 응답을 짝지어 명령어별 응답 지연 계산 (QUIT 처럼 응답이 없는 명령어는 제외)
+static void session_latency(const SessionLog* log, SessionLatency* lat) {
+    size_t* pending[CMD_MAX] = { 0 };
+    size_t head[CMD_MAX] = { 0 };
+    size_t tail[CMD_MAX] = { 0 };
+    for (int c = 0; c < CMD_MAX; c++) {
+        pending[c] = malloc((log->count + 1) * sizeof(size_t));
+    }
+    for (size_t i = 0; i < log->count; i++) {
+        const SessionEvent* e = &log->events[i];
+        int c = e->cmd;
+        if (c <= CMD_NONE || c >= CMD_MAX || c == CMD_QUIT || c == CMD_ERROR || pending[c] == NULL) {
+            continue;
+        }
+        if (e->dir == SESSION_SENT) {
+            pending[c][tail[c]++] = i;
+            continue;
+        }
+        for (size_t k = head[c]; k < tail[c] && k < head[c] + SESSION_MATCH_SCAN; k++) {
+            if (pending[c][k] != SIZE_MAX && session_answers(log, &log->events[pending[c][k]], e)) {
+                latency_add(&lat[c], e->ts - log->events[pending[c][k]].ts);
+                pending[c][k] = SIZE_MAX;
+                break;
+            }
+        }
+        while (head[c] < tail[c] && pending[c][head[c]] == SIZE_MAX) {
+            head[c]++;
+        }
+    }
+    for (int c = 0; c < CMD_MAX; c++) {
+        for (size_t k = head[c]; k < tail[c]; k++) {
+            lat[c].unanswered += pending[c][k] != SIZE_MAX;
+        }
+        free(pending[c]);
+        qsort(lat[c].v, lat[c].n, sizeof(uint64_t), cmp_u64);
+    }
+}
+
+static double latency_pct(const SessionLatency* l, double p) {
+    if (l->n == 0) {
+        return 0;
+    }
+    size_t i = (size_t)(p * (l->n - 1) + 0.5);
+    return l->v[i] / 1e6;
+}
+
+// 앞 max 바이트 이내에서 UTF-8 문자 경계로 자른 길이 (한글처럼 여러 바이트인 문자의 중간에서 자르지 않음)
+static size_t utf8_prefix_len(const char* s, size_t len, size_t max) {
+    if (len <= max) {
+        return len;
+    }
+    size_t n = max;
+    while (n > 0 && ((unsigned char)s[n] & 0xC0) == 0x80) {
+        n--; // 자를 위치가 이어지는 바이트(10xxxxxx) 이면 문자 시작 바이트까지 당김
+    }
+    return n;
+}
+
+static void print_frame(FILE* out, const char* label, const SessionLog* log, const SessionEvent* e) {
+    if (e == NULL) {
+        fprintf(out, "    %s : (없음)\n", label);
+        return;
+    }
+    const char* payload = session_payload(log, e);
+    size_t len = e->len - FRAME_HEADER_SIZE;
+    size_t shown = utf8_prefix_len(payload, len, SESSION_PRINT_MAX);
+    fprintf(out, "    %s : [%s] %.*s%s\n", label, frame_cmd_name(e->cmd), (int)shown, payload, shown < len ? "..." : "");
+}
+
+// 기록한 세션과 재생한 세션 비교 결과 출력
+// => 프레임 수, 받은 프레임 내용(같은 순서 위치끼리 비교, 첫 차이), 명령어별 받은 프레임 수, 명령어별 응답 지연 p50/p99/max
+void session_report(FILE* out, const SessionLog* recorded, const SessionLog* observed) {
+    const SessionLog* logs[2] = { recorded, observed };
+    size_t sent[2] = { 0 }, recv[2] = { 0 };
+    size_t recv_by_cmd[2][CMD_MAX] = { { 0 } };
+    SessionLatency lat[2][CMD_MAX];
+    memset(lat, 0, sizeof(lat));
+    for (int s = 0; s < 2; s++) {
+        for (size_t i = 0; i < logs[s]->count; i++) {
+            const SessionEvent* e = &logs[s]->events[i];
+            if (e->dir == SESSION_SENT) {
+                sent[s]++;
+            } else {
+                recv[s]++;
+                recv_by_cmd[s][e->cmd < CMD_MAX ? e->cmd : CMD_NONE]++;
+            }
+        }
+        session_latency(logs[s], lat[s]);
+    }
+    uint64_t duration[2];
+    for (int s = 0; s < 2; s++) {
+        duration[s] = logs[s]->count ? logs[s]->events[logs[s]->count - 1].ts - logs[s]->events[0].ts : 0;
+    }
+
+    // 받은 프레임을 순서대로 짝지어 명령어와 payload 가 같은지 비교
+    size_t same = 0, ri = 0, oi = 0;
+    const SessionEvent* first_rec = NULL;
+    const SessionEvent* first_obs = NULL;
+    size_t first_at = 0;
+    int diverged = 0;
+    for (size_t n = 0; ; n++) {
+        while (ri < recorded->count && recorded->events[ri].dir != SESSION_RECV) {
+            ri++;
+        }
+        while (oi < observed->count && observed->events[oi].dir != SESSION_RECV) {
+            oi++;
+        }
+        if (ri >= recorded->count && oi >= observed->count) {
+            break;
+        }
+        const SessionEvent* r = ri < recorded->count ? &recorded->events[ri++] : NULL;
+        const SessionEvent* o = oi < observed->count ? &observed->events[oi++] : NULL;
+        if (r != NULL && o != NULL && r->len == o->len &&
+            memcmp(recorded->data + r->off, observed->data + o->off, r->len) == 0) {
+            same++;
+        } else if (!diverged) {
+            diverged = 1;
+            first_at = n;
+            first_rec = r;
+            first_obs = o;
+        }
+    }
+
+    fprintf(out, "세션 재생 결과\n");
+    fprintf(out, "  보낸 프레임 : 기록 %zu, 재생 %zu\n", sent[0], sent[1]);
+    fprintf(out, "  받은 프레임 : 기록 %zu, 재생 %zu (같은 순서 위치에서 내용이 같은 프레임 %zu)\n", recv[0], recv[1], same);
+    fprintf(out, "  세션 길이 : 기록 %.1f ms, 재생 %.1f ms\n", duration[0] / 1e6, duration[1] / 1e6);
+    if (diverged) {
+        fprintf(out, "  첫 차이 : 받은 프레임 #%zu\n", first_at);
+        print_frame(out, "기록", recorded, first_rec);
+        print_frame(out, "재생", observed, first_obs);
+    } else {
+        fprintf(out, "  받은 프레임이 기록과 모두 같습니다.\n");
+    }
+
+    fprintf(out, "  명령어별 받은 프레임 (기록 / 재생)\n");
+    for (int c = 0; c < CMD_MAX; c++) {
+        if (recv_by_cmd[0][c] || recv_by_cmd[1][c]) {
+            fprintf(out, "    %-8s %8zu / %-8zu%s\n", frame_cmd_name(c), recv_by_cmd[0][c], recv_by_cmd[1][c],
+                    recv_by_cmd[0][c] != recv_by_cmd[1][c] ? " *" : "");
+        }
+    }
+
+    fprintf(out, "  명령어별 응답 지연 ms (기록 p50 / p99 / max  ->  재생 p50 / p99 / max, 응답 없음 기록 / 재생)\n");
+    for (int c = 0; c < CMD_MAX; c++) {
+        if (lat[0][c].n || lat[1][c].n || lat[0][c].unanswered || lat[1][c].unanswered) {
+            fprintf(out, "    %-8s %7zu건 %8.3f / %8.3f / %8.3f  ->  %8.3f / %8.3f / %8.3f, %zu / %zu\n",
+                    frame_cmd_name(c), lat[1][c].n,
+                    latency_pct(&lat[0][c], 0.50), latency_pct(&lat[0][c], 0.99), latency_pct(&lat[0][c], 1.0),
+                    latency_pct(&lat[1][c], 0.50), latency_pct(&lat[1][c], 0.99), latency_pct(&lat[1][c], 1.0),
+                    lat[0][c].unanswered, lat[1][c].unanswered);
+        }
+        free(lat[0][c].v);
+        free(lat[1][c].v);
+    }
+}
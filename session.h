@@ -0,0 +1,55 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// chat-dev21 : 클라이언트 세션 기록 / 재생
+// => 클라이언트가 보내고 받은 프레임을 원본 그대로 세션 시작 기준 단조 시각(CLOCK_MONOTONIC) 과 함께 파일에 기록하고,
+//    기록한 세션의 보낸 프레임을 같은 간격(또는 N 배 빠르게, 최대 속도로) 서버에 다시 보내 받은 응답과 응답 지연을 기록과 비교
+// 파일 구조 : [SESSION_MAGIC 8바이트] 뒤에 이벤트 [시각 ns 8바이트 (network byte order)][방향 1바이트 'S'/'R'][프레임 원본 (헤더 포함)] 반복
+#define SESSION_MAGIC   "CHATREC1"
+#define SESSION_SENT    'S' // 클라이언트 → 서버
+#define SESSION_RECV    'R' // 서버 → 클라이언트
+
+// 기록 파일 쓰기
+typedef struct {
+    FILE* fp;
+    uint64_t start; // 세션 시작 시각 (ns)
+} SessionRecorder;
+
+// 세션 이벤트 한 개 (payload 는 SessionLog.data 의 off 위치, NUL 종료 아님)
+typedef struct {
+    uint64_t ts;  // 세션 시작부터 ns
+    int dir;
+    int cmd;
+    size_t off;   // 프레임 원본 시작 위치
+    size_t len;   // 프레임 원본 길이 (FRAME_HEADER_SIZE + payload 길이)
+} SessionEvent;
+
+// 읽은 기록 파일 또는 재생 중 관찰한 이벤트 목록
+typedef struct {
+    char* data;
+    size_t size;
+    size_t cap;
+    SessionEvent* events;
+    size_t count;
+    size_t events_cap;
+} SessionLog;
+
+uint64_t session_now_ns();
+
+int session_record_open(SessionRecorder* r, const char* path);
+void session_record(SessionRecorder* r, int dir, const char* raw, size_t len);
+void session_record_flush(SessionRecorder* r);
+void session_record_close(SessionRecorder* r);
+
+int session_log_append(SessionLog* log, uint64_t ts, int dir, const char* raw, size_t len);
+int session_load(SessionLog* log, const char* path);
+void session_free(SessionLog* log);
+const char* session_payload(const SessionLog* log, const SessionEvent* e);
+
+void session_report(FILE* out, const SessionLog* recorded, const SessionLog* observed);
+
+#endif
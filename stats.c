@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#include "stats.h"
+
+ServerStats* server_stats;
+
+// chat-dev14 : 채팅 채널별 지표 조회 정보 (fork 전에 stats_set_rooms 로 설정하여 모든 서버 프로세스가 물려받음)
+static int stats_rooms;
+static uint64_t stats_history_reserved; // 채널 하나의 최근 메시지 기록에 예약된 바이트
+static StatsRoomInfoFn stats_room_info;
+
+// Prometheus text 를 만들 때 사용하는 크기 제한 없는 문자열 버퍼
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+} StatsBuf;
+
+static void stats_printf(StatsBuf* b, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+static void stats_printf(StatsBuf* b, const char* fmt, ...) {
+    while (b->data != NULL) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(b->data + b->len, b->cap - b->len, fmt, ap);
+        va_end(ap);
+        if (n < 0) {
+            return;
+        }
+        if (b->len + n < b->cap) {
+            b->len += n;
+            return;
+        }
+        char* grown = realloc(b->data, b->cap * 2 + n);
+        if (grown == NULL) {
+            free(b->data);
+            b->data = NULL; // 메모리 부족 - 조회 실패로 처리
+            return;
+        }
+        b->data = grown;
+        b->cap = b->cap * 2 + n;
+    }
+}
+
+// 지표 공유 메모리 생성 (fork 전에 호출하여 모든 서버 프로세스가 같은 지표를 갱신하도록 함)
+int stats_init(int max_clients) {
+    size_t size = sizeof(ServerStats) + sizeof(StatsClient) * max_clients;
+    ServerStats* s = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (s == MAP_FAILED) {
+        return -1;
+    }
+    s->start_time = time(NULL);
+    s->max_clients = max_clients;
+    server_stats = s;
+    return 0;
+}
+
+uint64_t stats_now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void stats_add(uint64_t* counter, uint64_t n) {
+    __atomic_add_fetch(counter, n, __ATOMIC_RELAXED);
+}
+
+// value 가 들어갈 칸 : value 이상인 가장 작은 2 의 거듭제곱의 지수
+static int stats_bucket_of(uint64_t value) {
+    if (value <= 1) {
+        return 0;
+    }
+    int k = 64 - __builtin_clzll(value - 1);
+    return k < STATS_HIST_BUCKETS ? k : STATS_HIST_BUCKETS - 1;
+}
+
+void stats_hist_add(StatsHistogram* h, uint64_t value) {
+    __atomic_add_fetch(&h->buckets[stats_bucket_of(value)], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&h->sum, value, __ATOMIC_RELAXED);
+}
+
+// q 분위수가 들어 있는 칸의 상한 (값이 없으면 0)
+uint64_t stats_hist_percentile(const StatsHistogram* h, double q) {
+    uint64_t count = __atomic_load_n(&h->count, __ATOMIC_RELAXED);
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(q * count);
+    if (rank < 1) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int k = 0; k < STATS_HIST_BUCKETS; k++) {
+        seen += __atomic_load_n(&h->buckets[k], __ATOMIC_RELAXED);
+        if (seen >= rank) {
+            return 1ull << k;
+        }
+    }
+    return 1ull << (STATS_HIST_BUCKETS - 1);
+}
+
+void stats_client_reset(int idx) {
+    memset(&server_stats->clients[idx], 0, sizeof(StatsClient));
+}
+
+void stats_set_rooms(int rooms, uint64_t history_reserved, StatsRoomInfoFn info) {
+    stats_rooms = rooms;
+    stats_history_reserved = history_reserved;
+    stats_room_info = info;
+}
+
+static uint64_t stats_load(const uint64_t* counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+// 접속 중인 클라이언트 수, 전달 대기 바이트 합계 / 최대값과 그 슬롯
+static int stats_scan_clients(StatsClientInfoFn info, uint64_t* queued_total, uint64_t* queued_max, int* queued_max_idx) {
+    int active = 0;
+    *queued_total = 0;
+    *queued_max = 0;
+    *queued_max_idx = -1;
+    for (int i = 0; i < server_stats->max_clients; i++) {
+        const char* nick;
+        uint64_t queued;
+        if (!info(i, &nick, &queued)) {
+            continue;
+        }
+        active++;
+        *queued_total += queued;
+        if (*queued_max_idx < 0 || queued > *queued_max) {
+            *queued_max = queued;
+            *queued_max_idx = i;
+        }
+    }
+    return active;
+}
+
+// 활성 채널 수, 최근 메시지 기록에 쌓인 메시지 수 / 바이트 합계
+static int stats_scan_rooms(uint64_t* msgs_total, uint64_t* bytes_total) {
+    int active = 0;
+    *msgs_total = 0;
+    *bytes_total = 0;
+    for (int r = 0; stats_room_info != NULL && r < stats_rooms; r++) {
+        const char* name;
+        uint32_t msgs;
+        uint64_t bytes;
+        if (!stats_room_info(r, &name, &msgs, &bytes)) {
+            continue;
+        }
+        active++;
+        *msgs_total += msgs;
+        *bytes_total += bytes;
+    }
+    return active;
+}
+
+// dst(cap 바이트, used 바이트 사용 중) 뒤에 이어 쓰기 - 넘치는 부분은 잘림
+static void stats_appendf(char* dst, size_t cap, size_t* used, const char* fmt, ...) __attribute__((format(printf, 4, 5)));
+static void stats_appendf(char* dst, size_t cap, size_t* used, const char* fmt, ...) {
+    if (*used + 1 >= cap) {
+        return;
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(dst + *used, cap - *used, fmt, ap);
+    va_end(ap);
+    if (n > 0) {
+        *used += ((size_t)n < cap - *used) ? (size_t)n : cap - *used - 1;
+    }
+}
+
+// /STATS 응답 : 사람이 읽는 요약 (반환 : 작성한 바이트 수)
+size_t stats_render_summary(char* dst, size_t cap, const char* mode, StatsClientInfoFn info) {
+    ServerStats* s = server_stats;
+    uint64_t queued_total, queued_max;
+    int queued_max_idx;
+    int active = stats_scan_clients(info, &queued_total, &queued_max, &queued_max_idx);
+    size_t used = 0;
+    dst[0] = '\0';
+
+    stats_appendf(dst, cap, &used, "***** 서버 지표 (mode : %s, 실행 %llu 초) *****\n", mode, (unsigned long long)(time(NULL) - s->start_time));
+    stats_appendf(dst, cap, &used, "연결 : 수락 %llu, 거절 %llu (수용량 초과 %llu, 속도 제한 %llu), 종료 %llu, 현재 접속 %d\n",
+                  (unsigned long long)stats_load(&s->accepts),
+                  (unsigned long long)(stats_load(&s->rejects) + stats_load(&s->rate_limited)), (unsigned long long)stats_load(&s->rejects),
+                  (unsigned long long)stats_load(&s->rate_limited), (unsigned long long)stats_load(&s->disconnects), active);
+    stats_appendf(dst, cap, &used, "용량 제한 : 동시 접속 %d, 채팅 채널 %d (설정 다시 읽기 %llu 회)\n",
+                  __atomic_load_n(&s->client_limit, __ATOMIC_RELAXED), __atomic_load_n(&s->room_limit, __ATOMIC_RELAXED),
+                  (unsigned long long)stats_load(&s->config_reloads));
+    stats_appendf(dst, cap, &used, "heartbeat : PING %llu 회, 응답 없어 종료 %llu 회\n",
+                  (unsigned long long)stats_load(&s->heartbeat_pings), (unsigned long long)stats_load(&s->idle_disconnects));
+    uint64_t accept_count = stats_load(&s->accept_ns.count);
+    stats_appendf(dst, cap, &used, "연결 수락 시간 : %llu 건, 평균 %.1f us, p50 <= %.1f us, p99 <= %.1f us\n",
+                  (unsigned long long)accept_count, accept_count ? stats_load(&s->accept_ns.sum) / 1e3 / accept_count : 0.0,
+                  stats_hist_percentile(&s->accept_ns, 0.5) / 1e3, stats_hist_percentile(&s->accept_ns, 0.99) / 1e3);
+
+    const char* titles[2] = { "받은 명령어", "보낸 프레임" };
+    const uint64_t* counters[2] = { s->frames_in, s->frames_out };
+    for (int t = 0; t < 2; t++) {
+        stats_appendf(dst, cap, &used, "%s :", titles[t]);
+        for (int cmd = CMD_NONE + 1; cmd < CMD_MAX; cmd++) {
+            uint64_t v = stats_load(&counters[t][cmd]);
+            if (v > 0) {
+                stats_appendf(dst, cap, &used, " %s %llu", frame_cmd_name(cmd), (unsigned long long)v);
+            }
+        }
+        stats_appendf(dst, cap, &used, "\n");
+    }
+
+    uint64_t fan_count = stats_load(&s->fanout.count);
+    stats_appendf(dst, cap, &used, "브로드캐스트 fan-out : %llu 건, 평균 %.1f 명, p50 <= %llu, p99 <= %llu (방 로그 %llu 바이트)\n",
+                  (unsigned long long)fan_count, fan_count ? (double)stats_load(&s->fanout.sum) / fan_count : 0.0,
+                  (unsigned long long)stats_hist_percentile(&s->fanout, 0.5), (unsigned long long)stats_hist_percentile(&s->fanout, 0.99),
+                  (unsigned long long)stats_load(&s->room_log_bytes));
+    uint64_t handler_count = stats_load(&s->handler_ns.count);
+    stats_appendf(dst, cap, &used, "명령어 처리 시간 : %llu 건, 평균 %.1f us, p50 <= %.1f us, p99 <= %.1f us, p999 <= %.1f us\n",
+                  (unsigned long long)handler_count, handler_count ? stats_load(&s->handler_ns.sum) / 1e3 / handler_count : 0.0,
+                  stats_hist_percentile(&s->handler_ns, 0.5) / 1e3, stats_hist_percentile(&s->handler_ns, 0.99) / 1e3,
+                  stats_hist_percentile(&s->handler_ns, 0.999) / 1e3);
+    uint64_t send_count = stats_load(&s->send_bytes.count);
+    stats_appendf(dst, cap, &used, "소켓 전송 : %llu 회, 1회당 평균 %.1f 바이트, p50 <= %llu, p99 <= %llu\n",
+                  (unsigned long long)send_count, send_count ? (double)stats_load(&s->send_bytes.sum) / send_count : 0.0,
+                  (unsigned long long)stats_hist_percentile(&s->send_bytes, 0.5), (unsigned long long)stats_hist_percentile(&s->send_bytes, 0.99));
+    stats_appendf(dst, cap, &used, "느린 클라이언트 : 송신 큐 상한 초과 %llu 회, 새 프레임 버림 %llu 건, 오래된 프레임 버림 %llu 건 (%llu 바이트), 연결 종료 %llu 회, 방 로그 밀림 %llu 회\n",
+                  (unsigned long long)stats_load(&s->slow_events), (unsigned long long)stats_load(&s->dropped_newest),
+                  (unsigned long long)stats_load(&s->dropped_oldest), (unsigned long long)stats_load(&s->dropped_bytes),
+                  (unsigned long long)stats_load(&s->slow_disconnects), (unsigned long long)stats_load(&s->room_log_overruns));
+    stats_appendf(dst, cap, &used, "방 로그 전달 : 복사 없이 %llu 바이트, 복사 후 %llu 바이트\n",
+                  (unsigned long long)stats_load(&s->room_log_zero_copy_bytes), (unsigned long long)stats_load(&s->room_log_copy_bytes));
+    uint64_t lz_in = stats_load(&s->compress_in_bytes);
+    uint64_t lz_frames = stats_load(&s->compress_frames) + stats_load(&s->compress_skipped);
+    uint64_t unlz_frames = stats_load(&s->decompress_frames);
+    stats_appendf(dst, cap, &used, "압축 : %llu 건, %llu -> %llu 바이트 (비율 %.3f), 줄지 않아 원본 전송 %llu 건, 1건당 평균 %.1f us / 해제 : %llu 건, %llu -> %llu 바이트, 1건당 평균 %.1f us\n",
+                  (unsigned long long)stats_load(&s->compress_frames), (unsigned long long)lz_in,
+                  (unsigned long long)stats_load(&s->compress_out_bytes), lz_in ? (double)stats_load(&s->compress_out_bytes) / lz_in : 0.0,
+                  (unsigned long long)stats_load(&s->compress_skipped), lz_frames ? stats_load(&s->compress_ns) / 1e3 / lz_frames : 0.0,
+                  (unsigned long long)unlz_frames, (unsigned long long)stats_load(&s->decompress_in_bytes),
+                  (unsigned long long)stats_load(&s->decompress_out_bytes), unlz_frames ? stats_load(&s->decompress_ns) / 1e3 / unlz_frames : 0.0);
+    uint64_t buf_allocs = stats_load(&s->msgbuf.allocs);
+    stats_appendf(dst, cap, &used, "메시지 버퍼 풀 : 할당 %llu 건 (재사용 %.1f%%, 풀 밖 %llu 건), 공유 참조 %llu 건, 전달 중 %llu 바이트, slab %llu 바이트\n",
+                  (unsigned long long)buf_allocs, buf_allocs ? 100.0 * stats_load(&s->msgbuf.hits) / buf_allocs : 0.0,
+                  (unsigned long long)stats_load(&s->msgbuf.oversize), (unsigned long long)stats_load(&s->msgbuf.refs),
+                  (unsigned long long)stats_load(&s->msgbuf.inflight_bytes), (unsigned long long)stats_load(&s->msgbuf.slab_bytes));
+    uint64_t history_msgs, history_bytes;
+    int active_rooms = stats_scan_rooms(&history_msgs, &history_bytes);
+    stats_appendf(dst, cap, &used, "최근 메시지 기록 : 활성 채널 %d 개, 메시지 %llu 건, %llu 바이트 사용 (채널당 예약 %llu 바이트, 전체 %llu 바이트)\n",
+                  active_rooms, (unsigned long long)history_msgs, (unsigned long long)history_bytes,
+                  (unsigned long long)stats_history_reserved, (unsigned long long)(stats_history_reserved * stats_rooms));
+    stats_appendf(dst, cap, &used, "전달 대기 : 합계 %llu 바이트, 최대 %llu 바이트 (index %d)",
+                  (unsigned long long)queued_total, (unsigned long long)queued_max, queued_max_idx);
+    return used;
+}
+
+// 히스토그램을 Prometheus histogram 형식(누적 _bucket, _sum, _count) 으로 출력
+static void stats_render_hist(StatsBuf* b, const char* name, const char* help, const StatsHistogram* h) {
+    stats_printf(b, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+    uint64_t seen = 0;
+    for (int k = 0; k < STATS_HIST_BUCKETS - 1; k++) {
+        seen += stats_load(&h->buckets[k]);
+        stats_printf(b, "%s_bucket{le=\"%llu\"} %llu\n", name, 1ull << k, (unsigned long long)seen);
+    }
+    seen += stats_load(&h->buckets[STATS_HIST_BUCKETS - 1]);
+    stats_printf(b, "%s_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long)seen);
+    stats_printf(b, "%s_sum %llu\n%s_count %llu\n", name, (unsigned long long)stats_load(&h->sum), name, (unsigned long long)seen);
+}
+
+// label 값 escape (\, ", 줄바꿈)
+static void stats_label_escape(char* dst, size_t cap, const char* src) {
+    size_t n = 0;
+    for (; *src && n + 2 < cap; src++) {
+        if (*src == '\\' || *src == '"') {
+            dst[n++] = '\\';
+            dst[n++] = *src;
+        } else if (*src == '\n') {
+            dst[n++] = '\\';
+            dst[n++] = 'n';
+        } else {
+            dst[n++] = *src;
+        }
+    }
+    dst[n] = '\0';
+}
+
+// 관리용 소켓 응답 : Prometheus text 형식 전체 지표 (반환 : malloc 한 문자열, 실패 시 NULL)
+char* stats_render_prometheus(const char* mode, StatsClientInfoFn info, size_t* len) {
+    ServerStats* s = server_stats;
+    StatsBuf b;
+    b.cap = 16384;
+    b.len = 0;
+    b.data = malloc(b.cap);
+
+    uint64_t queued_total, queued_max;
+    int queued_max_idx;
+    int active = stats_scan_clients(info, &queued_total, &queued_max, &queued_max_idx);
+
+    stats_printf(&b, "# HELP chat_info 서버 모드\n# TYPE chat_info gauge\nchat_info{mode=\"%s\"} 1\n", mode);
+    stats_printf(&b, "# HELP chat_uptime_seconds 서버 실행 시간\n# TYPE chat_uptime_seconds gauge\nchat_uptime_seconds %llu\n",
+                 (unsigned long long)(time(NULL) - s->start_time));
+    stats_printf(&b, "# HELP chat_accepts_total 수락한 연결 수\n# TYPE chat_accepts_total counter\nchat_accepts_total %llu\n",
+                 (unsigned long long)stats_load(&s->accepts));
+    stats_printf(&b, "# HELP chat_rejects_total 거절한 연결 수 (reason : full 수용량 초과, rate 출발지 IP 별 속도 제한)\n# TYPE chat_rejects_total counter\n");
+    stats_printf(&b, "chat_rejects_total{reason=\"full\"} %llu\nchat_rejects_total{reason=\"rate\"} %llu\n",
+                 (unsigned long long)stats_load(&s->rejects), (unsigned long long)stats_load(&s->rate_limited));
+    stats_printf(&b, "# HELP chat_disconnects_total 종료된 연결 수\n# TYPE chat_disconnects_total counter\nchat_disconnects_total %llu\n",
+                 (unsigned long long)stats_load(&s->disconnects));
+    stats_printf(&b, "# HELP chat_active_clients 현재 접속 중인 클라이언트 수 (fork 모드 : 자식 프로세스 수)\n# TYPE chat_active_clients gauge\nchat_active_clients %d\n",
+                 active);
+    stats_printf(&b, "# HELP chat_client_limit 동시 접속 상한\n# TYPE chat_client_limit gauge\nchat_client_limit %d\n",
+                 __atomic_load_n(&s->client_limit, __ATOMIC_RELAXED));
+    stats_printf(&b, "# HELP chat_room_limit 활성 채팅 채널 상한 (로비 포함)\n# TYPE chat_room_limit gauge\nchat_room_limit %d\n",
+                 __atomic_load_n(&s->room_limit, __ATOMIC_RELAXED));
+    stats_printf(&b, "# HELP chat_config_reloads_total SIGHUP 으로 설정을 다시 읽은 횟수\n# TYPE chat_config_reloads_total counter\nchat_config_reloads_total %llu\n",
+                 (unsigned long long)stats_load(&s->config_reloads));
+    stats_printf(&b, "# HELP chat_heartbeat_pings_total 아무 프레임도 받지 못한 연결에 보낸 PING 수\n# TYPE chat_heartbeat_pings_total counter\nchat_heartbeat_pings_total %llu\n",
+                 (unsigned long long)stats_load(&s->heartbeat_pings));
+    stats_printf(&b, "# HELP chat_idle_disconnects_total 유휴 시간 제한을 넘어 종료한 연결 수\n# TYPE chat_idle_disconnects_total counter\nchat_idle_disconnects_total %llu\n",
+                 (unsigned long long)stats_load(&s->idle_disconnects));
+
+    stats_printf(&b, "# HELP chat_frames_in_total 명령어별 처리한 요청 수\n# TYPE chat_frames_in_total counter\n");
+    for (int cmd = CMD_NONE + 1; cmd < CMD_MAX; cmd++) {
+        stats_printf(&b, "chat_frames_in_total{cmd=\"%s\"} %llu\n", frame_cmd_name(cmd), (unsigned long long)stats_load(&s->frames_in[cmd]));
+    }
+    stats_printf(&b, "# HELP chat_frames_out_total 명령어별 클라이언트에게 전달한 프레임 수\n# TYPE chat_frames_out_total counter\n");
+    for (int cmd = CMD_NONE + 1; cmd < CMD_MAX; cmd++) {
+        stats_printf(&b, "chat_frames_out_total{cmd=\"%s\"} %llu\n", frame_cmd_name(cmd), (unsigned long long)stats_load(&s->frames_out[cmd]));
+    }
+    stats_printf(&b, "# HELP chat_room_log_bytes_total fork 모드 방 로그에 쓴 브로드캐스트 바이트\n# TYPE chat_room_log_bytes_total counter\nchat_room_log_bytes_total %llu\n",
+                 (unsigned long long)stats_load(&s->room_log_bytes));
+    stats_render_hist(&b, "chat_broadcast_fanout", "브로드캐스트 1건당 받는 채팅 채널 멤버 수", &s->fanout);
+    stats_render_hist(&b, "chat_handler_duration_nanoseconds", "명령어 1건 처리 시간", &s->handler_ns);
+    stats_render_hist(&b, "chat_socket_send_bytes", "클라이언트 소켓 전송 1회당 바이트", &s->send_bytes);
+    stats_render_hist(&b, "chat_accept_duration_nanoseconds", "listen 소켓이 준비된 것을 본 뒤 연결을 받아들이기까지 걸린 시간", &s->accept_ns);
+    stats_printf(&b, "# HELP chat_slow_consumer_events_total 송신 큐가 상한을 넘어 느린 클라이언트로 표시한 횟수\n# TYPE chat_slow_consumer_events_total counter\nchat_slow_consumer_events_total %llu\n",
+                 (unsigned long long)stats_load(&s->slow_events));
+    stats_printf(&b, "# HELP chat_dropped_frames_total 느린 클라이언트 정책으로 버린 프레임 수\n# TYPE chat_dropped_frames_total counter\n");
+    stats_printf(&b, "chat_dropped_frames_total{which=\"newest\"} %llu\nchat_dropped_frames_total{which=\"oldest\"} %llu\n",
+                 (unsigned long long)stats_load(&s->dropped_newest), (unsigned long long)stats_load(&s->dropped_oldest));
+    stats_printf(&b, "# HELP chat_dropped_bytes_total 느린 클라이언트 정책으로 버린 바이트\n# TYPE chat_dropped_bytes_total counter\nchat_dropped_bytes_total %llu\n",
+                 (unsigned long long)stats_load(&s->dropped_bytes));
+    stats_printf(&b, "# HELP chat_slow_disconnects_total 느린 클라이언트 정책으로 종료한 연결 수\n# TYPE chat_slow_disconnects_total counter\nchat_slow_disconnects_total %llu\n",
+                 (unsigned long long)stats_load(&s->slow_disconnects));
+    stats_printf(&b, "# HELP chat_room_log_overruns_total fork 모드 자식이 밀려 방 로그의 오래된 메시지를 건너뛴 횟수\n# TYPE chat_room_log_overruns_total counter\nchat_room_log_overruns_total %llu\n",
+                 (unsigned long long)stats_load(&s->room_log_overruns));
+    stats_printf(&b, "# HELP chat_room_log_delivered_bytes_total fork 모드 자식이 클라이언트에게 보낸 방 로그 바이트 (전달 방식별)\n# TYPE chat_room_log_delivered_bytes_total counter\n");
+    stats_printf(&b, "chat_room_log_delivered_bytes_total{path=\"zero_copy\"} %llu\nchat_room_log_delivered_bytes_total{path=\"copy\"} %llu\n",
+                 (unsigned long long)stats_load(&s->room_log_zero_copy_bytes), (unsigned long long)stats_load(&s->room_log_copy_bytes));
+
+    stats_printf(&b, "# HELP chat_compress_frames_total 압축 최소 크기 이상인 프레임 수 (결과별, 브로드캐스트는 한 번)\n# TYPE chat_compress_frames_total counter\n");
+    stats_printf(&b, "chat_compress_frames_total{result=\"compressed\"} %llu\nchat_compress_frames_total{result=\"skipped\"} %llu\n",
+                 (unsigned long long)stats_load(&s->compress_frames), (unsigned long long)stats_load(&s->compress_skipped));
+    stats_printf(&b, "# HELP chat_compress_bytes_total 압축한 프레임 바이트 (압축 전 / 후)\n# TYPE chat_compress_bytes_total counter\n");
+    stats_printf(&b, "chat_compress_bytes_total{stage=\"in\"} %llu\nchat_compress_bytes_total{stage=\"out\"} %llu\n",
+                 (unsigned long long)stats_load(&s->compress_in_bytes), (unsigned long long)stats_load(&s->compress_out_bytes));
+    stats_printf(&b, "# HELP chat_compress_seconds_total 압축에 쓴 CPU 시간\n# TYPE chat_compress_seconds_total counter\nchat_compress_seconds_total %.6f\n",
+                 stats_load(&s->compress_ns) / 1e9);
+    stats_printf(&b, "# HELP chat_decompress_frames_total 서버가 푼 압축 프레임 수\n# TYPE chat_decompress_frames_total counter\nchat_decompress_frames_total %llu\n",
+                 (unsigned long long)stats_load(&s->decompress_frames));
+    stats_printf(&b, "# HELP chat_decompress_bytes_total 서버가 푼 압축 프레임 바이트 (풀기 전 / 후)\n# TYPE chat_decompress_bytes_total counter\n");
+    stats_printf(&b, "chat_decompress_bytes_total{stage=\"in\"} %llu\nchat_decompress_bytes_total{stage=\"out\"} %llu\n",
+                 (unsigned long long)stats_load(&s->decompress_in_bytes), (unsigned long long)stats_load(&s->decompress_out_bytes));
+    stats_printf(&b, "# HELP chat_decompress_seconds_total 압축 프레임을 푸는 데 쓴 CPU 시간\n# TYPE chat_decompress_seconds_total counter\nchat_decompress_seconds_total %.6f\n",
+                 stats_load(&s->decompress_ns) / 1e9);
+    stats_printf(&b, "# HELP chat_msgbuf_allocs_total 메시지 버퍼 풀 할당 수 (결과별 : 빈 버퍼 재사용, slab 새로 자름, 풀 밖 할당)\n# TYPE chat_msgbuf_allocs_total counter\n");
+    uint64_t buf_allocs = stats_load(&s->msgbuf.allocs);
+    uint64_t buf_hits = stats_load(&s->msgbuf.hits);
+    uint64_t buf_oversize = stats_load(&s->msgbuf.oversize);
+    stats_printf(&b, "chat_msgbuf_allocs_total{result=\"hit\"} %llu\nchat_msgbuf_allocs_total{result=\"slab\"} %llu\nchat_msgbuf_allocs_total{result=\"oversize\"} %llu\n",
+                 (unsigned long long)buf_hits, (unsigned long long)(buf_allocs - buf_hits - buf_oversize), (unsigned long long)buf_oversize);
+    stats_printf(&b, "# HELP chat_msgbuf_refs_total 송신 큐가 복사 대신 잡은 버퍼 참조 수\n# TYPE chat_msgbuf_refs_total counter\nchat_msgbuf_refs_total %llu\n",
+                 (unsigned long long)stats_load(&s->msgbuf.refs));
+    stats_printf(&b, "# HELP chat_msgbuf_inflight_bytes 참조가 남아 있는 (전달이 끝나지 않은) 메시지 버퍼 바이트\n# TYPE chat_msgbuf_inflight_bytes gauge\nchat_msgbuf_inflight_bytes %llu\n",
+                 (unsigned long long)stats_load(&s->msgbuf.inflight_bytes));
+    stats_printf(&b, "# HELP chat_msgbuf_slab_bytes 메시지 버퍼 풀이 만든 slab 바이트\n# TYPE chat_msgbuf_slab_bytes gauge\nchat_msgbuf_slab_bytes %llu\n",
+                 (unsigned long long)stats_load(&s->msgbuf.slab_bytes));
+
+    // 슬롯별 지표 (접속 중인 클라이언트만, 지표 이름별로 모아서 출력)
+    static const char* client_metrics[3][3] = {
+        { "chat_client_frames_out_total", "클라이언트에게 보낸 프레임 수", "counter" },
+        { "chat_client_bytes_out_total", "클라이언트에게 보낸 바이트 (fork 모드 : 부모 → 자식 링)", "counter" },
+        { "chat_client_queued_bytes", "클라이언트에게 아직 전달되지 않은 바이트", "gauge" },
+    };
+    for (int m = 0; m < 3; m++) {
+        const char* name = client_metrics[m][0];
+        stats_printf(&b, "# HELP %s %s\n# TYPE %s %s\n", name, client_metrics[m][1], name, client_metrics[m][2]);
+        for (int i = 0; i < s->max_clients; i++) {
+            const char* nick;
+            uint64_t queued;
+            if (!info(i, &nick, &queued)) {
+                continue;
+            }
+            char label[128];
+            stats_label_escape(label, sizeof(label), nick);
+            uint64_t v = m == 0 ? stats_load(&s->clients[i].frames_out) : m == 1 ? stats_load(&s->clients[i].bytes_out) : queued;
+            stats_printf(&b, "%s{index=\"%d\",nick=\"%s\"} %llu\n", name, i, label, (unsigned long long)v);
+        }
+    }
+    stats_printf(&b, "# HELP chat_queued_bytes 모든 클라이언트의 전달 대기 바이트 합계\n# TYPE chat_queued_bytes gauge\nchat_queued_bytes %llu\n",
+                 (unsigned long long)queued_total);
+
+    // chat-dev14 : 채팅 채널별 최근 메시지 기록 사용량 (활성 채널만)
+    static const char* room_metrics[2][2] = {
+        { "chat_room_history_messages", "채팅 채널 최근 메시지 기록에 있는 메시지 수" },
+        { "chat_room_history_bytes", "채팅 채널 최근 메시지 기록이 사용 중인 바이트" },
+    };
+    for (int m = 0; m < 2; m++) {
+        const char* name = room_metrics[m][0];
+        stats_printf(&b, "# HELP %s %s\n# TYPE %s gauge\n", name, room_metrics[m][1], name);
+        for (int r = 0; stats_room_info != NULL && r < stats_rooms; r++) {
+            const char* room_name;
+            uint32_t msgs;
+            uint64_t bytes;
+            if (!stats_room_info(r, &room_name, &msgs, &bytes)) {
+                continue;
+            }
+            char label[128];
+            stats_label_escape(label, sizeof(label), room_name);
+            stats_printf(&b, "%s{room=\"%d\",name=\"%s\"} %llu\n", name, r, label, (unsigned long long)(m == 0 ? msgs : bytes));
+        }
+    }
+    stats_printf(&b, "# HELP chat_room_history_reserved_bytes 채팅 채널 하나의 최근 메시지 기록에 예약된 바이트\n# TYPE chat_room_history_reserved_bytes gauge\nchat_room_history_reserved_bytes %llu\n",
+                 (unsigned long long)stats_history_reserved);
+
+    *len = b.len;
+    return b.data;
+}
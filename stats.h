@@ -0,0 +1,89 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "protocol.h"
+#include "msgbuf.h"
+
+// chat-dev13 : 서버 실행 중 지표(카운터, 히스토그램) 수집 및 조회 - /STATS 명령어, 관리용 UNIX 도메인 소켓
+// => 지표는 fork 전에 MAP_SHARED 로 만든 공유 메모리에 두고 모든 서버 프로세스(workers 모드 worker 포함) 가 atomic 으로 갱신
+//    조회할 때만 공유 메모리를 읽어 /STATS 요약 문자열 또는 Prometheus text 형식으로 만듦
+#define STATS_HIST_BUCKETS 32 // 2 의 거듭제곱 경계 히스토그램 칸 수
+
+typedef struct {
+    uint64_t buckets[STATS_HIST_BUCKETS]; // k 번 칸 : 2^(k-1) < 값 <= 2^k (0 번 칸 : 값 <= 1, 마지막 칸 : 나머지 전부)
+    uint64_t count;
+    uint64_t sum;
+} StatsHistogram;
+
+// 클라이언트 슬롯별 지표 (슬롯이 회수될 때 초기화)
+typedef struct {
+    uint64_t frames_out; // 클라이언트에게 보낸 프레임 수 (fork 모드 방 로그 브로드캐스트 제외)
+    uint64_t bytes_out;  // fork 모드 : 부모 → 자식 링으로 보낸 바이트, epoll / workers 모드 : 클라이언트 소켓으로 보낸 바이트
+    uint64_t queued;     // epoll / workers 모드 : 연결을 소유한 프로세스가 기록한 송신 버퍼 대기 바이트
+} StatsClient;
+
+typedef struct {
+    uint64_t start_time;        // 서버 시작 시각 (time())
+    uint64_t accepts;           // 수락한 연결 수
+    uint64_t rejects;           // 수용량 초과로 거절한 연결 수
+    uint64_t rate_limited;      // chat-dev25 : 출발지 IP 별 연결 속도 제한으로 거절한 연결 수
+    uint64_t disconnects;       // 종료된 연결 수
+    uint64_t config_reloads;    // chat-dev26 : SIGHUP 으로 설정을 다시 읽은 횟수
+    uint64_t heartbeat_pings;   // chat-dev27 : 아무 프레임도 받지 못한 연결에 보낸 PING 수
+    uint64_t idle_disconnects;  // chat-dev27 : 유휴 시간 제한을 넘어 종료한 연결 수
+    int client_limit;           // chat-dev26 : 현재 동시 접속 상한 (--max-clients)
+    int room_limit;             // chat-dev26 : 현재 활성 채팅 채널 상한 (--max-rooms, 로비 포함)
+    uint64_t frames_in[CMD_MAX];  // 명령어별 처리한 요청 수
+    uint64_t frames_out[CMD_MAX]; // 명령어별 클라이언트에게 전달한 프레임 수 (브로드캐스트는 받는 멤버 수만큼)
+    uint64_t room_log_bytes;    // fork 모드 : 방 로그에 쓴 브로드캐스트 바이트
+    StatsHistogram fanout;      // 브로드캐스트 1건당 받는 채팅 채널 멤버 수
+    StatsHistogram handler_ns;  // 명령어 1건 처리 시간 (ns)
+    StatsHistogram send_bytes;  // chat-dev16 : 클라이언트 소켓 전송 1회당 바이트 (여러 프레임을 모아 보낸 정도)
+    StatsHistogram accept_ns;   // chat-dev25 : listen 소켓이 준비된 것을 본 뒤 연결을 받아들이기까지 (슬롯 배정, fork 모드는 자식 생성 포함) 걸린 시간 (ns)
+    // chat-dev17 : 느린 클라이언트 (송신 큐 상한 초과) 처리
+    uint64_t slow_events;       // 송신 큐가 상한을 넘어 느린 클라이언트로 표시한 횟수
+    uint64_t dropped_newest;    // 버린 새 프레임 수 (drop-newest, disconnect 정책)
+    uint64_t dropped_oldest;    // 버린 오래된 프레임 수 (drop-oldest 정책)
+    uint64_t dropped_bytes;     // 버린 프레임 바이트
+    uint64_t slow_disconnects;  // 하한 아래로 비워지지 않아 종료한 연결 수 (disconnect 정책)
+    uint64_t room_log_overruns; // fork 모드 : 자식이 밀려 방 로그의 오래된 메시지를 건너뛴 횟수
+    // chat-dev18 : fork 모드 자식이 클라이언트에게 보낸 방 로그 바이트 (--zero-copy)
+    uint64_t room_log_zero_copy_bytes; // 공유 메모리에서 복사 없이 보낸 바이트
+    uint64_t room_log_copy_bytes;      // child_out 에 복사해서 보낸 바이트 (밀린 경우, 소켓 버퍼가 가득 찬 경우)
+    // chat-dev22 : 프레임 압축 (브로드캐스트는 멤버 수와 관계없이 한 번만 셈)
+    uint64_t compress_frames;      // 압축한 프레임 수
+    uint64_t compress_skipped;     // 압축 최소 크기 이상이지만 충분히 줄지 않아 원본으로 보낸 프레임 수
+    uint64_t compress_in_bytes;    // 압축한 프레임의 원본 바이트
+    uint64_t compress_out_bytes;   // 압축한 프레임의 압축 후 바이트
+    uint64_t compress_ns;          // 압축에 쓴 시간 (충분히 줄지 않은 시도 포함)
+    uint64_t decompress_frames;    // 푼 프레임 수 (클라이언트가 압축해서 보낸 프레임, workers 모드 협상하지 않은 멤버에게 보낼 프레임)
+    uint64_t decompress_in_bytes;
+    uint64_t decompress_out_bytes;
+    uint64_t decompress_ns;
+    MsgBufStats msgbuf;            // chat-dev24 : 메시지 버퍼 풀 (worker 들의 풀을 합친 값)
+    int max_clients;
+    StatsClient clients[];
+} ServerStats;
+
+// 조회 시 idx 번 슬롯 정보 (반환 0 : 빈 슬롯) - nick : 닉네임, queued : 전달 대기 바이트
+typedef int (*StatsClientInfoFn)(int idx, const char** nick, uint64_t* queued);
+
+// chat-dev14 : 조회 시 room 번 채팅 채널의 최근 메시지 기록 사용량 (반환 0 : 비활성 채널) - name : 채널 이름
+typedef int (*StatsRoomInfoFn)(int room, const char** name, uint32_t* history_msgs, uint64_t* history_bytes);
+
+extern ServerStats* server_stats;
+
+int stats_init(int max_clients);
+uint64_t stats_now_ns();
+void stats_add(uint64_t* counter, uint64_t n);
+void stats_hist_add(StatsHistogram* h, uint64_t value);
+uint64_t stats_hist_percentile(const StatsHistogram* h, double q);
+void stats_client_reset(int idx);
+void stats_set_rooms(int rooms, uint64_t history_reserved, StatsRoomInfoFn info);
+size_t stats_render_summary(char* dst, size_t cap, const char* mode, StatsClientInfoFn info);
+char* stats_render_prometheus(const char* mode, StatsClientInfoFn info, size_t* len);
+
+#endif
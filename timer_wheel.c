@@ -0,0 +1,139 @@
+#include <string.h>
+
+#include "timer_wheel.h"
+
+static void timer_list_init(TimerLink* head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static void timer_list_add(TimerLink* head, TimerLink* l) {
+    l->prev = head->prev;
+    l->next = head;
+    head->prev->next = l;
+    head->prev = l;
+}
+
+static void timer_list_del(TimerLink* l) {
+    l->prev->next = l->next;
+    l->next->prev = l->prev;
+    l->next = NULL;
+    l->prev = NULL;
+}
+
+// from 칸의 타이머를 모두 to 리스트로 옮기고 from 을 비움 (만료 함수가 칸을 바꿔도 안전하도록 떼어 낸 뒤 처리)
+static void timer_list_take(TimerLink* from, TimerLink* to) {
+    if (from->next == from) {
+        timer_list_init(to);
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    timer_list_init(from);
+}
+
+// 만료 tick 까지 남은 tick 수로 단계와 칸을 정해 연결 (지난 시각은 다음 tick, 최대 범위를 넘으면 최대 범위 칸)
+static void timer_wheel_place(TimerWheel* w, TimerEntry* t) {
+    uint64_t expires = t->expires > w->now ? t->expires : w->now + 1;
+    uint64_t delta = expires - w->now;
+    if (delta >= TIMER_WHEEL_SPAN) {
+        delta = TIMER_WHEEL_SPAN - 1;
+        expires = w->now + delta;
+    }
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ull << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    timer_list_add(&w->slots[level][(expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK], &t->link);
+}
+
+// 타이머 휠 초기화 (now_ms : 현재 시각, tick_ms : tick 간격)
+void timer_wheel_init(TimerWheel* w, uint64_t now_ms, uint32_t tick_ms) {
+    w->base_ms = now_ms;
+    w->tick_ms = tick_ms > 0 ? tick_ms : 1;
+    w->now = 0;
+    w->count = 0;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            timer_list_init(&w->slots[level][slot]);
+        }
+    }
+}
+
+void timer_entry_init(TimerEntry* t, TimerFn fn, void* arg) {
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+}
+
+// expires_ms 시각에 만료되도록 추가 (이미 대기 중이면 만료 시각만 바꿈) - tick 단위로 올림하므로 일찍 만료되지 않음
+void timer_wheel_add(TimerWheel* w, TimerEntry* t, uint64_t expires_ms) {
+    timer_wheel_cancel(w, t);
+    t->expires = expires_ms > w->base_ms ? (expires_ms - w->base_ms + w->tick_ms - 1) / w->tick_ms : 0;
+    timer_wheel_place(w, t);
+    w->count++;
+}
+
+// 대기 중인 타이머 취소 (대기 중이 아니면 아무것도 하지 않음)
+void timer_wheel_cancel(TimerWheel* w, TimerEntry* t) {
+    if (t->link.next == NULL) {
+        return;
+    }
+    timer_list_del(&t->link);
+    w->count--;
+}
+
+// level 단계 slot 칸의 타이머를 아래 단계로 내려보냄
+// => 단계 경계 tick 에 만료되는 타이머는 아직 처리하지 않은 현재 tick 의 0 단계 칸에 넣어 이번 tick 에 실행 (다음 tick 으로 밀리지 않도록)
+static void timer_wheel_cascade(TimerWheel* w, int level, int slot) {
+    TimerLink pending;
+    timer_list_take(&w->slots[level][slot], &pending);
+    while (pending.next != &pending) {
+        TimerEntry* t = (TimerEntry*)pending.next;
+        timer_list_del(&t->link);
+        if (t->expires <= w->now) {
+            timer_list_add(&w->slots[0][w->now & TIMER_WHEEL_MASK], &t->link);
+        } else {
+            timer_wheel_place(w, t);
+        }
+    }
+}
+
+// now_ms 까지 tick 을 진행하며 만료된 타이머 실행 (반환 : 실행한 타이머 수)
+// => 대기 중인 타이머가 없으면 tick 을 하나씩 돌지 않고 바로 건너뜀
+size_t timer_wheel_advance(TimerWheel* w, uint64_t now_ms) {
+    uint64_t target = now_ms > w->base_ms ? (now_ms - w->base_ms) / w->tick_ms : 0;
+    size_t fired = 0;
+    while (w->now < target) {
+        if (w->count == 0) {
+            w->now = target;
+            break;
+        }
+        w->now++;
+        // 아래 단계가 한 바퀴 돌 때마다 위 단계의 다음 칸을 내려보냄
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            int shift = TIMER_WHEEL_BITS * level;
+            if ((w->now & ((1ull << shift) - 1)) != 0) {
+                break;
+            }
+            timer_wheel_cascade(w, level, (w->now >> shift) & TIMER_WHEEL_MASK);
+        }
+
+        TimerLink pending;
+        timer_list_take(&w->slots[0][w->now & TIMER_WHEEL_MASK], &pending);
+        while (pending.next != &pending) {
+            TimerEntry* t = (TimerEntry*)pending.next;
+            timer_list_del(&t->link);
+            if (t->expires > w->now) {
+                timer_wheel_place(w, t); // 최대 범위를 넘어 앞당겨 둔 타이머
+                continue;
+            }
+            w->count--;
+            t->fn(t->arg);
+            fired++;
+        }
+    }
+    return fired;
+}
@@ -0,0 +1,47 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// chat-dev27 : 계층형 타이머 휠 (hashed hierarchical timing wheel)
+// => 타이머 추가 / 취소는 연결 리스트 연결 / 해제 한 번 (O(1)), tick 마다 현재 칸의 타이머만 실행하므로 대기 중인 타이머 수와 무관
+//    0 단계 : 1 tick 단위 64 칸, 1 단계 : 64 tick 단위 64 칸 ... 상위 단계 칸은 차례가 오면 아래 단계로 내려보냄 (cascade)
+//    4 단계 x 64 칸 = 2^24 tick 까지 예약 (tick 250 ms 이면 약 48 일, 넘으면 최대 범위에서 다시 예약)
+//    TimerEntry 는 사용하는 쪽 구조체에 넣어 두고 (별도 할당 없음), 하나의 휠은 한 프로세스(이벤트 루프) 안에서만 사용
+#define TIMER_WHEEL_BITS   6
+#define TIMER_WHEEL_SLOTS  (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK   (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_SPAN   (1ull << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) // 예약할 수 있는 최대 tick 수
+
+typedef struct TimerLink {
+    struct TimerLink* next; // NULL : 대기 중이 아님
+    struct TimerLink* prev;
+} TimerLink;
+
+// 만료 시 실행할 함수 (arg : timer_entry_init 에 넘긴 값) - 함수 안에서 같은 타이머를 다시 추가하거나 다른 타이머를 취소해도 됨
+typedef void (*TimerFn)(void* arg);
+
+typedef struct {
+    TimerLink link;   // 첫 멤버 (칸 리스트 연결)
+    uint64_t expires; // 만료 tick
+    TimerFn fn;
+    void* arg;
+} TimerEntry;
+
+typedef struct {
+    uint64_t base_ms; // tick 0 의 시각
+    uint32_t tick_ms;
+    uint64_t now;     // 마지막으로 처리한 tick
+    size_t count;     // 대기 중인 타이머 수
+    TimerLink slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} TimerWheel;
+
+void timer_wheel_init(TimerWheel* w, uint64_t now_ms, uint32_t tick_ms);
+void timer_entry_init(TimerEntry* t, TimerFn fn, void* arg);
+void timer_wheel_add(TimerWheel* w, TimerEntry* t, uint64_t expires_ms);
+void timer_wheel_cancel(TimerWheel* w, TimerEntry* t);
+size_t timer_wheel_advance(TimerWheel* w, uint64_t now_ms);
+
+#endif
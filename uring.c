@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#include "uring.h"
+
+// chat-dev19 : io_uring syscall (glibc 에 wrapper 가 없으므로 syscall 로 호출)
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params* p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+// io_uring 인스턴스 생성 및 제출/완료 큐 mmap
+// 이벤트 루프 한 프로세스만 사용하므로 SINGLE_ISSUER, 완료 처리를 다음 io_uring_enter 까지 미루는 COOP_TASKRUN 을 먼저 시도하고,
+// 지원하지 않는 커널이면 플래그 없이 다시 생성
+int uring_open(Uring* u, unsigned entries) {
+    struct io_uring_params p;
+    memset(u, 0, sizeof(Uring));
+    u->fd = -1;
+
+    memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SINGLE_ISSUER;
+    int fd = sys_io_uring_setup(entries, &p);
+    if (fd < 0 && errno == EINVAL) {
+        memset(&p, 0, sizeof(p));
+        fd = sys_io_uring_setup(entries, &p);
+    }
+    if (fd < 0) {
+        return -1;
+    }
+    u->fd = fd;
+
+    u->sq_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_len > u->sq_len) {
+            u->sq_len = u->cq_len;
+        }
+        u->cq_len = u->sq_len;
+    }
+    u->sq_ptr = mmap(NULL, u->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (u->sq_ptr == MAP_FAILED) {
+        u->sq_ptr = NULL;
+        uring_close(u);
+        return -1;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ptr = u->sq_ptr;
+    } else {
+        u->cq_ptr = mmap(NULL, u->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (u->cq_ptr == MAP_FAILED) {
+            u->cq_ptr = NULL;
+            uring_close(u);
+            return -1;
+        }
+    }
+    u->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        u->sqes = NULL;
+        uring_close(u);
+        return -1;
+    }
+
+    char* sq = u->sq_ptr;
+    u->sq_head = (unsigned*)(sq + p.sq_off.head);
+    u->sq_tail = (unsigned*)(sq + p.sq_off.tail);
+    u->sq_mask = *(unsigned*)(sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned*)(sq + p.sq_off.array);
+    u->sq_entries = p.sq_entries;
+    u->sq_local_tail = *u->sq_tail;
+    // 제출 큐 배열은 항목 i 가 항상 i 번 sqe 를 가리키도록 한 번만 채움
+    for (unsigned i = 0; i < p.sq_entries; i++) {
+        u->sq_array[i] = i;
+    }
+
+    char* cq = u->cq_ptr;
+    u->cq_head = (unsigned*)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned*)(cq + p.cq_off.tail);
+    u->cq_mask = *(unsigned*)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+    return 0;
+}
+
+// fd 가 -1 이면 열리지 않은 인스턴스이므로 무시 (제공 버퍼 등록은 fd 를 닫을 때 함께 해제됨)
+void uring_close(Uring* u) {
+    if (u->fd < 0) {
+        return;
+    }
+    if (u->sqes != NULL) {
+        munmap(u->sqes, u->sqes_len);
+    }
+    if (u->cq_ptr != NULL && u->cq_ptr != u->sq_ptr) {
+        munmap(u->cq_ptr, u->cq_len);
+    }
+    if (u->sq_ptr != NULL) {
+        munmap(u->sq_ptr, u->sq_len);
+    }
+    close(u->fd);
+    if (u->buf_ring != NULL) {
+        munmap(u->buf_ring, u->buf_ring_len);
+    }
+    free(u->bufs);
+    memset(u, 0, sizeof(Uring));
+    u->fd = -1;
+}
+
+// multishot recv 용 제공 버퍼 링 등록 (count : 2 의 거듭제곱) - 모든 버퍼를 링에 넣은 상태로 시작
+int uring_setup_buffers(Uring* u, unsigned count, size_t size) {
+    if (count == 0 || (count & (count - 1)) != 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    u->buf_ring_len = count * sizeof(struct io_uring_buf);
+    void* mem = mmap(NULL, u->buf_ring_len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+    u->buf_ring = mem;
+    u->bufs = malloc(count * size);
+    if (u->bufs == NULL) {
+        return -1;
+    }
+    u->buf_count = count;
+    u->buf_size = size;
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)u->buf_ring;
+    reg.ring_entries = count;
+    reg.bgid = URING_BUF_GROUP;
+    if (sys_io_uring_register(u->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        return -1;
+    }
+    for (unsigned bid = 0; bid < count; bid++) {
+        struct io_uring_buf* buf = &u->buf_ring->bufs[bid];
+        buf->addr = (uint64_t)(uintptr_t)(u->bufs + bid * size);
+        buf->len = size;
+        buf->bid = bid;
+    }
+    __atomic_store_n(&u->buf_ring->tail, (uint16_t)count, __ATOMIC_RELEASE);
+    return 0;
+}
+
+char* uring_buffer(Uring* u, unsigned bid) {
+    return u->bufs + (size_t)bid * u->buf_size;
+}
+
+// 처리가 끝난 제공 버퍼를 링에 돌려줌 (버퍼 수와 링 크기가 같으므로 넘치지 않음)
+void uring_recycle_buffer(Uring* u, unsigned bid) {
+    uint16_t tail = u->buf_ring->tail; // 사용자만 tail 을 바꿈
+    struct io_uring_buf* buf = &u->buf_ring->bufs[tail & (u->buf_count - 1)];
+    buf->addr = (uint64_t)(uintptr_t)uring_buffer(u, bid);
+    buf->len = u->buf_size;
+    buf->bid = bid;
+    __atomic_store_n(&u->buf_ring->tail, (uint16_t)(tail + 1), __ATOMIC_RELEASE);
+}
+
+// 빈 sqe 하나 (제출 큐가 가득 차면 먼저 제출)
+struct io_uring_sqe* uring_get_sqe(Uring* u) {
+    while (u->sq_local_tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) >= u->sq_entries) {
+        if (uring_submit(u, 0) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return NULL;
+        }
+    }
+    struct io_uring_sqe* sqe = &u->sqes[u->sq_local_tail & u->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    u->sq_local_tail++;
+    return sqe;
+}
+
+// 채운 sqe 를 공개하고 io_uring_enter 한 번으로 제출 (wait_nr > 0 이면 완료가 그만큼 쌓일 때까지 대기)
+int uring_submit(Uring* u, unsigned wait_nr) {
+    __atomic_store_n(u->sq_tail, u->sq_local_tail, __ATOMIC_RELEASE);
+    unsigned to_submit = u->sq_local_tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+    if (to_submit == 0 && wait_nr == 0) {
+        return 0;
+    }
+    return sys_io_uring_enter(u->fd, to_submit, wait_nr, wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+}
+
+// 완료 큐의 다음 완료 (없으면 NULL) - 처리 후 uring_cqe_seen 호출
+struct io_uring_cqe* uring_peek_cqe(Uring* u) {
+    unsigned head = *u->cq_head; // 사용자만 head 를 바꿈
+    if (head == __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    return &u->cqes[head & u->cq_mask];
+}
+
+void uring_cqe_seen(Uring* u) {
+    __atomic_store_n(u->cq_head, *u->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+void uring_prep_accept_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data) {
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC; // chat-dev25 : accept4 와 같이 받아들인 소켓을 바로 non-blocking 으로
+    sqe->user_data = user_data;
+}
+
+// 커널이 제공 버퍼 그룹에서 버퍼를 골라 받은 데이터를 씀 (완료의 flags 에 버퍼 번호)
+void uring_prep_recv_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data) {
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = URING_BUF_GROUP;
+    sqe->user_data = user_data;
+}
+
+void uring_prep_send(struct io_uring_sqe* sqe, int fd, const void* buf, size_t len, uint64_t user_data) {
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buf;
+    sqe->len = len;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = user_data;
+}
+
+// chat-dev24 : iovec 여러 개를 한 번에 보내는 sendmsg (msg 와 iovec 은 완료될 때까지 유지)
+void uring_prep_sendmsg(struct io_uring_sqe* sqe, int fd, const struct msghdr* msg, uint64_t user_data) {
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)msg;
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = user_data;
+}
+
+// 읽을 데이터가 생길 때마다 완료가 들어오는 poll (eventfd, timerfd, 관리용 소켓 등)
+void uring_prep_poll_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data) {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = POLLIN;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = user_data;
+}
+
+// user_data 가 target 인 요청 취소
+void uring_prep_cancel(struct io_uring_sqe* sqe, uint64_t target, uint64_t user_data) {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = target;
+    sqe->user_data = user_data;
+}
+
+// 실행 중인 커널이 서버가 쓰는 기능을 모두 지원하는지 확인 (uring_setup_buffers 이후 호출)
+// => 필요한 opcode 는 IORING_REGISTER_PROBE 로 확인하고, 플래그로만 구분되는 multishot recv(6.0) 는
+//    socketpair 에 실제로 제출하여 완료가 IORING_CQE_F_MORE 와 함께 오는지 확인 (제공 버퍼 링 등록 성공 = multishot accept 지원 커널)
+int uring_check(Uring* u) {
+    static const int ops[] = { IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND, IORING_OP_SENDMSG, IORING_OP_POLL_ADD, IORING_OP_ASYNC_CANCEL };
+    size_t probe_len = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = calloc(1, probe_len);
+    if (probe == NULL) {
+        return -1;
+    }
+    if (sys_io_uring_register(u->fd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+        free(probe);
+        return -1;
+    }
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        if (ops[i] > probe->last_op || !(probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED)) {
+            free(probe);
+            errno = EOPNOTSUPP;
+            return -1;
+        }
+    }
+    free(probe);
+
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+        return -1;
+    }
+    int ok = 0;
+    write(sv[1], "x", 1);
+    struct io_uring_sqe* sqe = uring_get_sqe(u);
+    if (sqe != NULL) {
+        uring_prep_recv_multishot(sqe, sv[0], 1);
+        // 첫 완료 (데이터 1 바이트, 이어서 완료가 더 올 수 있음) 확인 후 취소하고, 취소 완료와 recv 마지막 완료까지 비움
+        int pending = 1;
+        uring_submit(u, 1);
+        while (pending > 0) {
+            struct io_uring_cqe* cqe = uring_peek_cqe(u);
+            if (cqe == NULL) {
+                if (uring_submit(u, 1) < 0 && errno != EINTR) {
+                    break;
+                }
+                continue;
+            }
+            if (cqe->flags & IORING_CQE_F_BUFFER) {
+                uring_recycle_buffer(u, cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+            }
+            if (cqe->user_data == 1) {
+                if (cqe->res == 1 && (cqe->flags & IORING_CQE_F_MORE)) {
+                    ok = 1;
+                    struct io_uring_sqe* cancel = uring_get_sqe(u);
+                    if (cancel != NULL) {
+                        uring_prep_cancel(cancel, 1, 2);
+                        pending++;
+                    }
+                }
+                if (!(cqe->flags & IORING_CQE_F_MORE)) {
+                    pending--;
+                }
+            } else {
+                pending--; // 취소 완료
+            }
+            uring_cqe_seen(u);
+        }
+    }
+    close(sv[0]);
+    close(sv[1]);
+    if (!ok) {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef URING_H
+#define URING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+
+// chat-dev19 : io_uring 입출력 엔진 (liburing 없이 io_uring_setup / io_uring_enter / io_uring_register syscall 을 직접 사용)
+// => epoll 이벤트마다 accept / read / send syscall 을 하나씩 부르는 대신, 요청을 제출 큐(SQ) 에 모아 io_uring_enter 한 번으로 제출하고
+//    완료 큐(CQ) 에서 결과를 읽음 - multishot accept / recv 는 한 번 제출하면 연결 / 데이터가 올 때마다 완료가 계속 들어옴
+//    multishot recv 는 커널이 제공 버퍼 링(provided buffer ring) 에서 버퍼를 골라 쓰고, 사용자는 처리 후 버퍼를 링에 돌려줌
+//    커널이 지원하지 않으면(오래된 커널, seccomp, io_uring_disabled) uring_open / uring_check 가 실패하고 서버는 epoll 로 동작
+#define URING_ENTRIES     256   // 제출 큐 크기
+#define URING_BUF_GROUP   0     // multishot recv 제공 버퍼 그룹 번호
+#define URING_BUF_COUNT   256   // 제공 버퍼 수 (2 의 거듭제곱)
+#define URING_BUF_SIZE    8192  // 제공 버퍼 하나의 크기 (BUFSIZ)
+
+typedef struct {
+    int fd;
+    // 제출 큐 (커널과 공유하는 mmap 영역의 포인터)
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned sq_mask;
+    unsigned* sq_array;
+    struct io_uring_sqe* sqes;
+    unsigned sq_entries;
+    unsigned sq_local_tail; // 채웠지만 아직 공개하지 않은 위치
+    // 완료 큐
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe* cqes;
+    // mmap 영역
+    void* sq_ptr;
+    size_t sq_len;
+    void* cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+    // multishot recv 제공 버퍼 링
+    struct io_uring_buf_ring* buf_ring;
+    size_t buf_ring_len;
+    char* bufs;
+    unsigned buf_count;
+    size_t buf_size;
+} Uring;
+
+int uring_open(Uring* u, unsigned entries);
+void uring_close(Uring* u);
+int uring_check(Uring* u);
+int uring_setup_buffers(Uring* u, unsigned count, size_t size);
+char* uring_buffer(Uring* u, unsigned bid);
+void uring_recycle_buffer(Uring* u, unsigned bid);
+
+struct io_uring_sqe* uring_get_sqe(Uring* u);
+int uring_submit(Uring* u, unsigned wait_nr);
+struct io_uring_cqe* uring_peek_cqe(Uring* u);
+void uring_cqe_seen(Uring* u);
+
+void uring_prep_accept_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data);
+void uring_prep_recv_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data);
+void uring_prep_send(struct io_uring_sqe* sqe, int fd, const void* buf, size_t len, uint64_t user_data);
+void uring_prep_sendmsg(struct io_uring_sqe* sqe, int fd, const struct msghdr* msg, uint64_t user_data);
+void uring_prep_poll_multishot(struct io_uring_sqe* sqe, int fd, uint64_t user_data);
+void uring_prep_cancel(struct io_uring_sqe* sqe, uint64_t target, uint64_t user_data);
+
+#endif